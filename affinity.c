@@ -0,0 +1,145 @@
+#include "main.h"
+
+/**
+ * parse_cpu_number - Parse a CPU number at the start of a string
+ * @str: Pointer to the current position, advanced past the digits
+ * @cpu: Where to store the CPU number
+ *
+ * Return: 0 on success, -1 if there is no number or it is out of range.
+ */
+static int parse_cpu_number(const char **str, int *cpu)
+{
+	int value = 0, digits = 0;
+
+	while (**str >= '0' && **str <= '9')
+	{
+		value = value * 10 + (**str - '0');
+		if (value >= CPU_SETSIZE)
+			return (-1);
+		(*str)++;
+		digits++;
+	}
+	*cpu = value;
+	return (digits > 0 ? 0 : -1);
+}
+
+/**
+ * parse_cpu_list - Parse a CPU list such as "0-3,6,8-11"
+ * @list: The list to parse
+ * @cpus: The set to fill in
+ *
+ * Description: The list uses the same syntax as taskset -c and the kernel's
+ * cpuset files: comma separated CPU numbers or inclusive ranges.
+ *
+ * Return: 0 on success, -1 if the list is malformed.
+ */
+int parse_cpu_list(const char *list, cpu_set_t *cpus)
+{
+	int first, last;
+
+	CPU_ZERO(cpus);
+	while (1)
+	{
+		if (parse_cpu_number(&list, &first) != 0)
+			return (-1);
+		last = first;
+		if (*list == '-')
+		{
+			list++;
+			if (parse_cpu_number(&list, &last) != 0 || last < first)
+				return (-1);
+		}
+		for (; first <= last; first++)
+			CPU_SET(first, cpus);
+		if (*list == '\0')
+			return (0);
+		if (*list != ',')
+			return (-1);
+		list++;
+	}
+}
+
+/**
+ * spread_cpus - Pick the next CPU for a command when HSH_SPREAD is set
+ * @attr: The settings of the command about to be spawned
+ *
+ * Description: When the HSH_SPREAD environment variable is set to a value
+ * other than "0", every command that was not pinned explicitly is pinned to
+ * a single CPU, taking the CPUs the shell itself may run on in round-robin
+ * order from the first one. Consecutive commands, and background jobs in
+ * particular, then land on different cores instead of all inheriting the
+ * shell's affinity and competing for the same ones. The shell's own mask
+ * is read once and the position in it is kept between calls.
+ * A command spread this way runs on one CPU only, however many threads it
+ * starts, so a multithreaded tool such as 'make -j8' or 'sort --parallel'
+ * is serialised; run it with 'pin' to give it a set of CPUs, which also
+ * keeps it out of the round-robin.
+ *
+ * Return: None.
+ */
+void spread_cpus(spawn_attr_t *attr)
+{
+	static cpu_set_t allowed;
+	static int loaded, next;
+	char *spread = _getenv("HSH_SPREAD");
+	int i;
+
+	if (attr->has_cpus || spread == NULL || spread[0] == '\0' ||
+	    _strcmp(spread, "0") == 0)
+		return;
+	if (!loaded)
+	{
+		if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+			return;
+		loaded = 1;
+	}
+	for (i = 0; i < CPU_SETSIZE; i++, next = (next + 1) % CPU_SETSIZE)
+	{
+		if (CPU_ISSET(next, &allowed))
+		{
+			CPU_ZERO(&attr->cpus);
+			CPU_SET(next, &attr->cpus);
+			attr->has_cpus = 1;
+			next = (next + 1) % CPU_SETSIZE;
+			return;
+		}
+	}
+}
+
+/**
+ * builtin_pin - Run a command restricted to a set of CPUs
+ * @tokens: The command, 'pin CPULIST cmd...'
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The CPU list is stored in spawn_attr for the duration of the
+ * command, so that spawn_command applies it in the child between fork and
+ * execve. The remaining tokens go through dispatch_command, which means
+ * 'pin' can be combined with other builtins that spawn commands, such as
+ * 'pin 2-3 timeout 10 make'.
+ *
+ * Return: The exit status of the command, or 2 on a usage error.
+ */
+int builtin_pin(char **tokens, int line_number, char *program_name)
+{
+	spawn_attr_t saved = spawn_attr;
+	int status;
+
+	if (tokens[1] == NULL || tokens[2] == NULL)
+	{
+		fprintf(stderr, "%s: %d: pin: usage: pin CPULIST command\n",
+			program_name, line_number);
+		return (2);
+	}
+	if (parse_cpu_list(tokens[1], &spawn_attr.cpus) != 0)
+	{
+		fprintf(stderr, "%s: %d: pin: invalid CPU list: %s\n",
+			program_name, line_number, tokens[1]);
+		spawn_attr = saved;
+		return (2);
+	}
+	spawn_attr.has_cpus = 1;
+	status = dispatch_command(tokens + 2, line_number, program_name);
+	spawn_attr = saved;
+	return (status);
+}
@@ -0,0 +1,158 @@
+#include "main.h"
+
+/**
+ * alias_release - Drop a reference to an alias
+ * @a: The alias
+ *
+ * Description: The alias is freed with its last reference.
+ *
+ * Return: None.
+ */
+void alias_release(alias_t *a)
+{
+	if (--a->refs > 0)
+		return;
+	free(a->value);
+	prog_free(&a->prog);
+	prog_free(&a->tail);
+	free(a);
+}
+
+/**
+ * alias_run - Run an alias whose value is not a simple command
+ * @a: The alias
+ * @tokens: The name of the alias and the arguments
+ * @lit: The number of words of @tokens that were literal in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: Without arguments, the program compiled with the alias is
+ * run as it is. Arguments go to the last command of the value, as if they
+ * followed it in the input: the tail compiled with the alias has an empty
+ * word there, which alias_tail replaces with them when the command runs,
+ * so the value is not compiled again. The redirections of the command
+ * apply to the whole value.
+ *
+ * Return: The status of the last command run, or 2 if a redirection
+ * failed.
+ */
+static int alias_run(alias_t *a, char **tokens, int lit, char *program_name)
+{
+	redir_list_t *rl = redir_pending;
+	const program_t *run = &a->prog;
+	alias_args_t args;
+	int status = 2;
+
+	if (tokens[1] != NULL)
+	{
+		run = &a->tail;
+		args.prog = run;
+		args.pc = a->tail_pc;
+		args.args = tokens + 1;
+		args.lit = lit - 1;
+		args.prev = alias_args;
+		alias_args = &args;
+	}
+	redir_pending = NULL;
+	if (rl == NULL || redir_apply(rl) != -1)
+		status = run_program(run, program_name);
+	if (rl != NULL)
+		redir_restore(rl);
+	if (tokens[1] != NULL)
+		alias_args = args.prev;
+	return (status);
+}
+
+/**
+ * alias_expand - Expand a simple alias and dispatch the command
+ * @a: The alias
+ * @tokens: The name of the alias and the arguments
+ * @lit: The number of words of @tokens that were literal in the input
+ * @c: The command being built, to which the words of @a are added
+ *
+ * Description: The words compiled with the alias are expanded now, so
+ * they see the variables as they are when it is used. When the value ends
+ * with a blank and the next argument is a literal word naming a simple
+ * alias too, that one is expanded in turn. The fields that come from
+ * literal words are counted in the site of @c, so the command they form
+ * is only looked up as an alias again if its name is literal. The aliases
+ * are busy until the command has run, so the command they expand to is
+ * not looked up as the same alias again.
+ *
+ * Return: The status of the command, or 2 if an expansion failed.
+ */
+static int alias_expand(alias_t *a, char **tokens, int lit, alias_cmd_t *c)
+{
+	size_t n = c->out.n;
+	command_t *next = NULL;
+	int status = 0;
+
+	if (expand_command(&a->prog, 0, &c->out, c->program_name) == -1)
+		return (2);
+	if ((size_t)c->site.lit == n)
+		c->site.lit += alias_literal(&a->prog, 0, 0);
+	if (a->blank && lit > 1)
+		next = cmd_lookup(tokens[1], 0);
+	a->busy = 1;
+	a->refs++;
+	if (next != NULL && next->alias != NULL && next->alias->simple &&
+	    !next->alias->busy)
+		status = alias_expand(next->alias, tokens + 1, lit - 1, c);
+	else
+	{
+		if ((size_t)c->site.lit == c->out.n)
+			c->site.lit += lit - 1;
+		for (tokens++; *tokens != NULL; tokens++)
+			fields_add(&c->out, *tokens);
+		if (c->out.n > 0)
+		{
+			alias_pending = c->site.lit > 0 ? &c->site : NULL;
+			status = dispatch_command(c->out.v, c->line_number,
+						  c->program_name);
+		}
+	}
+	a->busy = 0;
+	alias_release(a);
+	return (status);
+}
+
+/**
+ * alias_dispatch - Run a command whose name is an alias
+ * @a: The alias
+ * @tokens: The name of the alias and the arguments
+ * @lit: The number of words of @tokens that were literal in the input
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: dispatch_command finds aliases with the same hash probe as
+ * the builtins and functions, before them, and only for a literal name,
+ * so a command that is no alias pays a pointer test for them, and an
+ * external program nothing. A simple alias is replaced by its words, and
+ * the command they form dispatched again; any other is run as a program.
+ *
+ * Return: The status of the command.
+ */
+int alias_dispatch(alias_t *a, char **tokens, int lit, int line_number,
+		   char *program_name)
+{
+	alias_cmd_t c;
+	int status;
+
+	if (a->simple)
+	{
+		fields_init(&c.out);
+		c.site.prog = NULL;
+		c.site.pc = 0;
+		c.site.lit = 0;
+		c.line_number = line_number;
+		c.program_name = program_name;
+		status = alias_expand(a, tokens, lit, &c);
+		fields_free(&c.out);
+		return (status);
+	}
+	a->busy = 1;
+	a->refs++;
+	status = alias_run(a, tokens, lit, program_name);
+	a->busy = 0;
+	alias_release(a);
+	return (status);
+}
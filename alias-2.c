@@ -0,0 +1,102 @@
+#include "main.h"
+
+/**
+ * alias_literal - Count the literal words of a command from one of them
+ * @prog: The program
+ * @pc: Index of the OP_CMD instruction
+ * @first: Index of the word to start at, that of the command name
+ *
+ * Description: A literal word has no quotes, no backslash, nothing to
+ * expand and no pattern, so it is its own single field, and an alias can
+ * replace it, as in /bin/sh: '\ls', '"ls"' or '$cmd' never name one.
+ *
+ * Return: The number of literal words from @first on.
+ */
+int alias_literal(const program_t *prog, size_t pc, int first)
+{
+	int argc = (int)prog->code[pc + 2], n;
+
+	for (n = 0; first + n < argc; n++)
+	{
+		if (prog_word(prog, pc, first + n)[-1] & (WORD_QUOTED |
+		    WORD_DOLLAR | WORD_GLOB | WORD_TILDE | WORD_ASSIGN))
+			break;
+	}
+	return (n);
+}
+
+/**
+ * alias_placeholder - Find the placeholder word of the tail of an alias
+ * @prog: The value of the alias compiled with the placeholder after it
+ *
+ * Description: The placeholder is the last word of the text, so it is the
+ * last word of the string pool, unless a comment at the end of the value
+ * swallowed it.
+ *
+ * Return: The index of the OP_CMD instruction it ends, or (size_t)-1.
+ */
+static size_t alias_placeholder(const program_t *prog)
+{
+	const char *last = prog->strings + prog->str_len - 1, *word;
+	size_t pc, found = (size_t)-1;
+	uint32_t argc;
+
+	for (pc = 0; pc < prog->code_len; pc += op_length(prog->code + pc))
+	{
+		if (prog->code[pc] != OP_CMD || prog->code[pc + 2] == 0)
+			continue;
+		argc = prog->code[pc + 2];
+		word = prog_word(prog, pc, (int)argc - 1);
+		if (word == last && *word == '\0' && word[-1] == WORD_QUOTED)
+			found = pc;
+	}
+	return (found);
+}
+
+/**
+ * alias_compile - Compile the value of an alias
+ * @a: The alias, whose other fields are set here
+ * @value: The value
+ *
+ * Description: The value is compiled once, here, rather than each time
+ * the alias is used. A value that compiles to a single command of words,
+ * without assignments or redirections, is marked simple: its words are
+ * expanded in place of the name of the alias when it is used. One that
+ * ends with an operator is not, since the arguments of the alias then
+ * start a command of their own, nor is one that ends with a comment,
+ * which swallows them. Any other is kept compiled a second time, followed
+ * by an empty quoted word standing for the arguments, so they join the
+ * command the parser gives them to, whatever the value ends with.
+ *
+ * Return: None.
+ */
+void alias_compile(alias_t *a, const char *value)
+{
+	size_t vlen = strlen(value), end = vlen;
+	char *buf = malloc(vlen + 4);
+	uint32_t i;
+
+	if (buf == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(buf, value, vlen + 1);
+	parse_program(&a->prog, buf, vlen, 1, 1);
+	while (end > 0 && (value[end - 1] == ' ' || value[end - 1] == '\t'))
+		end--;
+	a->simple = a->prog.code[0] == OP_CMD && a->prog.code[3] == 0 &&
+		    a->prog.code[op_length(a->prog.code)] == OP_END &&
+		    (end == 0 || strchr(";&\n", value[end - 1]) == NULL);
+	for (i = 0; a->simple && i < a->prog.code[2]; i++)
+		a->simple = !(prog_word(&a->prog, 0, (int)i)[-1] & WORD_ASSIGN);
+	a->blank = end < vlen;
+	memcpy(buf, value, vlen);
+	memcpy(buf + vlen, " ''", 4);
+	parse_program(&a->tail, buf, vlen + 3, 1, 1);
+	a->tail_pc = alias_placeholder(&a->tail);
+	free(buf);
+	a->simple = a->simple && a->tail_pc != (size_t)-1;
+	if (a->simple)
+		prog_free(&a->tail);
+}
@@ -0,0 +1,144 @@
+#include "main.h"
+
+/* Where the name of the command run_command dispatches comes from */
+alias_site_t *alias_pending;
+/* The arguments of the innermost alias being run that is not simple */
+alias_args_t *alias_args;
+
+/**
+ * alias_find - Get the alias the name of a command stands for
+ * @site: Where the name comes from
+ * @cmd: The entry of the name in the command table, or NULL
+ *
+ * Description: In the body of a function, the aliases are those the
+ * names stood for when the function was defined, found by index of the
+ * command with a binary search; anywhere else, those defined now.
+ *
+ * Return: The alias, or NULL if the name is none.
+ */
+alias_t *alias_find(const alias_site_t *site, command_t *cmd)
+{
+	const program_t *prog = site->prog;
+	size_t lo = 0, hi, mid;
+
+	if (prog == NULL || !prog->bound)
+		return (cmd != NULL ? cmd->alias : NULL);
+	hi = prog->nbinds;
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if (prog->binds[mid].pc < site->pc)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo < prog->nbinds && prog->binds[lo].pc == site->pc)
+		return (prog->binds[lo].alias);
+	return (NULL);
+}
+
+/**
+ * alias_bind_add - Record the alias a command of a function stands for
+ * @prog: The body of the function
+ * @pc: Index of the command, after those already recorded
+ * @a: The alias, which gets a reference
+ *
+ * Description: The array doubles whenever its size is a power of two.
+ *
+ * Return: None.
+ */
+static void alias_bind_add(program_t *prog, size_t pc, alias_t *a)
+{
+	alias_bind_t *binds = prog->binds;
+	size_t n = prog->nbinds;
+
+	if ((n & (n - 1)) == 0)
+	{
+		binds = realloc(binds, (n ? n * 2 : 1) * sizeof(*binds));
+		if (binds == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		prog->binds = binds;
+	}
+	binds[n].pc = pc;
+	binds[n].alias = a;
+	a->refs++;
+	prog->nbinds = n + 1;
+}
+
+/**
+ * alias_bind - Fix the aliases of the commands of a function
+ * @dst: The body, just copied out of @src by prog_extract
+ * @src: The program that defines the function
+ * @start: Index of the first instruction of the body in @src
+ *
+ * Description: /bin/sh replaces aliases when it reads a function, so the
+ * body keeps the aliases its literal command names stood for when it was
+ * defined, even once they are redefined or removed. A function defined
+ * in the body of another one keeps those of the outer function.
+ *
+ * Return: None.
+ */
+void alias_bind(program_t *dst, const program_t *src, size_t start)
+{
+	command_t *cmd;
+	size_t pc, i;
+	int first, argc;
+
+	dst->bound = 1;
+	for (i = 0; src->bound && i < src->nbinds; i++)
+	{
+		if (src->binds[i].pc >= start &&
+		    src->binds[i].pc - start < dst->code_len)
+			alias_bind_add(dst, src->binds[i].pc - start,
+				       src->binds[i].alias);
+	}
+	for (pc = 0; !src->bound && pc < dst->code_len;
+	     pc += op_length(dst->code + pc))
+	{
+		if (dst->code[pc] != OP_CMD)
+			continue;
+		argc = (int)dst->code[pc + 2];
+		for (first = 0; first < argc &&
+		     (prog_word(dst, pc, first)[-1] & WORD_ASSIGN); first++)
+			;
+		if (alias_literal(dst, pc, first) == 0)
+			continue;
+		cmd = cmd_lookup(prog_word(dst, pc, first), 0);
+		if (cmd != NULL && cmd->alias != NULL)
+			alias_bind_add(dst, pc, cmd->alias);
+	}
+}
+
+/**
+ * alias_tail - Give a command the arguments of the alias it ends
+ * @prog: The program
+ * @pc: Index of the OP_CMD instruction
+ * @args: The fields of the command
+ * @first: Index of the word of the command name, after the assignments
+ *
+ * Description: When the command holds the placeholder of the innermost
+ * alias being run, the empty field of the placeholder, always the last
+ * one, is replaced by the arguments of the alias. A single pointer test
+ * tells the other commands apart.
+ *
+ * Return: The number of fields at the start of @args that come from
+ * literal words.
+ */
+int alias_tail(const program_t *prog, size_t pc, fields_t *args, int first)
+{
+	alias_args_t *t = alias_args;
+	int lit = alias_literal(prog, pc, first);
+	char **arg;
+
+	if (t == NULL || t->prog != prog || t->pc != pc)
+		return (lit);
+	args->v[--args->n] = NULL;
+	for (arg = t->args; *arg != NULL; arg++)
+		fields_add(args, *arg);
+	if (first + lit == (int)prog->code[pc + 2] - 1)
+		lit += t->lit;
+	return (lit);
+}
@@ -0,0 +1,176 @@
+#include "main.h"
+
+/**
+ * alias_print - Print an alias the way alias lists it
+ * @name: The name of the alias
+ * @a: The alias
+ *
+ * Description: The value is single-quoted, each quote it holds written as
+ * '"'"', so the output can be read back by the shell.
+ *
+ * Return: None.
+ */
+static void alias_print(const char *name, const alias_t *a)
+{
+	const char *p;
+
+	printf("%s='", name);
+	for (p = a->value; *p != '\0'; p++)
+	{
+		if (*p == '\'')
+			printf("'\"'\"'");
+		else
+			putchar(*p);
+	}
+	printf("'\n");
+}
+
+/**
+ * alias_list - Print all the aliases, sorted by name
+ *
+ * Return: 0.
+ */
+static int alias_list(void)
+{
+	command_table_t *t = &command_table;
+	char **names = malloc((t->count + 1) * sizeof(*names));
+	size_t i, n = 0;
+
+	if (names == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < t->size; i++)
+	{
+		if (t->slots[i] != NULL && t->slots[i]->alias != NULL)
+			names[n++] = t->slots[i]->name;
+	}
+	qsort(names, n, sizeof(*names), glob_cmp);
+	for (i = 0; i < n; i++)
+		alias_print(names[i], cmd_lookup(names[i], 0)->alias);
+	free(names);
+	return (0);
+}
+
+/**
+ * alias_define - Define or redefine an alias
+ * @word: The operand of alias, "name=value"
+ * @len: Length of the name
+ *
+ * Description: The value is compiled by alias_compile.
+ *
+ * Return: None.
+ */
+static void alias_define(const char *word, size_t len)
+{
+	const char *value = word + len + 1;
+	alias_t *a = calloc(1, sizeof(*a));
+	char *name = malloc(len + 1);
+	command_t *cmd;
+
+	if (a != NULL)
+		a->value = _strdup(value);
+	if (a == NULL || name == NULL || a->value == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(name, word, len);
+	name[len] = '\0';
+	alias_compile(a, value);
+	a->refs = 1;
+	cmd = cmd_lookup(name, 1);
+	free(name);
+	cmd_save(cmd);
+	if (cmd->alias != NULL)
+		alias_release(cmd->alias);
+	cmd->alias = a;
+}
+
+/**
+ * builtin_alias - Define or print aliases
+ * @tokens: The command and its operands: "name=value" defines an alias,
+ * a name alone prints it, and no operand prints them all
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Description: The messages are those of /bin/sh.
+ *
+ * Return: 0 on success, 1 if an alias to print is not defined.
+ */
+int builtin_alias(char **tokens, int line_number, char *program_name)
+{
+	command_t *cmd;
+	char *eq;
+	int i, status = 0;
+
+	(void)line_number;
+	(void)program_name;
+	if (tokens[1] == NULL)
+		return (alias_list());
+	for (i = 1; tokens[i] != NULL; i++)
+	{
+		eq = strchr(tokens[i], '=');
+		cmd = eq == NULL ? cmd_lookup(tokens[i], 0) : NULL;
+		if (eq != NULL && eq > tokens[i])
+			alias_define(tokens[i], (size_t)(eq - tokens[i]));
+		else if (cmd != NULL && cmd->alias != NULL)
+			alias_print(cmd->name, cmd->alias);
+		else
+		{
+			fprintf(stderr, "alias: %s not found\n", tokens[i]);
+			status = 1;
+		}
+	}
+	return (status);
+}
+
+/**
+ * builtin_unalias - Remove aliases
+ * @tokens: The command and the names of the aliases, or '-a' for all of
+ * them
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Return: 0 on success, 1 if an alias is not defined, 2 on a usage error.
+ */
+int builtin_unalias(char **tokens, int line_number, char *program_name)
+{
+	command_table_t *t = &command_table;
+	command_t *cmd;
+	int i, status = 0, all = tokens[1] != NULL &&
+		_strcmp(tokens[1], "-a") == 0;
+	size_t j;
+
+	if (!all && tokens[1] != NULL && tokens[1][0] == '-' &&
+	    tokens[1][1] != '\0')
+	{
+		fprintf(stderr, "%s: %d: unalias: Illegal option %.2s\n",
+			program_name, line_number, tokens[1]);
+		return (2);
+	}
+	for (j = 0; all && j < t->size; j++)
+	{
+		if (t->slots[j] != NULL && t->slots[j]->alias != NULL)
+		{
+			cmd_save(t->slots[j]);
+			alias_release(t->slots[j]->alias);
+			t->slots[j]->alias = NULL;
+		}
+	}
+	for (i = 1; !all && tokens[i] != NULL; i++)
+	{
+		cmd = cmd_lookup(tokens[i], 0);
+		if (cmd == NULL || cmd->alias == NULL)
+		{
+			fprintf(stderr, "unalias: %s not found\n", tokens[i]);
+			status = 1;
+			continue;
+		}
+		cmd_save(cmd);
+		alias_release(cmd->alias);
+		cmd->alias = NULL;
+	}
+	return (status);
+}
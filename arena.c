@@ -0,0 +1,117 @@
+#include "main.h"
+
+#define ARENA_CHUNK 8192
+
+/* The memory expansions are allocated from, see arena_alloc */
+static arena_t line_arena;
+
+/**
+ * arena_alloc - Allocate memory from the expansion arena
+ * @size: The number of bytes
+ *
+ * Description: Allocation bumps an offset in the current chunk. The chunks
+ * are never freed by arena_release, only rewound, so once the first lines
+ * have run the arena already holds enough memory and expanding the words of
+ * a command costs no call to malloc. A chunk too small for a request is
+ * replaced by a new one large enough.
+ *
+ * Return: The memory, aligned for any pointer.
+ */
+void *arena_alloc(size_t size)
+{
+	arena_t *a = &line_arena;
+	arena_chunk_t *next, *chunk;
+	void *mem;
+
+	size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+	if (a->cur == NULL || a->used + size > a->cur->size)
+	{
+		next = a->cur != NULL ? a->cur->next : a->head;
+		if (next == NULL || next->size < size)
+		{
+			chunk = malloc(sizeof(*chunk) + (size > ARENA_CHUNK ?
+							  size : ARENA_CHUNK));
+			if (chunk == NULL)
+			{
+				perror("Memory allocation error");
+				exit(EXIT_FAILURE);
+			}
+			chunk->size = size > ARENA_CHUNK ? size : ARENA_CHUNK;
+			chunk->next = next != NULL ? next->next : NULL;
+			free(next);
+			if (a->cur != NULL)
+				a->cur->next = chunk;
+			else
+				a->head = chunk;
+			next = chunk;
+		}
+		next->base = a->cur != NULL ? a->cur->base + a->cur->size : 0;
+		a->cur = next;
+		a->used = 0;
+	}
+	mem = (char *)(a->cur + 1) + a->used;
+	a->used += size;
+	return (mem);
+}
+
+/**
+ * arena_strndup - Copy a string into the expansion arena
+ * @str: The string; it does not need to be terminated
+ * @len: Its length
+ *
+ * Return: The NUL-terminated copy.
+ */
+char *arena_strndup(const char *str, size_t len)
+{
+	char *copy = arena_alloc(len + 1);
+
+	memcpy(copy, str, len);
+	copy[len] = '\0';
+	return (copy);
+}
+
+/**
+ * arena_mark - Get the current top of the expansion arena
+ *
+ * Return: A mark to give to arena_release.
+ */
+arena_mark_t arena_mark(void)
+{
+	arena_mark_t mark;
+
+	mark.chunk = line_arena.cur;
+	mark.used = line_arena.used;
+	return (mark);
+}
+
+/**
+ * arena_release - Free everything allocated since a mark was taken
+ * @mark: The mark
+ *
+ * Description: Commands, and the for loops that expanded their words,
+ * release what they allocated when they end. They nest, so the arena is
+ * used like a stack and releasing is only a matter of rewinding it.
+ *
+ * Return: None.
+ */
+void arena_release(arena_mark_t mark)
+{
+	line_arena.cur = mark.chunk;
+	line_arena.used = mark.used;
+}
+
+/**
+ * arena_pos - Get the position of the top of the expansion arena
+ *
+ * Description: Positions count the bytes of the chunks below the top, so
+ * they grow as the arena does and tell whether what was allocated at some
+ * point has been released since: it has once the position is lower.
+ *
+ * Return: The position.
+ */
+size_t arena_pos(void)
+{
+	if (line_arena.cur == NULL)
+		return (0);
+	return (line_arena.cur->base + line_arena.used);
+}
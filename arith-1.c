@@ -0,0 +1,217 @@
+#include "main.h"
+
+/**
+ * parse_int64 - Convert the number at the start of a string
+ * @str: The string, which does not need to be terminated
+ * @len: Its length
+ * @value: Where the number is stored
+ *
+ * Description: The number may have a sign, and is octal when it starts
+ * with 0 and hexadecimal when it starts with 0x. Overflow is detected
+ * before each digit is added, so the whole range of a 64-bit integer is
+ * accepted and nothing beyond it.
+ *
+ * Return: The number of bytes read, 0 if there is no number, or -1 if it
+ * does not fit in 64 bits.
+ */
+int parse_int64(const char *str, size_t len, int64_t *value)
+{
+	const char *p = str, *end = str + len, *digits;
+	uint64_t n = 0, limit = INT64_MAX, base = 10, d;
+	int neg = 0;
+
+	if (p < end && (*p == '-' || *p == '+'))
+		neg = *p++ == '-';
+	limit += neg;
+	if (p < end && *p == '0')
+		base = 8;
+	if (end - p > 2 && (p[1] == 'x' || p[1] == 'X') && *p == '0' &&
+	    isxdigit((unsigned char)p[2]))
+		base = 16, p += 2;
+	for (digits = p; p < end; p++)
+	{
+		if (isdigit((unsigned char)*p))
+			d = (uint64_t)(*p - '0');
+		else if (base == 16 && isxdigit((unsigned char)*p))
+			d = (uint64_t)(tolower((unsigned char)*p) - 'a' + 10);
+		else
+			break;
+		if (d >= base)
+			break;
+		if (n > (limit - d) / base)
+			return (-1);
+		n = n * base + d;
+	}
+	if (p == digits)
+		return (0);
+	*value = neg ? (int64_t)(0 - n) : (int64_t)n;
+	return ((int)(p - str));
+}
+
+/**
+ * arith_var - Get the value of a variable of an expression
+ * @ex: The expansion, for error messages
+ * @e: The expression
+ * @n: The ARITH_VAR or ARITH_ASSIGN node naming the variable
+ * @out: Where the value is stored
+ *
+ * Description: A variable that is not set or is empty is 0. Any other
+ * value must be a number, with optional blanks around it.
+ *
+ * Return: 0 on success, -1 if the value is not a number.
+ */
+static int arith_var(expand_t *ex, const arith_t *e, const arith_node_t *n,
+		     int64_t *out)
+{
+	var_t *v = var_lookup(e->text + n->name, n->len, 0);
+	const char *value, *p;
+	int len;
+
+	*out = 0;
+	if (v == NULL || (v->flags & VAR_UNSET))
+		return (0);
+	value = v->str + v->name_len + 1;
+	for (p = value; *p == ' ' || *p == '\t' || *p == '\n'; p++)
+		;
+	if (*p == '\0')
+		return (0);
+	len = parse_int64(p, strlen(p), out);
+	if (len > 0)
+		for (p += len; *p == ' ' || *p == '\t' || *p == '\n'; p++)
+			;
+	if (len > 0 && *p == '\0')
+		return (0);
+	fprintf(stderr, "%s: %d: Illegal number: %s\n", ex->program_name,
+		ex->line, value);
+	ex->error = 1;
+	if (!interactive)
+		exit_requested = 1;
+	return (-1);
+}
+
+/**
+ * arith_apply - Apply a binary operator
+ * @ex: The expansion, for error messages
+ * @e: The expression, for error messages
+ * @op: The ARITH_ operation
+ * @a: The left operand
+ * @b: The right operand
+ * @out: Where the result is stored
+ *
+ * Description: Addition, subtraction and multiplication are checked for
+ * overflow, and division for a zero divisor and for the one quotient that
+ * does not fit, INT64_MIN / -1. Shift counts are taken modulo 64.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int arith_apply(expand_t *ex, const arith_t *e, int op, int64_t a,
+		       int64_t b, int64_t *out)
+{
+	if ((op == ARITH_DIV || op == ARITH_MOD) && b == 0)
+	{
+		arith_error(ex, "division by zero", e->text);
+		return (-1);
+	}
+	if ((op == ARITH_ADD && __builtin_add_overflow(a, b, out)) ||
+	    (op == ARITH_SUB && __builtin_sub_overflow(a, b, out)) ||
+	    (op == ARITH_MUL && __builtin_mul_overflow(a, b, out)) ||
+	    ((op == ARITH_DIV || op == ARITH_MOD) && a == INT64_MIN &&
+	     b == -1))
+	{
+		arith_error(ex, "integer overflow", e->text);
+		return (-1);
+	}
+	switch (op)
+	{
+	case ARITH_DIV: *out = a / b; break;
+	case ARITH_MOD: *out = a % b; break;
+	case ARITH_SHL: *out = (int64_t)((uint64_t)a << (b & 63)); break;
+	case ARITH_SHR: *out = a >> (b & 63); break;
+	case ARITH_BOR: *out = a | b; break;
+	case ARITH_XOR: *out = a ^ b; break;
+	case ARITH_BAND: *out = a & b; break;
+	case ARITH_EQ: *out = a == b; break;
+	case ARITH_NE: *out = a != b; break;
+	case ARITH_LT: *out = a < b; break;
+	case ARITH_LE: *out = a <= b; break;
+	case ARITH_GT: *out = a > b; break;
+	case ARITH_GE: *out = a >= b; break;
+	}
+	return (0);
+}
+
+/**
+ * arith_store - Evaluate an assignment
+ * @ex: The expansion, for error messages
+ * @e: The expression
+ * @n: The ARITH_ASSIGN node
+ * @out: Where the assigned value is stored
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int arith_store(expand_t *ex, const arith_t *e, const arith_node_t *n,
+		       int64_t *out)
+{
+	int64_t value, old;
+	char num[24];
+
+	if (arith_eval(ex, e, n->a, &value) == -1)
+		return (-1);
+	if (n->sub != ARITH_NUM && (arith_var(ex, e, n, &old) == -1 ||
+				    arith_apply(ex, e, n->sub, old, value,
+						&value) == -1))
+		return (-1);
+	snprintf(num, sizeof(num), "%ld", (long)value);
+	var_assign(var_lookup(e->text + n->name, n->len, 1), num, 0);
+	*out = value;
+	return (0);
+}
+
+/**
+ * arith_eval - Evaluate a node of an expression tree
+ * @ex: The expansion, for error messages
+ * @e: The expression
+ * @i: Index of the node
+ * @out: Where the value is stored
+ *
+ * Description: "&&", "||" and the conditional operator only evaluate the
+ * operands they need, so "x && (y = 1)" leaves y alone when x is 0.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int arith_eval(expand_t *ex, const arith_t *e, uint32_t i, int64_t *out)
+{
+	const arith_node_t *n = &e->nodes[i];
+	int64_t a, b;
+
+	if (n->op == ARITH_NUM)
+	{
+		*out = n->num;
+		return (0);
+	}
+	if (n->op == ARITH_VAR)
+		return (arith_var(ex, e, n, out));
+	if (n->op == ARITH_ASSIGN)
+		return (arith_store(ex, e, n, out));
+	if (arith_eval(ex, e, n->a, &a) == -1)
+		return (-1);
+	if (n->op == ARITH_COND)
+		return (arith_eval(ex, e, a ? n->b : n->c, out));
+	if (n->op == ARITH_NEG)
+		return (arith_apply(ex, e, ARITH_SUB, 0, a, out));
+	if (n->op == ARITH_NOT || n->op == ARITH_BNOT ||
+	    (n->op == ARITH_AND && !a) || (n->op == ARITH_OR && a))
+	{
+		*out = n->op == ARITH_NOT ? !a : n->op == ARITH_BNOT ? ~a :
+			n->op == ARITH_OR;
+		return (0);
+	}
+	if (arith_eval(ex, e, n->b, &b) == -1)
+		return (-1);
+	if (n->op == ARITH_AND || n->op == ARITH_OR)
+	{
+		*out = b != 0;
+		return (0);
+	}
+	return (arith_apply(ex, e, n->op, a, b, out));
+}
@@ -0,0 +1,165 @@
+#include "main.h"
+
+/* The expressions parsed so far, by text */
+static arith_cache_t arith_cache;
+
+/**
+ * arith_error - Report an error in an arithmetic expression
+ * @ex: The expansion, which is marked as failed
+ * @msg: What is wrong
+ * @text: The text of the expression
+ *
+ * Description: Like a syntax error, it makes a shell that is not
+ * interactive exit.
+ *
+ * Return: None.
+ */
+void arith_error(expand_t *ex, const char *msg, const char *text)
+{
+	fprintf(stderr, "%s: %d: arithmetic expression: %s: \"%s\"\n",
+		ex->program_name, ex->line, msg, text);
+	ex->error = 1;
+	if (!interactive)
+		exit_requested = 1;
+}
+
+/**
+ * arith_parse - Parse an arithmetic expression into a tree
+ * @ex: The expansion, for error messages
+ * @text: The text of the expression, after its parameters were expanded
+ * @len: Its length
+ *
+ * Return: The expression, to free with arith_free, or NULL after a syntax
+ * error, which is reported.
+ */
+arith_t *arith_parse(expand_t *ex, const char *text, size_t len)
+{
+	arith_t *e = calloc(1, sizeof(*e));
+	arith_parser_t ap;
+
+	if (e != NULL)
+		e->text = malloc(len + 1);
+	if (e == NULL || e->text == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(e->text, text, len);
+	e->text[len] = '\0';
+	ap.expr = e;
+	ap.p = e->text;
+	ap.end = e->text + len;
+	ap.error = NULL;
+	e->root = arith_expr(&ap);
+	if (ap.error == NULL && arith_skip(&ap) != ap.end)
+		ap.error = "expecting EOF";
+	if (ap.error == NULL)
+		return (e);
+	arith_error(ex, ap.error, e->text);
+	arith_free(e);
+	return (NULL);
+}
+
+/**
+ * arith_free - Free a parsed arithmetic expression
+ * @e: The expression
+ *
+ * Return: None.
+ */
+void arith_free(arith_t *e)
+{
+	free(e->nodes);
+	free(e->text);
+	free(e);
+}
+
+/**
+ * arith_grow - Make room in the cache for one more expression
+ *
+ * Description: The table doubles while it is less than half full. Once it
+ * holds ARITH_CACHE_MAX expressions, which only a script that builds
+ * expressions out of ever-changing text reaches, it is emptied instead, so
+ * it cannot grow without bound.
+ *
+ * Return: None.
+ */
+static void arith_grow(void)
+{
+	arith_cache_t *t = &arith_cache;
+	size_t new_size = t->size ? t->size * 2 : 64, i, j;
+	arith_t **slots;
+
+	if (t->count + 1 > ARITH_CACHE_MAX)
+	{
+		for (i = 0; i < t->size; i++)
+			if (t->slots[i] != NULL)
+				arith_free(t->slots[i]);
+		memset(t->slots, 0, t->size * sizeof(*t->slots));
+		t->count = 0;
+	}
+	if ((t->count + 1) * 2 <= t->size)
+		return;
+	slots = calloc(new_size, sizeof(*slots));
+	if (slots == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < t->size; i++)
+	{
+		if (t->slots[i] == NULL)
+			continue;
+		j = hash_string(t->slots[i]->text) & (new_size - 1);
+		while (slots[j] != NULL)
+			j = (j + 1) & (new_size - 1);
+		slots[j] = t->slots[i];
+	}
+	free(t->slots);
+	t->slots = slots;
+	t->size = new_size;
+}
+
+/**
+ * arith_find - Get the parsed tree of an expression without parameters
+ * @ex: The expansion, for error messages
+ * @text: The text of the expression
+ * @len: Its length
+ *
+ * Description: The text of such an expression is the same each time the
+ * line holding it runs, so a loop counter such as "$((i + 1))" is parsed
+ * on the first iteration and only evaluated on the next ones. Expressions
+ * with a syntax error are not kept, so the error is reported each time.
+ *
+ * Return: The expression, which belongs to the cache, or NULL after a
+ * syntax error.
+ */
+arith_t *arith_find(expand_t *ex, const char *text, size_t len)
+{
+	arith_cache_t *t = &arith_cache;
+	size_t i, mask;
+	arith_t *e;
+
+	if (t->size > 0)
+	{
+		mask = t->size - 1;
+		for (i = hash_bytes(text, len) & mask; t->slots[i] != NULL;
+		     i = (i + 1) & mask)
+		{
+			e = t->slots[i];
+			if (strncmp(e->text, text, len) == 0 &&
+			    e->text[len] == '\0')
+				return (e);
+		}
+	}
+	e = arith_parse(ex, text, len);
+	if (e == NULL)
+		return (NULL);
+	arith_grow();
+	mask = t->size - 1;
+	for (i = hash_bytes(text, len) & mask; t->slots[i] != NULL;
+	     i = (i + 1) & mask)
+		;
+	t->slots[i] = e;
+	t->count++;
+	return (e);
+}
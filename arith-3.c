@@ -0,0 +1,73 @@
+#include "main.h"
+
+/**
+ * arith_end - Find the "))" that closes an arithmetic expansion
+ * @p: The start of the expression, after "$(("
+ * @end: End of the text
+ *
+ * Description: The parentheses of the expression must balance before the
+ * closing "))". When they do not, as in "$((cd dir) && ls)", the text is a
+ * command substitution that starts with a subshell instead.
+ *
+ * Return: The first ')' of the pair, or NULL if there is none.
+ */
+static const char *arith_end(const char *p, const char *end)
+{
+	int depth = 0;
+
+	for (; p < end; p++)
+	{
+		if (*p == '(')
+			depth++;
+		else if (*p == ')' && depth > 0)
+			depth--;
+		else if (*p == ')')
+			return (p + 1 < end && p[1] == ')' ? p : NULL);
+	}
+	return (NULL);
+}
+
+/**
+ * exp_arith - Expand a "$((expression))" substitution
+ * @ex: The expansion
+ * @p: The '$'
+ * @end: End of the text
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: The expression is evaluated in the shell with 64-bit
+ * integers. One that holds no expansion or quote is looked up in the
+ * cache by its text, so it is only parsed once; the others are expanded
+ * as if they were inside double quotes, then parsed each time.
+ *
+ * Return: The position after the substitution, or NULL if it is not an
+ * arithmetic expansion.
+ */
+const char *exp_arith(expand_t *ex, const char *p, const char *end, int dq)
+{
+	const char *start = p + 3, *stop = arith_end(start, end), *q;
+	arith_t *e = NULL;
+	char num[24], *text;
+	int64_t value;
+
+	if (stop == NULL)
+		return (NULL);
+	for (q = start; q < stop && *q != '\0' &&
+	     _strchr("$`'\"\\", *q) == NULL; q++)
+		;
+	if (q == stop)
+		e = arith_find(ex, start, (size_t)(stop - start));
+	else
+	{
+		text = exp_sub(ex, EXP_STRING, start, stop, 1);
+		if (text != NULL)
+			e = arith_parse(ex, text, strlen(text));
+	}
+	if (e != NULL && arith_eval(ex, e, e->root, &value) == 0)
+	{
+		snprintf(num, sizeof(num), "%ld", (long)value);
+		exp_put(ex, num, strlen(num), dq ? PUT_QUOTED : PUT_EXPANDED);
+	}
+	if (e != NULL && q != stop)
+		arith_free(e);
+	return (stop + 2);
+}
@@ -0,0 +1,82 @@
+#include "main.h"
+
+/**
+ * arith_name_end - Find the end of a variable name in an expression
+ * @p: The start of the name
+ * @end: End of the expression
+ *
+ * Return: The first character after the name, which is @p if there is no
+ * name there.
+ */
+const char *arith_name_end(const char *p, const char *end)
+{
+	const char *q = p;
+
+	while (q < end && (*q == '_' || isalpha((unsigned char)*q) ||
+			   (q > p && isdigit((unsigned char)*q))))
+		q++;
+	return (q);
+}
+
+/**
+ * arith_number - Parse a number in an expression
+ * @ap: The parser
+ * @p: The first digit
+ *
+ * Description: Numbers are decimal, octal with a leading 0, or hexadecimal
+ * with a leading 0x, and are converted once, here, with the same checked
+ * parser as the values of variables.
+ *
+ * Return: The index of the ARITH_NUM node.
+ */
+uint32_t arith_number(arith_parser_t *ap, const char *p)
+{
+	int64_t value = 0;
+	uint32_t i;
+	int n;
+
+	n = parse_int64(p, (size_t)(ap->end - p), &value);
+	if (n == -1)
+		ap->error = "number out of range";
+	ap->p += n > 0 ? n : 0;
+	i = arith_node(ap, ARITH_NUM, 0, 0);
+	ap->expr->nodes[i].num = value;
+	return (i);
+}
+
+/**
+ * arith_assign_op - Recognize the operator of an assignment
+ * @ap: The parser, positioned after a variable name and blanks
+ * @len: Where the length of the operator is stored
+ *
+ * Description: The operator is '=', or a binary operator followed by '=',
+ * such as "+=" or "<<=". "==" is a comparison, not an assignment.
+ *
+ * Return: ARITH_NUM for a plain '=', the node type of the binary operator
+ * for the others, or -1 if there is no assignment.
+ */
+int arith_assign_op(arith_parser_t *ap, int *len)
+{
+	static const int codes[] = {ARITH_MUL, ARITH_DIV, ARITH_MOD,
+		ARITH_ADD, ARITH_SUB, ARITH_BAND, ARITH_XOR, ARITH_BOR};
+	const char *p = ap->p, *ops = "*/%+-&^|";
+
+	if (p < ap->end && *p == '=' && (p + 1 == ap->end || p[1] != '='))
+	{
+		*len = 1;
+		return (ARITH_NUM);
+	}
+	if (ap->end - p > 1 && p[1] == '=' && *p != '\0' &&
+	    _strchr(ops, *p) != NULL)
+	{
+		*len = 2;
+		return (codes[_strchr(ops, *p) - ops]);
+	}
+	if (ap->end - p > 2 && p[2] == '=' && (*p == '<' || *p == '>') &&
+	    p[1] == *p)
+	{
+		*len = 3;
+		return (*p == '<' ? ARITH_SHL : ARITH_SHR);
+	}
+	return (-1);
+}
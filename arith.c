@@ -0,0 +1,194 @@
+#include "main.h"
+
+/* The binary operators, longest first so "<<" is not read as '<' */
+static const char * const binary_ops[] = {
+	"||", "&&", "==", "!=", "<=", ">=", "<<", ">>",
+	"|", "^", "&", "<", ">", "+", "-", "*", "/", "%", NULL
+};
+static const int binary_codes[] = {
+	ARITH_OR, ARITH_AND, ARITH_EQ, ARITH_NE, ARITH_LE, ARITH_GE,
+	ARITH_SHL, ARITH_SHR, ARITH_BOR, ARITH_XOR, ARITH_BAND, ARITH_LT,
+	ARITH_GT, ARITH_ADD, ARITH_SUB, ARITH_MUL, ARITH_DIV, ARITH_MOD
+};
+static const int binary_precs[] = {
+	1, 2, 6, 6, 7, 7, 8, 8, 3, 4, 5, 7, 7, 9, 9, 10, 10, 10
+};
+
+/**
+ * arith_skip - Skip the blanks before the next token of an expression
+ * @ap: The parser
+ *
+ * Return: The start of the next token, which is also stored in @ap.
+ */
+const char *arith_skip(arith_parser_t *ap)
+{
+	while (ap->p < ap->end && (*ap->p == ' ' || *ap->p == '\t' ||
+				   *ap->p == '\n'))
+		ap->p++;
+	return (ap->p);
+}
+
+/**
+ * arith_node - Add a node to the tree of an expression
+ * @ap: The parser
+ * @op: The operation of the node
+ * @a: Index of its first operand
+ * @b: Index of its second operand
+ *
+ * Return: The index of the node.
+ */
+uint32_t arith_node(arith_parser_t *ap, int op, uint32_t a, uint32_t b)
+{
+	arith_t *e = ap->expr;
+	arith_node_t *nodes;
+	size_t cap;
+
+	if (e->count == e->cap)
+	{
+		cap = e->cap ? (size_t)e->cap * 2 : 16;
+		nodes = realloc(e->nodes, cap * sizeof(*nodes));
+		if (nodes == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		e->nodes = nodes;
+		e->cap = (uint32_t)cap;
+	}
+	memset(&e->nodes[e->count], 0, sizeof(*e->nodes));
+	e->nodes[e->count].op = op;
+	e->nodes[e->count].a = a;
+	e->nodes[e->count].b = b;
+	return (e->count++);
+}
+
+/**
+ * arith_primary - Parse a number, a variable, a parenthesized expression
+ * or a unary operator and its operand
+ * @ap: The parser
+ *
+ * Description: Numbers are read by arith_number.
+ *
+ * Return: The index of the node, or 0 after a syntax error.
+ */
+uint32_t arith_primary(arith_parser_t *ap)
+{
+	const char *p = arith_skip(ap), *q;
+	uint32_t i;
+
+	if (p < ap->end && (*p == '-' || *p == '+' || *p == '!' || *p == '~'))
+	{
+		ap->p++;
+		i = arith_primary(ap);
+		return (*p == '+' ? i : arith_node(ap, *p == '-' ? ARITH_NEG :
+			*p == '!' ? ARITH_NOT : ARITH_BNOT, i, 0));
+	}
+	if (p < ap->end && *p == '(')
+	{
+		ap->p++;
+		i = arith_expr(ap);
+		if (arith_skip(ap) == ap->end || *ap->p != ')')
+			ap->error = ap->error ? ap->error : "expecting ')'";
+		ap->p += ap->p < ap->end;
+		return (i);
+	}
+	if (p < ap->end && isdigit((unsigned char)*p))
+		return (arith_number(ap, p));
+	q = arith_name_end(p, ap->end);
+	if (q == p)
+	{
+		ap->error = ap->error ? ap->error : "expecting primary";
+		return (0);
+	}
+	ap->p = q;
+	i = arith_node(ap, ARITH_VAR, 0, 0);
+	ap->expr->nodes[i].name = (uint32_t)(p - ap->expr->text);
+	ap->expr->nodes[i].len = (uint32_t)(q - p);
+	return (i);
+}
+
+/**
+ * arith_binary - Parse operands joined by binary operators
+ * @ap: The parser
+ * @min_prec: The lowest precedence of the operators to take, from 1 for
+ * "||" to 10 for '*', '/' and '%'
+ *
+ * Description: This is precedence climbing: an operator is taken while it
+ * binds at least as tightly as @min_prec, and its right operand is parsed
+ * with a higher minimum, which makes the operators left-associative. An
+ * operator followed by '=' is an assignment and ends the operand.
+ *
+ * Return: The index of the node, or 0 after a syntax error.
+ */
+uint32_t arith_binary(arith_parser_t *ap, int min_prec)
+{
+	uint32_t left = arith_primary(ap), right;
+	const char *p;
+	size_t len = 0;
+	int k;
+
+	while (ap->error == NULL)
+	{
+		p = arith_skip(ap);
+		for (k = 0; binary_ops[k] != NULL; k++)
+		{
+			len = strlen(binary_ops[k]);
+			if ((size_t)(ap->end - p) >= len &&
+			    memcmp(p, binary_ops[k], len) == 0)
+				break;
+		}
+		if (binary_ops[k] == NULL || binary_precs[k] < min_prec ||
+		    (p + len < ap->end && p[len] == '=' &&
+		     binary_ops[k][len - 1] != '='))
+			break;
+		ap->p = p + len;
+		right = arith_binary(ap, binary_precs[k] + 1);
+		left = arith_node(ap, binary_codes[k], left, right);
+	}
+	return (left);
+}
+
+/**
+ * arith_expr - Parse an assignment or a conditional expression
+ * @ap: The parser
+ *
+ * Description: A name followed by '=' or by an operator and '=' is an
+ * assignment, whose value is the rest of the expression. Otherwise the
+ * binary operators are parsed, and a '?' after them starts the two
+ * branches of a conditional, which are full expressions.
+ *
+ * Return: The index of the node, or 0 after a syntax error.
+ */
+uint32_t arith_expr(arith_parser_t *ap)
+{
+	const char *p = arith_skip(ap), *q = arith_name_end(p, ap->end);
+	uint32_t i, a, b;
+	int sub = -1, len = 0;
+
+	ap->p = q;
+	arith_skip(ap);
+	if (q > p)
+		sub = arith_assign_op(ap, &len);
+	if (sub != -1)
+	{
+		ap->p += len;
+		i = arith_node(ap, ARITH_ASSIGN, arith_expr(ap), 0);
+		ap->expr->nodes[i].sub = sub;
+		ap->expr->nodes[i].name = (uint32_t)(p - ap->expr->text);
+		ap->expr->nodes[i].len = (uint32_t)(q - p);
+		return (i);
+	}
+	ap->p = p;
+	i = arith_binary(ap, 1);
+	if (ap->error != NULL || arith_skip(ap) == ap->end || *ap->p != '?')
+		return (i);
+	ap->p++;
+	a = arith_expr(ap);
+	if (ap->error == NULL && (arith_skip(ap) == ap->end || *ap->p != ':'))
+		ap->error = "expecting ':'";
+	ap->p += ap->p < ap->end;
+	b = arith_expr(ap);
+	i = arith_node(ap, ARITH_COND, i, a);
+	ap->expr->nodes[i].c = b;
+	return (i);
+}
@@ -0,0 +1,152 @@
+#include "main.h"
+
+/* The texts of arrays that changed while pointers to them were in use */
+static array_retired_t *array_retired;
+
+/**
+ * array_sweep - Free the retired texts no pointer can reach any more
+ *
+ * Return: None.
+ */
+static void array_sweep(void)
+{
+	array_retired_t **r = &array_retired, *dead;
+	size_t pos = arena_pos();
+
+	while (*r != NULL)
+	{
+		if (pos >= (*r)->pos)
+		{
+			r = &(*r)->next;
+			continue;
+		}
+		dead = *r;
+		*r = dead->next;
+		free(dead->text);
+		free(dead);
+	}
+}
+
+/**
+ * array_retire - Keep the text of an array until nothing points into it
+ * @text: The text, which the array no longer uses
+ * @pos: Position of the arena when its elements were handed out
+ *
+ * Description: The pointers "${a[@]}" hands out live in the fields of a
+ * command, or of a for loop, which are released with the arena, so the
+ * text is freed once the arena is rewound below @pos.
+ *
+ * Return: None.
+ */
+void array_retire(char *text, size_t pos)
+{
+	array_retired_t *r = malloc(sizeof(*r));
+
+	if (r == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	array_sweep();
+	r->text = text;
+	r->pos = pos;
+	r->next = array_retired;
+	array_retired = r;
+}
+
+/**
+ * array_compact - Copy the elements of an array into a new text
+ * @a: The array
+ * @extra: The number of bytes to leave free at the end of the new text
+ *
+ * Description: The elements are copied in the order of their indexes,
+ * without the bytes overwritten elements left. The old text is freed, or
+ * retired while pointers into it may still be in use.
+ *
+ * Return: None.
+ */
+void array_compact(array_t *a, size_t extra)
+{
+	size_t cap = 64, used = 0, i, len;
+	char *text;
+
+	while (cap < a->used - a->garbage + extra)
+		cap *= 2;
+	text = malloc(cap);
+	if (text == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < a->n; i++)
+	{
+		if (a->offs[i] == ARRAY_UNSET)
+			continue;
+		len = strlen(a->text + a->offs[i]) + 1;
+		memcpy(text + used, a->text + a->offs[i], len);
+		a->offs[i] = used;
+		used += len;
+	}
+	if (a->shared)
+		array_retire(a->text, a->shared_at);
+	else
+		free(a->text);
+	a->text = text;
+	a->cap = cap;
+	a->used = used;
+	a->garbage = 0;
+	a->shared = 0;
+}
+
+/**
+ * array_own - Make the text of an array its own before it changes
+ * @a: The array
+ *
+ * Description: Once the arena is rewound below the position where
+ * "${a[@]}" handed out pointers into the text, the commands that had them
+ * are done and the text can change in place. Until then, a change copies
+ * the text first, so a function or a loop body that changes the array
+ * does not change the arguments it was given.
+ *
+ * Return: None.
+ */
+void array_own(array_t *a)
+{
+	if (array_retired != NULL)
+		array_sweep();
+	if (a->shared && arena_pos() < a->shared_at)
+		a->shared = 0;
+	if (a->shared)
+		array_compact(a, 0);
+}
+
+/**
+ * array_copy - Copy an array
+ * @a: The array
+ *
+ * Return: The copy, to free with array_free.
+ */
+array_t *array_copy(const array_t *a)
+{
+	array_t *copy = array_new();
+
+	copy->text = malloc(a->cap ? a->cap : 1);
+	copy->offs = malloc((a->ncap ? a->ncap : 1) * sizeof(*copy->offs));
+	if (copy->text == NULL || copy->offs == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	if (a->n > 0)
+	{
+		memcpy(copy->text, a->text, a->used);
+		memcpy(copy->offs, a->offs, a->n * sizeof(*copy->offs));
+	}
+	copy->used = a->used;
+	copy->cap = a->cap;
+	copy->n = a->n;
+	copy->ncap = a->ncap;
+	copy->count = a->count;
+	copy->garbage = a->garbage;
+	return (copy);
+}
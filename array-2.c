@@ -0,0 +1,129 @@
+#include "main.h"
+
+/**
+ * array_clear - Remove all the elements of an array
+ * @a: The array
+ *
+ * Description: The text is kept for the next elements, unless pointers
+ * into it may still be in use, in which case it is retired.
+ *
+ * Return: None.
+ */
+void array_clear(array_t *a)
+{
+	if (a->shared && arena_pos() >= a->shared_at)
+	{
+		array_retire(a->text, a->shared_at);
+		a->text = NULL;
+		a->cap = 0;
+	}
+	a->shared = 0;
+	a->used = 0;
+	a->n = 0;
+	a->count = 0;
+	a->garbage = 0;
+}
+
+/**
+ * array_list - List the elements of an array
+ * @a: The array
+ * @share: Non-zero if the pointers are handed out for as long as the
+ * command that expands them runs, rather than copied at once
+ *
+ * Description: The list points into the text of the array, so it costs
+ * one pointer per element whatever their length. A shared text is copied
+ * before the array changes, until the arena is rewound below the list.
+ *
+ * Return: The NULL-terminated list of the elements, in the order of their
+ * indexes, in the arena.
+ */
+char **array_list(array_t *a, int share)
+{
+	size_t top = arena_pos(), i, n = 0;
+	char **list = arena_alloc((a->count + 1) * sizeof(*list));
+
+	for (i = 0; i < a->n; i++)
+	{
+		if (a->offs[i] != ARRAY_UNSET)
+			list[n++] = a->text + a->offs[i];
+	}
+	list[n] = NULL;
+	if (share && (!a->shared || top < a->shared_at))
+		a->shared_at = arena_pos();
+	a->shared |= share != 0;
+	return (list);
+}
+
+/**
+ * var_array - Get the elements of a variable to change them
+ * @v: The variable, which becomes an array if it is not one; the value
+ * of a plain variable becomes its element 0
+ *
+ * Description: Inside a subshell run without forking, the variable is
+ * saved first, like var_assign does.
+ *
+ * Return: The array.
+ */
+array_t *var_array(var_t *v)
+{
+	if (var_journal != NULL && v->journal != var_journal->serial)
+		var_journal_note(v);
+	if (v->array != NULL)
+		return (v->array);
+	v->array = array_new();
+	if (!(v->flags & VAR_UNSET))
+		array_set(v->array, 0, v->str + v->name_len + 1,
+			  strlen(v->str + v->name_len + 1));
+	if ((v->flags & (VAR_EXPORT | VAR_UNSET)) == VAR_EXPORT)
+		var_table.env_dirty = 1;
+	v->flags = VAR_UNSET;
+	return (v->array);
+}
+
+/**
+ * exp_index - Evaluate the subscript of an array
+ * @ex: The expansion, for error messages
+ * @name: The name of the array, followed by the subscript in brackets
+ * @end: The position after the closing bracket
+ * @a: The array, or NULL if there is none
+ * @index: Set to the index
+ *
+ * Description: The subscript is an arithmetic expression, cached by its
+ * text unless it holds an expansion or a quote, as in "$((...))". A
+ * negative index counts back from the end of the array.
+ *
+ * Return: 0 on success, -1 after reporting an error.
+ */
+int exp_index(expand_t *ex, const char *name, const char *end,
+	      const array_t *a, long *index)
+{
+	const char *start = _strchr(name, '[') + 1, *q;
+	arith_t *e = NULL;
+	char *text;
+	int64_t value = -1;
+
+	for (q = start; q < end - 1 && (unsigned char)*q > CTL_SQ &&
+	     _strchr("$`'\"\\", *q) == NULL; q++)
+		;
+	if (q == end - 1 && q > start)
+		e = arith_find(ex, start, (size_t)(q - start));
+	else if (start < end - 1)
+	{
+		text = exp_sub(ex, EXP_STRING, start, end - 1, 1);
+		if (text != NULL)
+			e = arith_parse(ex, text, strlen(text));
+	}
+	if (e != NULL && arith_eval(ex, e, e->root, &value) == 0 &&
+	    value < 0 && a != NULL)
+		value += (int64_t)a->n;
+	if (e != NULL && q != end - 1)
+		arith_free(e);
+	if (!ex->error && (value < 0 || value > ARRAY_INDEX_MAX))
+	{
+		fprintf(stderr, "%s: %d: %.*s: bad array subscript\n",
+			ex->program_name, ex->line, (int)(end - name), name);
+		ex->error = 1;
+	}
+	*index = (long)value;
+	return (ex->error ? -1 : 0);
+}
@@ -0,0 +1,127 @@
+#include "main.h"
+
+/**
+ * exp_elements - List the elements of a variable for "${name[@]}"
+ * @v: The variable, or NULL if there is none
+ * @share: Non-zero to hand out the elements of an array, see array_list
+ * @n: Set to the number of elements
+ *
+ * Description: A plain variable that is set is an array of one element.
+ *
+ * Return: The NULL-terminated list, in the arena.
+ */
+static char **exp_elements(var_t *v, int share, int *n)
+{
+	char **list;
+
+	if (v != NULL && v->array != NULL)
+	{
+		*n = (int)v->array->count;
+		return (array_list(v->array, share));
+	}
+	list = arena_alloc(2 * sizeof(*list));
+	list[0] = NULL;
+	if (v != NULL && !(v->flags & VAR_UNSET))
+		list[0] = v->str + v->name_len + 1;
+	list[1] = NULL;
+	*n = list[0] != NULL;
+	return (list);
+}
+
+/**
+ * exp_array_all - Expand "${name[@]}", "${name[*]}" or their length
+ * @ex: The expansion
+ * @v: The variable, or NULL if there is none
+ * @c: '@' or '*'
+ * @length: Non-zero for the number of elements
+ * @dq: 0 outside double quotes, 1 inside, 2 if the substitution is also
+ * the whole word
+ *
+ * Description: The elements expand like the positional parameters do.
+ * When "${name[@]}" is a whole word, the fields are the elements of the
+ * array themselves, not copies, so a long array is passed to a command
+ * as pointers only, down to execve.
+ *
+ * Return: None.
+ */
+static void exp_array_all(expand_t *ex, var_t *v, char c, int length,
+			  int dq)
+{
+	int share = dq == 2 && !length && c == '@' && ex->mode == EXP_FIELDS &&
+		    !ex->started && ex->len == 0 && v != NULL &&
+		    v->array != NULL, n, i;
+	char **list = exp_elements(v, share, &n), num[24];
+
+	if (length)
+	{
+		snprintf(num, sizeof(num), "%d", n);
+		exp_put(ex, num, strlen(num), dq ? PUT_QUOTED : PUT_EXPANDED);
+	}
+	else if (share)
+	{
+		for (i = 0; i < n; i++)
+			fields_add(ex->out, list[i]);
+		ex->suppress = 1;
+	}
+	else
+		exp_args(ex, list, n, c, dq);
+}
+
+/**
+ * exp_array - Expand a "${name[subscript]}" substitution
+ * @ex: The expansion
+ * @p: The '$'
+ * @stop: The position after the closing brace
+ * @end: End of the text
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: The subscript '@' or '*' stands for all the elements, any
+ * other is the arithmetic expression of an index. A plain variable is an
+ * array whose only element is its value, at index 0. "${#name[...]}"
+ * is the number of elements or the length of one. The operators of the
+ * other substitutions do not apply to arrays.
+ *
+ * Return: None.
+ */
+void exp_array(expand_t *ex, const char *p, const char *stop,
+	       const char *end, int dq)
+{
+	const char *name = p + 2 + (p[2] == '#'), *sub, *q, *value = NULL;
+	var_t *v;
+	long index;
+	char num[24];
+
+	for (sub = name; *sub == '_' || isalnum((unsigned char)*sub); sub++)
+		;
+	for (q = ++sub; q < stop - 1 && *q != ']'; q++)
+		;
+	if (q + 2 != stop || q == sub)
+	{
+		exp_bad(ex);
+		return;
+	}
+	v = var_lookup(name, (size_t)(sub - 1 - name), 0);
+	if (q == sub + 1 && (*sub == '@' || *sub == '*'))
+	{
+		if (dq && stop + 1 == end && *stop == CTL_DQ)
+			dq = 2;
+		exp_array_all(ex, v, *sub, p[2] == '#', dq);
+		return;
+	}
+	if (exp_index(ex, name, q + 1, v != NULL ? v->array : NULL,
+		      &index) == -1)
+		return;
+	if (v != NULL && v->array != NULL)
+		value = array_get(v->array, index);
+	else if (v != NULL && !(v->flags & VAR_UNSET) && index == 0)
+		value = v->str + v->name_len + 1;
+	if (p[2] == '#')
+	{
+		snprintf(num, sizeof(num), "%lu", (unsigned long)
+			 (value != NULL ? strlen(value) : 0));
+		value = num;
+	}
+	if (value != NULL)
+		exp_put(ex, value, strlen(value), dq ? PUT_QUOTED :
+			PUT_EXPANDED);
+}
@@ -0,0 +1,134 @@
+#include "main.h"
+
+/**
+ * array_new - Create an empty array
+ *
+ * Return: The array, to free with array_free.
+ */
+array_t *array_new(void)
+{
+	array_t *a = calloc(1, sizeof(*a));
+
+	if (a == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	return (a);
+}
+
+/**
+ * array_free - Free an array
+ * @a: The array, or NULL
+ *
+ * Return: None.
+ */
+void array_free(array_t *a)
+{
+	if (a == NULL)
+		return;
+	array_clear(a);
+	free(a->text);
+	free(a->offs);
+	free(a);
+}
+
+/**
+ * array_text - Make room at the end of the text of an array
+ * @a: The array, whose text is its own, see array_own
+ * @need: The number of bytes to add
+ *
+ * Description: The text doubles when it is full, unless more than half
+ * of it is left by elements overwritten, in which case it is compacted
+ * instead. The elements are found by their offsets, so the text can move.
+ *
+ * Return: None.
+ */
+static void array_text(array_t *a, size_t need)
+{
+	size_t cap = a->cap ? a->cap : 64;
+	char *text;
+
+	if (a->used + need <= a->cap)
+		return;
+	if (a->garbage > a->used / 2)
+	{
+		array_compact(a, need);
+		return;
+	}
+	while (cap < a->used + need)
+		cap *= 2;
+	text = realloc(a->text, cap);
+	if (text == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	a->text = text;
+	a->cap = cap;
+}
+
+/**
+ * array_set - Set an element of an array
+ * @a: The array
+ * @index: The index, from 0 to ARRAY_INDEX_MAX
+ * @value: The value, which must not point into the array
+ * @len: The length of the value, which does not need to be terminated
+ *
+ * Description: A value that fits where the element was is written over
+ * it; any other is added at the end of the text.
+ *
+ * Return: None.
+ */
+void array_set(array_t *a, long index, const char *value, size_t len)
+{
+	size_t i = (size_t)index, old = 0, *offs;
+
+	array_own(a);
+	if (i >= a->ncap)
+	{
+		a->ncap = a->ncap ? a->ncap : 16;
+		while (a->ncap <= i)
+			a->ncap *= 2;
+		offs = realloc(a->offs, a->ncap * sizeof(*offs));
+		if (offs == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		a->offs = offs;
+	}
+	for (; a->n <= i; a->n++)
+		a->offs[a->n] = ARRAY_UNSET;
+	if (a->offs[i] != ARRAY_UNSET)
+		old = strlen(a->text + a->offs[i]) + 1;
+	a->count += old == 0;
+	if (old > len)
+	{
+		memcpy(a->text + a->offs[i], value, len);
+		a->text[a->offs[i] + len] = '\0';
+		a->garbage += old - len - 1;
+		return;
+	}
+	array_text(a, len + 1);
+	a->garbage += old;
+	memcpy(a->text + a->used, value, len);
+	a->text[a->used + len] = '\0';
+	a->offs[i] = a->used;
+	a->used += len + 1;
+}
+
+/**
+ * array_get - Get an element of an array
+ * @a: The array
+ * @index: The index
+ *
+ * Return: The element, or NULL if the array has none at @index.
+ */
+char *array_get(const array_t *a, long index)
+{
+	if (index < 0 || (size_t)index >= a->n ||
+	    a->offs[index] == ARRAY_UNSET)
+		return (NULL);
+	return (a->text + a->offs[index]);
+}
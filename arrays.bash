@@ -0,0 +1,119 @@
+#!/bin/bash
+
+################################################################################
+# Description for the intranet check (one line, support Markdown syntax)
+# Indexed arrays, "${a[@]}" and mapfile
+
+################################################################################
+# The variable 'compare_with_sh' IS OPTIONNAL
+#
+# Uncomment the following line if you don't want the output of the shell
+# to be compared against the output of /bin/sh
+#
+# It can be useful when you want to check a builtin command that sh doesn't
+# implement
+compare_with_sh=0
+
+################################################################################
+# The variable 'shell_input' HAS TO BE DEFINED
+#
+# The content of this variable will be piped to the student's shell and to sh
+# as follows: "echo $shell_input | ./hsh"
+#
+# It can be empty and multiline
+shell_input="a[0]=zero
+a[2]=\\\\\"two words\\\\\"
+a[5]=five
+echo \\\\\"\\\\\${#a[@]}\\\\\" \\\\\"\\\\\${a[2]}\\\\\" \\\\\"[\\\\\${a[1]}]\\\\\" \\\\\"\\\\\${a[-1]}\\\\\" \\\\\"\\\\\$a\\\\\"
+for x in \\\\\"\\\\\${a[@]}\\\\\"; do echo \\\\\"<\\\\\$x>\\\\\"; done
+echo \\\\\${a[@]} \\\\\"\\\\\${a[*]}\\\\\"
+i=1
+a[i+1]=again
+a[\\\\\$i]=one
+b=scalar
+b[1]=second
+echo \\\\\"\\\\\${a[@]}\\\\\" \\\\\"\\\\\${#a[2]}\\\\\" \\\\\"\\\\\${b[@]}\\\\\"
+f() { a[0]=changed; echo \\\\\"\\\\\$#: \\\\\$1\\\\\"; }
+f \\\\\"\\\\\${a[@]}\\\\\"
+echo \\\\\"\\\\\${a[@]}\\\\\"
+printf '%s|' \\\\\"x\\\\\${a[@]}y\\\\\" \\\\\"\\\\\${e[@]}\\\\\"; echo
+printf 'l1\\\\\\\\nl2\\\\\\\\n\\\\\\\\nl4' > /tmp/.hsh_mapfile
+mapfile -t m < /tmp/.hsh_mapfile
+printf '[%s]' \\\\\"\\\\\${m[@]}\\\\\"; echo \\\\\" \\\\\${#m[@]}\\\\\""
+
+################################################################################
+# The variable 'shell_params' IS OPTIONNAL
+#
+# The content of this variable will be passed to as the paramaters array to the
+# shell as follows: "./hsh $shell_params"
+#
+# It can be empty
+# shell_params=""
+
+################################################################################
+# The function 'check_setup' will be called BEFORE the execution of the shell
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function check_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function 'sh_setup' will be called AFTER the execution of the students
+# shell, and BEFORE the execution of the real shell (sh)
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function sh_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function `check_callback` will be called AFTER the execution of the shell
+# It allows you to clear VARIABLES, cleanup files, ...
+#
+# It is also possible to perform additionnal checks.
+# Here is a list of available variables:
+# STATUS -> Path to the file containing the exit status of the shell
+# OUTPUTFILE -> Path to the file containing the stdout of the shell
+# ERROR_OUTPUTFILE -> Path to the file containing the stderr of the shell
+# EXPECTED_STATUS -> Path to the file containing the exit status of sh
+# EXPECTED_OUTPUTFILE -> Path to the file containing the stdout of sh
+# EXPECTED_ERROR_OUTPUTFILE -> Path to the file continaing the stderr of sh
+#
+# Parameters:
+#     $1 -> Status of the comparison with sh
+#             0 -> The output is the same as sh
+#             1 -> The output differs from sh
+#
+# Return value:
+#     0  -> Check succeed
+#     1  -> Check fails
+function check_callback()
+{
+	let status=0
+
+	$ECHO -n "" > $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '3 two words [] five zero' > $EXPECTED_OUTPUTFILE
+	$ECHO '<zero>' >> $EXPECTED_OUTPUTFILE
+	$ECHO '<two words>' >> $EXPECTED_OUTPUTFILE
+	$ECHO '<five>' >> $EXPECTED_OUTPUTFILE
+	$ECHO 'zero two words five zero two words five' >> $EXPECTED_OUTPUTFILE
+	$ECHO 'zero one again five 5 scalar second' >> $EXPECTED_OUTPUTFILE
+	$ECHO '4: zero' >> $EXPECTED_OUTPUTFILE
+	$ECHO 'changed one again five' >> $EXPECTED_OUTPUTFILE
+	$ECHO 'xchanged|one|again|fivey|' >> $EXPECTED_OUTPUTFILE
+	$ECHO '[l1][l2][][l4] 4' >> $EXPECTED_OUTPUTFILE
+	$ECHO -n "0" > $EXPECTED_STATUS
+
+	check_diff
+
+	return $status
+}
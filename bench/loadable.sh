@@ -0,0 +1,28 @@
+#!/bin/sh
+# Compare a builtin loaded with 'enable -f' with the external program it
+# stands for.
+#
+# Usage: bench/loadable.sh [CALLS]
+#
+# The example module loadables/basename.c is built into a shared object.
+# hsh then runs basename in a loop, first as the program found in PATH,
+# forked and executed for every call, then as the loaded builtin.
+
+calls=${1:-20000}
+hsh=${HSH:-./hsh}
+so=$(mktemp /tmp/hsh_bench.XXXXXX)
+script=$(mktemp /tmp/hsh_bench.XXXXXX)
+
+${CC:-gcc} -O2 -shared -fPIC -o "$so" loadables/basename.c || exit 1
+for load in "" "enable -f $so basename"; do
+	printf '%s\ni=0\nwhile [ $i -lt %d ]; do\n%s\n%s\ndone\n' "$load" \
+		"$calls" "basename /usr/lib/libhsh.so .so > /dev/null" \
+		"i=\$((i + 1))" > "$script"
+	start=$(date +%s%N)
+	$hsh "$script" || echo "$hsh: failed"
+	end=$(date +%s%N)
+	how="basename in PATH"
+	[ -n "$load" ] && how="loaded basename"
+	echo "$how: $calls calls, $(( (end - start) / 1000000 )) ms"
+done
+rm -f "$so" "$script"
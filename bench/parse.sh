@@ -0,0 +1,49 @@
+#!/bin/sh
+# Compare the parsing speed of hsh with dash on a large generated script.
+#
+# Usage: bench/parse.sh [LINES]
+#
+# Both shells run the script with -n, which parses every command without
+# executing it. The compiled-script cache of hsh is disabled so that the
+# script is really parsed on every run.
+#
+# hsh is built from the sources with CFLAGS, by default the flags of the
+# documented build, which does not optimize; the result depends on them,
+# so they are printed with it. Set HSH to time an existing binary instead.
+
+lines=${1:-200000}
+cflags=${CFLAGS:--Wall -Werror -Wextra -pedantic -std=gnu89}
+script=$(mktemp /tmp/hsh_bench.XXXXXX)
+if [ -n "$HSH" ]; then
+	hsh=$HSH
+	echo "hsh: $hsh, build flags unknown"
+else
+	hsh=$(mktemp /tmp/hsh_bench.XXXXXX)
+	${CC:-gcc} $cflags *.c -o "$hsh" || exit 1
+	echo "hsh: built with ${CC:-gcc} $cflags"
+fi
+
+awk -v n="$lines" 'BEGIN {
+	for (i = 0; i < n; i++) {
+		if (i % 4 == 0)
+			printf "echo \"line %d\" '\''single quoted'\'' a\\ b # comment\n", i
+		else if (i % 4 == 1)
+			printf "test -f /etc/passwd && cat /etc/passwd || echo missing\n"
+		else if (i % 4 == 2)
+			printf "printf \"%%s\\n\" one two three; true ; ! false\n"
+		else
+			printf "ls -l \"$HOME\" /tmp /var/log \\\n\t/usr/bin\n"
+	}
+}' > "$script"
+
+echo "$(wc -l < "$script") lines, $(wc -c < "$script") bytes"
+for sh in dash "$hsh"; do
+	start=$(date +%s%N)
+	HSH_CACHE=0 $sh -n "$script" || echo "$sh: failed"
+	end=$(date +%s%N)
+	name=$sh
+	[ "$sh" = "$hsh" ] && name=hsh
+	echo "$name -n: $(( (end - start) / 1000000 )) ms"
+done
+rm -f "$script"
+[ -n "$HSH" ] || rm -f "$hsh"
@@ -0,0 +1,112 @@
+#include "main.h"
+
+static const builtin_t builtins[] = {
+	{"exit", builtin_exit},
+	{"env", builtin_env},
+	{"setenv", builtin_setenv},
+	{"unsetenv", builtin_unsetenv},
+	{"timeout", builtin_timeout},
+	{"pin", builtin_pin},
+	{"sched", builtin_sched},
+	{"time", builtin_time},
+	{"break", builtin_break},
+	{"continue", builtin_continue},
+	{"return", builtin_return},
+	{"shift", builtin_shift},
+	{"echo", builtin_echo},
+	{"printf", builtin_printf},
+	{"true", builtin_true},
+	{"false", builtin_false},
+	{":", builtin_true},
+	{"test", builtin_test},
+	{"[", builtin_test},
+	{"cat", builtin_cat},
+	{"read", builtin_read},
+	{"mapfile", builtin_mapfile},
+	{"sleep", builtin_sleep},
+	{"kill", builtin_kill},
+	{"cd", builtin_cd},
+	{"pwd", builtin_pwd},
+	{".", builtin_source},
+	{"source", builtin_source},
+	{"alias", builtin_alias},
+	{"unalias", builtin_unalias},
+	{"enable", builtin_enable},
+	{NULL, NULL}
+};
+
+/**
+ * builtins_register - Enter the builtins in the command table
+ *
+ * Description: The table of builtins is a static array terminated by an
+ * entry with a NULL name. Every builtin in the table takes the same
+ * arguments as dispatch_command and returns the exit status of the command,
+ * so new builtins only need a new line in the table. The shell calls this
+ * once at startup, after which builtins are found with a hash lookup.
+ *
+ * Return: None.
+ */
+void builtins_register(void)
+{
+	int i;
+
+	for (i = 0; builtins[i].name != NULL; i++)
+		cmd_lookup(builtins[i].name, 1)->builtin = &builtins[i];
+}
+
+/**
+ * builtin_env - Builtin wrapper around execute_env
+ * @tokens: The command and its arguments (unused)
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Return: Always 0.
+ */
+int builtin_env(char **tokens, int line_number, char *program_name)
+{
+	(void)tokens;
+	(void)line_number;
+	(void)program_name;
+
+	execute_env();
+	return (0);
+}
+
+/**
+ * builtin_setenv - Builtin wrapper around _setenv
+ * @tokens: The command, the variable name and its value
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Description: The value is only read when a name was given, so a bare
+ * 'setenv' never looks past the end of the token array.
+ *
+ * Return: 0 on success, 1 if the variable could not be set.
+ */
+int builtin_setenv(char **tokens, int line_number, char *program_name)
+{
+	char *value = NULL;
+
+	(void)line_number;
+	(void)program_name;
+
+	if (tokens[1] != NULL)
+		value = tokens[2];
+	return (_setenv(tokens[1], value) == 0 ? 0 : 1);
+}
+
+/**
+ * builtin_unsetenv - Builtin wrapper around _unsetenv
+ * @tokens: The command and the name of the variable to remove
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Return: 0 on success, 1 if the variable could not be removed.
+ */
+int builtin_unsetenv(char **tokens, int line_number, char *program_name)
+{
+	(void)line_number;
+	(void)program_name;
+
+	return (_unsetenv(tokens[1]) == 0 ? 0 : 1);
+}
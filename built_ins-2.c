@@ -0,0 +1,92 @@
+#include "main.h"
+
+/**
+ * loop_builtin - Record a 'break' or 'continue' request
+ * @tokens: The command and its optional loop count
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ * @request: LOOP_BREAK or LOOP_CONTINUE
+ *
+ * Description: The count must be a positive integer; like other errors of
+ * special builtins, an invalid count makes a non-interactive shell exit.
+ * The request itself is carried out by run_program once the builtin has
+ * returned.
+ *
+ * Return: 0 on success, 2 if the count is not valid.
+ */
+static int loop_builtin(char **tokens, int line_number, char *program_name,
+			int request)
+{
+	unsigned long levels = 1;
+	char *end = NULL;
+
+	if (tokens[1] != NULL)
+	{
+		errno = 0;
+		levels = isdigit((unsigned char)tokens[1][0]) ?
+			strtoul(tokens[1], &end, 10) : 0;
+		if (levels == 0 || errno != 0 || *end != '\0')
+		{
+			fprintf(stderr, "%s: %d: %s: Illegal number: %s\n",
+				program_name, line_number, tokens[0],
+				tokens[1]);
+			if (!interactive)
+				exit_requested = 1;
+			return (2);
+		}
+	}
+	loop_request = request;
+	loop_levels = levels > UINT_MAX ? UINT_MAX : (unsigned int)levels;
+	return (0);
+}
+
+/**
+ * builtin_break - Leave the innermost loops
+ * @tokens: The command and the optional number of loops to leave
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Return: 0 on success, 2 if the count is not valid.
+ */
+int builtin_break(char **tokens, int line_number, char *program_name)
+{
+	return (loop_builtin(tokens, line_number, program_name, LOOP_BREAK));
+}
+
+/**
+ * builtin_continue - Start the next iteration of an enclosing loop
+ * @tokens: The command and the optional number of the loop to continue,
+ * counted from the innermost
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Return: 0 on success, 2 if the count is not valid.
+ */
+int builtin_continue(char **tokens, int line_number, char *program_name)
+{
+	return (loop_builtin(tokens, line_number, program_name, LOOP_CONTINUE));
+}
+
+/**
+ * builtin_flush - Write out what a builtin left in the standard output
+ * @name: The name of the builtin
+ * @line_number: Line number of the command, for the error message
+ * @program_name: Name of the shell program, for the error message
+ *
+ * Description: Builtins write to the buffer of the standard output, so an
+ * error writing it, to a full disk or a closed pipe, only shows when it is
+ * flushed, or in the error flag of the stream if the buffer filled up
+ * before. It is reported as /bin/sh does, and the flag is cleared so the
+ * next command starts clean.
+ *
+ * Return: 0 on success, -1 if the output could not be written.
+ */
+int builtin_flush(const char *name, int line_number, char *program_name)
+{
+	if (fflush(stdout) != EOF && !ferror(stdout))
+		return (0);
+	fprintf(stderr, "%s: %d: %s: %s: I/O error\n", program_name,
+		line_number, name, name);
+	clearerr(stdout);
+	return (-1);
+}
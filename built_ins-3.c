@@ -0,0 +1,104 @@
+#include "main.h"
+
+/**
+ * builtin_return - Return from a function
+ * @tokens: The command and the optional status to return
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: Like 'break', the builtin only records the request, in
+ * loop_request, and run_program stops the function's body. Outside of a
+ * function, a non-interactive shell stops reading commands, as /bin/sh
+ * does at the top level of a script.
+ *
+ * Return: The status given as argument, or the last status.
+ */
+int builtin_return(char **tokens, int line_number, char *program_name)
+{
+	int status = last_status;
+
+	if (tokens[1] != NULL)
+	{
+		if (!isdigit((unsigned char)tokens[1][0]))
+		{
+			fprintf(stderr, "%s: %d: return: Illegal number: %s\n",
+				program_name, line_number, tokens[1]);
+			status = 2;
+		}
+		else
+			status = atoi(tokens[1]) & 255;
+	}
+	if (func_depth > 0)
+		loop_request = LOOP_RETURN;
+	else if (!interactive)
+		exit_requested = 1;
+	return (status);
+}
+
+/**
+ * builtin_shift - Shift the positional parameters
+ * @tokens: The command and the optional number of parameters to drop
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: Shifting only moves the start of the current parameter
+ * frame, so it costs the same however many parameters there are.
+ *
+ * Return: 0 on success, 2 if there are fewer parameters than asked for.
+ */
+int builtin_shift(char **tokens, int line_number, char *program_name)
+{
+	int n = 1, count = params != NULL ? params->argc : 0;
+
+	if (tokens[1] != NULL)
+		n = isdigit((unsigned char)tokens[1][0]) ? atoi(tokens[1]) : -1;
+	if (n < 0 || n > count)
+	{
+		fprintf(stderr, "%s: %d: shift: can't shift that many\n",
+			program_name, line_number);
+		if (!interactive)
+			exit_requested = 1;
+		return (2);
+	}
+	if (n > 0)
+	{
+		params->argv += n;
+		params->argc -= n;
+	}
+	return (0);
+}
+
+/**
+ * builtin_true - Do nothing, successfully
+ * @tokens: The command and its arguments (unused)
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Description: Also the ':' special builtin, whose arguments are still
+ * expanded, so ': ${x:=value}' assigns without running a program.
+ *
+ * Return: Always 0.
+ */
+int builtin_true(char **tokens, int line_number, char *program_name)
+{
+	(void)tokens;
+	(void)line_number;
+	(void)program_name;
+	return (0);
+}
+
+/**
+ * builtin_false - Do nothing, unsuccessfully
+ * @tokens: The command and its arguments (unused)
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Return: Always 1.
+ */
+int builtin_false(char **tokens, int line_number, char *program_name)
+{
+	(void)tokens;
+	(void)line_number;
+	(void)program_name;
+	return (1);
+}
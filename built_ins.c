@@ -1,23 +1,5 @@
 #include "main.h"
 
-/**
- * execute_echo_path - Execute the 'echo $PATH' command
- *
- * Description: This function retrieves the value of the environment variable
- * 'PATH' using the `getenv` function. It then prints the value of 'PATH'
- * to the standard output, followed by a newline character. The function is
- * designed to mimic the behavior of the 'echo $PATH' command in a shell.
- *
- * Return: This function does not return a value.
- */
-void execute_echo_path(void)
-{
-	char *path = _getenv("PATH");
-
-	_write(path);
-	_write("\n");
-}
-
 /**
  * execute_exit - Execute the 'exit' command
  * @argument: The argument provided to the 'exit' command
@@ -30,14 +12,15 @@ void execute_echo_path(void)
  * provided, the status code is 0, indicating successful termination. If the
  * argument is a valid integer, it is converted to an integer and used as the
  * status code. If the argument is not a valid integer, an error message is
- * printed to the standard error, and the status code is set to 2. The function
- * returns the status code.
+ * printed to the standard error, and the status code is set to 2. Without an
+ * argument the status of the last executed command is used, as POSIX
+ * requires. The function returns the status code.
  *
  * Return: The status code for the program.
  */
 int execute_exit(char *argument, int line_number, char *program_name)
 {
-	int status = 0;
+	int status = last_status;
 
 	if (argument == NULL)
 	{
@@ -58,3 +41,21 @@ int execute_exit(char *argument, int line_number, char *program_name)
 	}
 	return (status);
 }
+
+/**
+ * builtin_exit - Builtin wrapper around execute_exit
+ * @tokens: The command and its optional status argument
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The shell does not exit from inside the builtin. It sets
+ * exit_requested, so run_program stops and the input loops return, and the
+ * shell then exits with the returned status like it does at end of input.
+ *
+ * Return: The status the shell exits with.
+ */
+int builtin_exit(char **tokens, int line_number, char *program_name)
+{
+	exit_requested = 1;
+	return (execute_exit(tokens[1], line_number, program_name));
+}
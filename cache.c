@@ -0,0 +1,226 @@
+#include "main.h"
+
+#define PAD4(n) (((n) + 3) & ~(size_t)3)
+
+/**
+ * cache_file_name - Build the name of the cache file of a script
+ * @path: Absolute path of the script
+ * @buf: The buffer to write the name to
+ * @size: The size of the buffer
+ * @create: Non-zero to create the cache directory if it is missing
+ *
+ * Description: Cache files live in $XDG_CACHE_HOME/hsh, or ~/.cache/hsh
+ * when XDG_CACHE_HOME is not set to an absolute path, and are named after
+ * the FNV-1a hash of the script's path. The path itself is kept in the
+ * file, so a hash collision is a cache miss rather than a wrong program.
+ *
+ * Return: 0 on success, -1 if there is no usable cache directory.
+ */
+static int cache_file_name(const char *path, char *buf, size_t size,
+			   int create)
+{
+	const char *base = _getenv("XDG_CACHE_HOME"), *sub = "";
+	int len;
+
+	if (base == NULL || base[0] != '/')
+	{
+		base = _getenv("HOME");
+		sub = "/.cache";
+		if (base == NULL || base[0] == '\0')
+			return (-1);
+	}
+	len = snprintf(buf, size, "%s%s/hsh", base, sub);
+	if (len < 0 || (size_t)len + 22 >= size)
+		return (-1);
+	if (create)
+	{
+		buf[len - 4] = '\0';
+		mkdir(buf, 0700);
+		buf[len - 4] = '/';
+		if (mkdir(buf, 0700) == -1 && errno != EEXIST)
+			return (-1);
+	}
+	snprintf(buf + len, size - (size_t)len, "/%016lx.hshc",
+		 hash_string(path));
+	return (0);
+}
+
+/**
+ * cache_build_id - Fingerprint the bytecode emitted by this shell's parser
+ *
+ * Description: A small script using every construct of the language is
+ * compiled and its code and string pool hashed, so a change to the lexer,
+ * the parser or the layout of an instruction gives a new fingerprint while
+ * rebuilding the same sources gives the same one. It is computed once.
+ *
+ * Return: The fingerprint, never 0.
+ */
+static uint64_t cache_build_id(void)
+{
+	static const char probe[] =
+		"f() { a=1 b[2]=x \"c\" 'd' \\e $v ${v#p} $((1+2)) $(g) "
+		"*.c ~ 2>&1 >>o <i; }\n"
+		"if ! x && y || z; then :; elif w; then :; else :; fi\n"
+		"while x; do break; done; until y; do continue; done\n"
+		"for i in a b; do :; done; for i; do :; done\n"
+		"case $x in a|b*) ;; *) ;; esac\n"
+		"{ cat <<E; cat <<-'E' <<< s; } > o\nb $x\nE\n\tc\nE\n"
+		"x <&0 >&- <>f >|g\n";
+	static uint64_t id;
+	char buf[sizeof(probe)];
+	program_t prog;
+
+	if (id != 0)
+		return (id);
+	memcpy(buf, probe, sizeof(probe));
+	memset(&prog, 0, sizeof(prog));
+	compile_script(&prog, buf, sizeof(probe) - 1);
+	id = (uint64_t)hash_bytes((char *)prog.code, prog.code_len * 4) * 31 +
+		(uint64_t)hash_bytes(prog.strings, prog.str_len);
+	prog_free(&prog);
+	if (id == 0)
+		id = 1;
+	return (id);
+}
+
+/**
+ * cache_match - Check that a cache file was written for a script
+ * @h: The header of the file, which holds at least that many bytes
+ * @path: Absolute path of the script
+ * @st: The status of the script
+ * @file_size: Size of the cache file
+ *
+ * Return: The offset of the instruction words in the file if it was
+ * written by this build of the shell for the script as it is now, 0
+ * otherwise.
+ */
+static size_t cache_match(const hshc_header_t *h, const char *path,
+			  const struct stat *st, size_t file_size)
+{
+	size_t path_len = strlen(path) + 1, code_at;
+
+	code_at = sizeof(*h) + PAD4(path_len);
+	if (h->magic != HSHC_MAGIC || h->version != HSHC_VERSION ||
+	    h->build != cache_build_id() ||
+	    h->size != (uint64_t)st->st_size ||
+	    h->mtime_sec != (uint64_t)st->st_mtim.tv_sec ||
+	    h->mtime_nsec != (uint64_t)st->st_mtim.tv_nsec ||
+	    h->path_len != path_len ||
+	    code_at + (size_t)h->code_len * 4 + h->str_len != file_size ||
+	    memcmp(h + 1, path, path_len) != 0)
+		return (0);
+	return (code_at);
+}
+
+/**
+ * cache_load - Load the compiled form of a script from the cache
+ * @path: Absolute path of the script
+ * @st: The status of the script, as returned by fstat
+ * @prog: An empty program to load into
+ *
+ * Description: The cache file is mapped privately, so loading it costs one
+ * mmap and no copy. It is only used when it was written by the same build
+ * of the shell, for a script of the same path, size and modification time,
+ * and when its contents pass prog_verify. HSHC_VERSION numbers the format
+ * of the file, but the bytecode in it changes with the parser, so the
+ * file also records cache_build_id: a shell whose parser emits different
+ * code compiles each script once more rather than run what an older parser
+ * made of it.
+ *
+ * Return: 0 if the program was loaded, -1 on a cache miss.
+ */
+int cache_load(const char *path, const struct stat *st, program_t *prog)
+{
+	char name[4096];
+	const hshc_header_t *h;
+	struct stat cst;
+	size_t code_at;
+	void *map;
+	int fd;
+
+	if (cache_file_name(path, name, sizeof(name), 0) == -1 ||
+	    (fd = open(name, O_RDONLY | O_CLOEXEC)) == -1)
+		return (-1);
+	if (fstat(fd, &cst) == -1 || (size_t)cst.st_size < sizeof(*h))
+	{
+		close(fd);
+		return (-1);
+	}
+	map = mmap(NULL, (size_t)cst.st_size, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (-1);
+	h = map;
+	code_at = cache_match(h, path, st, (size_t)cst.st_size);
+	if (code_at == 0)
+	{
+		munmap(map, (size_t)cst.st_size);
+		return (-1);
+	}
+	prog->code = (uint32_t *)((char *)map + code_at);
+	prog->code_len = h->code_len;
+	prog->strings = (char *)(prog->code + h->code_len);
+	prog->str_len = h->str_len;
+	prog->map = map;
+	prog->map_len = (size_t)cst.st_size;
+	if (prog_verify(prog) == -1)
+	{
+		prog_free(prog);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * cache_store - Write the compiled form of a script to the cache
+ * @path: Absolute path of the script
+ * @st: The status of the script when it was read
+ * @prog: The compiled program
+ *
+ * Description: The file is written under a temporary name and renamed into
+ * place, so a shell running the same script concurrently never maps a
+ * partly written file. Like the listings of pathname expansion and the
+ * files '.' keeps, a script modified during the current second is not
+ * stored: it may be rewritten again with the same size before its
+ * modification time moves on, and the entry would then still match. The
+ * cache is only an optimization: any failure leaves the cache unchanged
+ * and is not reported.
+ *
+ * Return: None.
+ */
+void cache_store(const char *path, const struct stat *st,
+		 const program_t *prog)
+{
+	char name[4096], tmp[4128];
+	hshc_header_t h;
+	size_t path_len = strlen(path) + 1, pad = PAD4(path_len) - path_len;
+	int fd, ok;
+
+	if (st->st_mtim.tv_sec >= time(NULL) ||
+	    cache_file_name(path, name, sizeof(name), 1) == -1)
+		return;
+	snprintf(tmp, sizeof(tmp), "%s.%d", name, (int)getpid());
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	if (fd == -1)
+		return;
+	memset(&h, 0, sizeof(h));
+	h.magic = HSHC_MAGIC;
+	h.version = HSHC_VERSION;
+	h.build = cache_build_id();
+	h.code_len = (uint32_t)prog->code_len;
+	h.str_len = (uint32_t)prog->str_len;
+	h.size = (uint64_t)st->st_size;
+	h.mtime_sec = (uint64_t)st->st_mtim.tv_sec;
+	h.mtime_nsec = (uint64_t)st->st_mtim.tv_nsec;
+	h.path_len = path_len;
+	ok = write(fd, &h, sizeof(h)) == (ssize_t)sizeof(h) &&
+		write(fd, path, path_len) == (ssize_t)path_len &&
+		write(fd, "\0\0\0", pad) == (ssize_t)pad &&
+		write(fd, prog->code, prog->code_len * 4) ==
+		(ssize_t)(prog->code_len * 4) &&
+		write(fd, prog->strings, prog->str_len) ==
+		(ssize_t)prog->str_len;
+	if (close(fd) == -1 || !ok || rename(tmp, name) == -1)
+		unlink(tmp);
+}
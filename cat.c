@@ -0,0 +1,188 @@
+#include "main.h"
+
+/**
+ * cat_kernel - Copy a file inside the kernel
+ * @in: The descriptor to read
+ * @out: The descriptor to write
+ * @how: CAT_RANGE for copy_file_range, CAT_SENDFILE for sendfile or
+ * CAT_SPLICE for splice
+ *
+ * Description: Each call copies the data from one file to the other
+ * without bringing it to user space. A call the kernel does not support
+ * for these two files fails before anything is copied, and the caller
+ * then tries the next way.
+ *
+ * Return: 1 once the end of @in is reached, 0 if nothing was copied
+ * because this way is not supported, -1 on error.
+ */
+static int cat_kernel(int in, int out, int how)
+{
+	ssize_t n;
+	int copied = 0;
+
+	for (;;)
+	{
+		if (how == CAT_RANGE)
+			n = copy_file_range(in, NULL, out, NULL, CAT_CHUNK, 0);
+		else if (how == CAT_SENDFILE)
+			n = sendfile(out, in, NULL, CAT_CHUNK);
+		else
+			n = splice(in, NULL, out, NULL, CAT_CHUNK,
+				   SPLICE_F_MOVE | SPLICE_F_MORE);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n == -1 && !copied && (errno == EINVAL ||
+		    errno == EXDEV || errno == ENOSYS || errno == EBADF ||
+		    errno == EOPNOTSUPP || errno == ETXTBSY))
+			return (0);
+		if (n <= 0)
+			return (n == 0 ? 1 : -1);
+		copied = 1;
+	}
+}
+
+/**
+ * cat_copy - Copy a file through a buffer
+ * @in: The descriptor to read
+ * @out: The descriptor to write
+ *
+ * Description: This is the way of last resort, for terminals and the
+ * files the kernel cannot copy by itself. The buffer is large, so a file
+ * takes few system calls anyway.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int cat_copy(int in, int out)
+{
+	static char buf[CAT_BUFFER];
+	ssize_t n, w;
+	size_t done;
+
+	for (;;)
+	{
+		n = read(in, buf, sizeof(buf));
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (n == 0 ? 0 : -1);
+		for (done = 0; done < (size_t)n; done += (size_t)w)
+		{
+			w = write(out, buf + done, (size_t)n - done);
+			if (w == -1 && errno == EINTR)
+				w = 0;
+			else if (w == -1)
+				return (-1);
+		}
+	}
+}
+
+/**
+ * cat_fd - Copy a file to the standard output
+ * @in: The descriptor of the file
+ * @out: The status of the standard output
+ *
+ * Description: The way is picked from the types of the two files:
+ * copy_file_range between regular files, which may share blocks on file
+ * systems that allow it, sendfile from a regular file to anything else,
+ * and splice when either side is a pipe. Each one falls back to the next,
+ * and finally to cat_copy.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int cat_fd(int in, const struct stat *out)
+{
+	struct stat st;
+	int r = 0;
+
+	if (fstat(in, &st) == -1)
+		return (-1);
+	if (S_ISREG(st.st_mode) && S_ISREG(out->st_mode))
+		r = cat_kernel(in, STDOUT_FILENO, CAT_RANGE);
+	if (r == 0 && S_ISREG(st.st_mode))
+		r = cat_kernel(in, STDOUT_FILENO, CAT_SENDFILE);
+	if (r == 0 && (S_ISFIFO(st.st_mode) || S_ISFIFO(out->st_mode)))
+		r = cat_kernel(in, STDOUT_FILENO, CAT_SPLICE);
+	if (r == 0)
+		return (cat_copy(in, STDOUT_FILENO));
+	return (r == 1 ? 0 : -1);
+}
+
+/**
+ * cat_file - Copy one operand of cat to the standard output
+ * @name: The file, or '-' for the standard input
+ * @out: The status of the standard output
+ *
+ * Description: A regular file that is the standard output itself, and
+ * not at its end, is refused, as GNU cat does, since copying it would
+ * never end.
+ *
+ * Return: 0 on success, 1 after reporting an error.
+ */
+static int cat_file(const char *name, const struct stat *out)
+{
+	int fd = STDIN_FILENO, r;
+	struct stat st;
+
+	if (_strcmp(name, "-") != 0)
+		fd = open(name, O_RDONLY | O_CLOEXEC);
+	if (fd != -1 && fstat(fd, &st) == 0 && S_ISREG(out->st_mode) &&
+	    st.st_dev == out->st_dev && st.st_ino == out->st_ino &&
+	    lseek(fd, 0, SEEK_CUR) < out->st_size)
+	{
+		fprintf(stderr, "cat: %s: input file is output file\n", name);
+		if (fd != STDIN_FILENO)
+			close(fd);
+		return (1);
+	}
+	r = fd == -1 ? -1 : cat_fd(fd, out);
+	if (r == -1)
+		fprintf(stderr, "cat: %s: %s\n", name, strerror(errno));
+	if (fd != -1 && fd != STDIN_FILENO)
+		close(fd);
+	return (r == -1);
+}
+
+/**
+ * builtin_cat - Copy files to the standard output
+ * @tokens: The command, an optional '-u' and the files, '-' standing for
+ * the standard input, which is also read when there is no file
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The options of the cat program other than '-u', which
+ * asks for what this builtin always does, are left to the program, which
+ * is run instead. Messages are those of GNU cat. It may wait for its
+ * input and write to a file, so stat_epoch is moved on.
+ *
+ * Return: 0 on success, 1 if a file could not be copied.
+ */
+int builtin_cat(char **tokens, int line_number, char *program_name)
+{
+	char **arg = tokens + 1;
+	struct stat out;
+	int status = 0;
+
+	for (; *arg != NULL && (*arg)[0] == '-' && (*arg)[1] != '\0'; arg++)
+	{
+		if (_strcmp(*arg, "--") == 0)
+		{
+			arg++;
+			break;
+		}
+		if (_strcmp(*arg, "-u") != 0)
+			return (execute_command(tokens, line_number,
+						program_name));
+	}
+	fflush(stdout);
+	stat_epoch++;
+	if (fstat(STDOUT_FILENO, &out) == -1)
+	{
+		fprintf(stderr, "cat: write error: %s\n", strerror(errno));
+		return (1);
+	}
+	if (*arg == NULL)
+		return (cat_file("-", &out));
+	for (; *arg != NULL; arg++)
+		status |= cat_file(*arg, &out);
+	return (status);
+}
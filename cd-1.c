@@ -0,0 +1,192 @@
+#include "main.h"
+
+/**
+ * cd_indexed - Look the operand of cd up in a directory of CDPATH
+ * @path: The directory followed by a slash and the operand, or the
+ * operand alone for the current directory
+ * @len: Length of the directory in @path, 0 for the current directory
+ *
+ * Description: The directories of CDPATH are indexed by the listings
+ * pathname expansion caches, so they are read once, and looking an
+ * operand up is a binary search of sorted names instead of a chdir that
+ * fails. Only the first component of the operand is looked up; a name
+ * whose listing does not tell it is a directory, such as a symbolic link,
+ * is left to chdir.
+ *
+ * Return: 1 if the directory may hold the operand, 0 if it does not.
+ */
+static int cd_indexed(char *path, size_t len)
+{
+	char *name = path + len + (len > 0), **hit, c;
+	size_t k = strcspn(name, "/");
+	glob_dir_t *d;
+	int type = DT_REG;
+
+	if (len > 0)
+		path[len] = '\0';
+	d = glob_dir_open(len > 0 ? path : ".");
+	if (len > 0)
+		path[len] = '/';
+	if (d == NULL)
+		return (0);
+	c = name[k];
+	name[k] = '\0';
+	hit = bsearch(&name, d->names, d->n, sizeof(*d->names), glob_cmp);
+	name[k] = c;
+	if (hit != NULL)
+		type = (unsigned char)(*hit)[-1];
+	glob_dir_close(d);
+	return (type == DT_DIR || type == DT_LNK || type == DT_UNKNOWN);
+}
+
+/**
+ * cd_search - Change to a directory, looking it up in CDPATH
+ * @dir: The operand of cd
+ * @physical: Non-zero to resolve symbolic links
+ * @print: Set to 1 if the directory was found through a non-empty entry of
+ * CDPATH, in which case cd prints its path
+ *
+ * Description: CDPATH is not used for an operand that is absolute or
+ * starts with '.' or '..'. An empty entry stands for the current
+ * directory, which is tried last if CDPATH does not hold it.
+ *
+ * Return: 0 on success, -1 with errno set on error.
+ */
+static int cd_search(const char *dir, int physical, int *print)
+{
+	const char *p = var_get("CDPATH"), *colon;
+	size_t len, dlen = strlen(dir);
+	char *path;
+	int found;
+
+	if (dir[0] == '/' || (dir[0] == '.' && (dir[1] == '\0' ||
+	    dir[1] == '/' || (dir[1] == '.' && (dir[2] == '\0' ||
+	    dir[2] == '/')))))
+		p = NULL;
+	for (; p != NULL; p = *colon != '\0' ? colon + 1 : NULL)
+	{
+		colon = p + strcspn(p, ":");
+		len = (size_t)(colon - p);
+		path = malloc(len + dlen + 2);
+		if (path == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(path, p, len);
+		path[len] = '/';
+		memcpy(path + len + (len > 0), dir, dlen + 1);
+		found = cd_indexed(path, len) &&
+			cwd_change(path, physical) == 0;
+		free(path);
+		if (found)
+		{
+			*print = len > 0;
+			return (0);
+		}
+	}
+	return (cwd_change(dir, physical));
+}
+
+/**
+ * cd_options - Parse the '-L' and '-P' options of cd and pwd
+ * @tokens: The command and its arguments
+ * @physical: Set to 1 for '-P', to 0 for '-L'; the last one wins
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Return: The index of the first operand, or -1 after reporting an error.
+ */
+static int cd_options(char **tokens, int *physical, int line_number,
+		      char *program_name)
+{
+	const char *c;
+	int i;
+
+	for (i = 1; tokens[i] != NULL && tokens[i][0] == '-' &&
+	     tokens[i][1] != '\0'; i++)
+	{
+		if (_strcmp(tokens[i], "--") == 0)
+			return (i + 1);
+		for (c = tokens[i] + 1; *c == 'L' || *c == 'P'; c++)
+			*physical = *c == 'P';
+		if (*c != '\0')
+		{
+			fprintf(stderr, "%s: %d: %s: Illegal option -%c\n",
+				program_name, line_number, tokens[0], *c);
+			return (-1);
+		}
+	}
+	return (i);
+}
+
+/**
+ * builtin_cd - Change the current directory
+ * @tokens: The command, the options '-L' and '-P', and the directory:
+ * HOME if there is none, OLDPWD for '-'
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: PWD is logical by default: it keeps the symbolic links the
+ * directory was reached through, and '..' goes back through them. The new
+ * directory is printed for '-' and when it was found through CDPATH. The
+ * messages are those of /bin/sh.
+ *
+ * Return: 0 on success, 2 on error.
+ */
+int builtin_cd(char **tokens, int line_number, char *program_name)
+{
+	int physical = 0, print = 0, i = cd_options(tokens, &physical,
+						   line_number, program_name);
+	const char *dir, *path;
+
+	if (i == -1)
+		return (2);
+	dir = tokens[i] != NULL ? tokens[i] : var_get("HOME");
+	if (tokens[i] != NULL && _strcmp(dir, "-") == 0)
+	{
+		dir = var_get("OLDPWD");
+		print = 1;
+	}
+	if (dir != NULL && *dir != '\0' &&
+	    cd_search(dir, physical, &print) == -1)
+	{
+		fprintf(stderr, "%s: %d: cd: can't cd to %s\n", program_name,
+			line_number, dir);
+		return (2);
+	}
+	path = cwd_get();
+	if (print && path != NULL)
+		printf("%s\n", path);
+	return (0);
+}
+
+/**
+ * builtin_pwd - Print the current directory
+ * @tokens: The command and the options '-L' and '-P'
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The logical path that cd keeps is printed without a system
+ * call; '-P' asks getcwd for the path without symbolic links.
+ *
+ * Return: 0 on success, 2 on error.
+ */
+int builtin_pwd(char **tokens, int line_number, char *program_name)
+{
+	int physical = 0;
+	char buf[PATH_MAX];
+	const char *path;
+
+	if (cd_options(tokens, &physical, line_number, program_name) == -1)
+		return (2);
+	path = physical ? getcwd(buf, sizeof(buf)) : cwd_get();
+	if (path == NULL)
+	{
+		fprintf(stderr, "%s: %d: pwd: getcwd() failed: %s\n",
+			program_name, line_number, strerror(errno));
+		return (2);
+	}
+	printf("%s\n", path);
+	return (0);
+}
@@ -0,0 +1,194 @@
+#include "main.h"
+
+/* The logical path of the current directory, or NULL until it is known */
+static char *cwd_path;
+
+/* The innermost subshell run without forking, or NULL */
+subshell_t *subshell_current;
+
+/**
+ * cwd_valid - Check that a path names the current directory
+ * @path: The path, or NULL
+ *
+ * Return: 1 if @path is absolute, has no '.' or '..' component and is the
+ * current directory, 0 otherwise.
+ */
+static int cwd_valid(const char *path)
+{
+	struct stat a, b;
+	const char *p;
+
+	if (path == NULL || path[0] != '/')
+		return (0);
+	for (p = path; (p = strstr(p, "/.")) != NULL; p++)
+	{
+		if (p[2] == '\0' || p[2] == '/' ||
+		    (p[2] == '.' && (p[3] == '\0' || p[3] == '/')))
+			return (0);
+	}
+	return (stat(path, &a) == 0 && stat(".", &b) == 0 &&
+		a.st_dev == b.st_dev && a.st_ino == b.st_ino);
+}
+
+/**
+ * cwd_join - Resolve a directory against the logical current directory
+ * @base: The current directory, or NULL if @dir is absolute
+ * @dir: The directory
+ *
+ * Description: The path is made canonical without looking at the files:
+ * empty and '.' components are dropped and '..' removes the component
+ * before it, so 'cd ..' goes back through a symbolic link the way it came.
+ *
+ * Return: The absolute path, allocated with malloc.
+ */
+static char *cwd_join(const char *base, const char *dir)
+{
+	const char *parts[2], *p;
+	size_t n = 0, k;
+	char *path;
+	int i;
+
+	parts[0] = dir[0] == '/' ? "" : base;
+	parts[1] = dir;
+	path = malloc(strlen(parts[0]) + strlen(dir) + 3);
+	if (path == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < 2; i++)
+	{
+		for (p = parts[i]; *p != '\0'; p += k)
+		{
+			p += strspn(p, "/");
+			k = strcspn(p, "/");
+			if (k == 2 && p[0] == '.' && p[1] == '.')
+				while (n > 0 && path[--n] != '/')
+					;
+			else if (k > 0 && (k > 1 || p[0] != '.'))
+			{
+				path[n++] = '/';
+				memcpy(path + n, p, k);
+				n += k;
+			}
+		}
+	}
+	if (n == 0)
+		path[n++] = '/';
+	path[n] = '\0';
+	return (path);
+}
+
+/**
+ * cwd_get - Get the logical path of the current directory
+ *
+ * Description: The path is worked out once, from PWD when it names the
+ * current directory and with getcwd otherwise, in which case PWD is set
+ * to it. cd then keeps it up to date, so pwd costs no system call.
+ *
+ * Return: The path, or NULL if it cannot be known, when the directory
+ * was removed for instance.
+ */
+const char *cwd_get(void)
+{
+	char buf[PATH_MAX], *pwd;
+
+	if (cwd_path != NULL)
+		return (cwd_path);
+	pwd = var_get("PWD");
+	if (cwd_valid(pwd))
+		cwd_path = _strdup(pwd);
+	else if (getcwd(buf, sizeof(buf)) != NULL)
+		cwd_path = _strdup(buf);
+	else
+		return (NULL);
+	if (cwd_path == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	if (pwd == NULL || _strcmp(pwd, cwd_path) != 0)
+		var_set("PWD", cwd_path, VAR_EXPORT);
+	return (cwd_path);
+}
+
+/**
+ * cwd_change - Change the current directory
+ * @dir: The directory, absolute or relative to the current one
+ * @physical: Non-zero to resolve symbolic links, as 'cd -P' does
+ *
+ * Description: The logical path given by cwd_join is the one passed to
+ * chdir, so it cannot disagree with the directory, and getcwd is only
+ * called for a physical change or when the current directory has no known
+ * path. OLDPWD and PWD are exported with the old and new paths. The first
+ * change made in a subshell run without forking opens the directory the
+ * subshell started in, for cwd_restore. Relative paths now name other
+ * files, so stat_epoch is moved on for test.
+ *
+ * Return: 0 on success, -1 with errno set on error.
+ */
+int cwd_change(const char *dir, int physical)
+{
+	const char *base = cwd_get();
+	char *path = NULL, buf[PATH_MAX];
+	subshell_t *s = subshell_current;
+
+	buf[0] = '\0';
+	if (!physical && (dir[0] == '/' || base != NULL))
+		path = cwd_join(base, dir);
+	if (s != NULL && !s->cwd_saved)
+	{
+		s->cwd_saved = 1;
+		s->cwd_fd = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		s->cwd = base != NULL ? _strdup(base) : NULL;
+	}
+	if (chdir(path != NULL ? path : dir) == -1)
+	{
+		free(path);
+		return (-1);
+	}
+	stat_epoch++;
+	if (path == NULL && getcwd(buf, sizeof(buf)) != NULL)
+		path = _strdup(buf);
+	if ((path == NULL && buf[0] == '/') || (s != NULL && base != NULL &&
+						s->cwd == NULL))
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	if (base != NULL)
+		var_set("OLDPWD", base, VAR_EXPORT);
+	free(cwd_path);
+	cwd_path = path;
+	if (path != NULL)
+		var_set("PWD", path, VAR_EXPORT);
+	return (0);
+}
+
+/**
+ * cwd_restore - Go back to the directory a subshell started in
+ * @s: The subshell, which is ending
+ *
+ * Return: None.
+ */
+void cwd_restore(subshell_t *s)
+{
+	int back;
+
+	if (!s->cwd_saved)
+		return;
+	if (s->cwd_fd != -1)
+		back = fchdir(s->cwd_fd);
+	else
+		back = s->cwd != NULL ? chdir(s->cwd) : -1;
+	if (s->cwd_fd != -1)
+		close(s->cwd_fd);
+	if (back == -1)
+	{
+		free(s->cwd);
+		s->cwd = NULL;
+	}
+	free(cwd_path);
+	cwd_path = s->cwd;
+	stat_epoch++;
+}
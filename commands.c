@@ -0,0 +1,178 @@
+#include "main.h"
+
+/* The builtins and functions, by name */
+command_table_t command_table;
+
+/**
+ * cmd_grow - Double the size of the command hash table
+ *
+ * Return: 0 on success, -1 if memory could not be allocated.
+ */
+static int cmd_grow(void)
+{
+	command_table_t *t = &command_table;
+	size_t new_size = t->size ? t->size * 2 : 64, i, j;
+	command_t **slots = calloc(new_size, sizeof(*slots));
+
+	if (slots == NULL)
+		return (-1);
+	for (i = 0; i < t->size; i++)
+	{
+		if (t->slots[i] == NULL)
+			continue;
+		j = hash_string(t->slots[i]->name) & (new_size - 1);
+		while (slots[j] != NULL)
+			j = (j + 1) & (new_size - 1);
+		slots[j] = t->slots[i];
+	}
+	free(t->slots);
+	t->slots = slots;
+	t->size = new_size;
+	return (0);
+}
+
+/**
+ * cmd_lookup - Find the entry of a command name, optionally creating it
+ * @name: The command name
+ * @create: Non-zero to add an empty entry when there is none
+ *
+ * Description: Builtins and functions share one open-addressing hash
+ * table, so resolving any command that is not a program costs one hash
+ * and usually one comparison, however many functions a script defines.
+ *
+ * Return: The entry, or NULL if there is none and @create is 0.
+ */
+command_t *cmd_lookup(const char *name, int create)
+{
+	command_table_t *t = &command_table;
+	size_t i, mask;
+	command_t *c;
+
+	if (create && (t->count + 1) * 2 > t->size && cmd_grow() == -1)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	if (t->size == 0)
+		return (NULL);
+	mask = t->size - 1;
+	for (i = hash_string(name) & mask; t->slots[i] != NULL;
+	     i = (i + 1) & mask)
+	{
+		if (_strcmp(t->slots[i]->name, name) == 0)
+			return (t->slots[i]);
+	}
+	if (!create)
+		return (NULL);
+	c = calloc(1, sizeof(*c));
+	if (c != NULL)
+		c->name = _strdup(name);
+	if (c == NULL || c->name == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	c->special = is_special_builtin(name);
+	t->slots[i] = c;
+	t->count++;
+	return (c);
+}
+
+/**
+ * is_special_builtin - Check if a name is one of the POSIX special builtins
+ * @name: The command name
+ *
+ * Description: Special builtins are found before functions, and a function
+ * cannot be given their name.
+ *
+ * Return: 1 if @name is a special builtin, 0 otherwise.
+ */
+int is_special_builtin(const char *name)
+{
+	static const char * const special[] = {
+		"break", ":", ".", "continue", "eval", "exec", "exit", "export",
+		"readonly", "return", "set", "shift", "times", "trap", "unset",
+		NULL
+	};
+	int i;
+
+	for (i = 0; special[i] != NULL; i++)
+	{
+		if (_strcmp(special[i], name) == 0)
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * cmd_save - Save an entry of the command table a subshell changes
+ * @cmd: The entry, before its function or alias is replaced or removed
+ *
+ * Description: Outside of a subshell run without forking, nothing is
+ * saved. Inside one, the builtin, the function and the alias of the entry
+ * are kept, with a reference of their own when they have one, for
+ * cmd_restore.
+ *
+ * Return: None.
+ */
+void cmd_save(command_t *cmd)
+{
+	cmd_save_t *save;
+
+	if (subshell_current == NULL)
+		return;
+	save = malloc(sizeof(*save));
+	if (save == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	save->cmd = cmd;
+	save->builtin = cmd->builtin;
+	save->loadable = cmd->loadable;
+	save->fn = cmd->function;
+	save->alias = cmd->alias;
+	if (save->loadable != NULL)
+		save->loadable->refs++;
+	if (save->fn != NULL)
+		save->fn->refs++;
+	if (save->alias != NULL)
+		save->alias->refs++;
+	save->next = subshell_current->cmds;
+	subshell_current->cmds = save;
+}
+
+/**
+ * cmd_restore - Put back the entries of the command table a subshell
+ * changed
+ * @s: The subshell, which is ending
+ *
+ * Description: The entries are put back from the last one saved to the
+ * first, so a function defined twice gets the one from before the
+ * subshell.
+ *
+ * Return: None.
+ */
+void cmd_restore(subshell_t *s)
+{
+	cmd_save_t *save;
+	command_t *cmd;
+
+	while (s->cmds != NULL)
+	{
+		save = s->cmds;
+		s->cmds = save->next;
+		cmd = save->cmd;
+		if (cmd->loadable != NULL)
+			loadable_release(cmd->loadable);
+		if (cmd->function != NULL)
+			func_release(cmd->function);
+		if (cmd->alias != NULL)
+			alias_release(cmd->alias);
+		cmd->builtin = save->builtin;
+		cmd->loadable = save->loadable;
+		cmd->function = save->fn;
+		cmd->alias = save->alias;
+		free(save);
+	}
+}
@@ -0,0 +1,124 @@
+#include "main.h"
+
+/**
+ * prog_emit - Append an instruction word to a program
+ * @prog: The program being compiled
+ * @word: The opcode or operand to append
+ *
+ * Description: The code array doubles when it is full, so compiling a
+ * script costs an amortized constant time per word.
+ *
+ * Return: None.
+ */
+void prog_emit(program_t *prog, uint32_t word)
+{
+	uint32_t *code;
+
+	if (prog->code_len == prog->code_cap)
+	{
+		prog->code_cap = prog->code_cap ? prog->code_cap * 2 : 64;
+		code = realloc(prog->code, prog->code_cap * sizeof(*code));
+		if (code == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		prog->code = code;
+	}
+	prog->code[prog->code_len++] = word;
+}
+
+/**
+ * prog_add_word - Copy a word into the string pool of a program
+ * @prog: The program being compiled
+ * @str: The word
+ * @len: The length of the word
+ * @flags: The WORD_ flags of the word, stored in the byte before it
+ *
+ * Return: The offset of the word in the string pool.
+ */
+uint32_t prog_add_word(program_t *prog, const char *str, size_t len,
+		       int flags)
+{
+	uint32_t offset;
+	char *strings;
+
+	if (prog->str_len + len + 2 > prog->str_cap)
+	{
+		while (prog->str_len + len + 2 > prog->str_cap)
+			prog->str_cap = prog->str_cap ? prog->str_cap * 2 : 256;
+		strings = realloc(prog->strings, prog->str_cap);
+		if (strings == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		prog->strings = strings;
+	}
+	prog->strings[prog->str_len] = (char)flags;
+	offset = (uint32_t)prog->str_len + 1;
+	memcpy(prog->strings + offset, str, len);
+	prog->strings[offset + len] = '\0';
+	prog->str_len += len + 2;
+	return (offset);
+}
+
+/**
+ * prog_extract - Copy a range of instructions into a program of its own
+ * @dst: An empty program to copy into
+ * @src: The program to copy from
+ * @start: Index of the first instruction to copy
+ * @end: Index of the end of the range, which must not be jumped out of
+ *
+ * Description: Addresses are made relative to @start and the words the
+ * instructions use are copied into the string pool of @dst, so the copy
+ * stays valid after @src is freed. The copy is terminated with OP_END.
+ *
+ * Return: None.
+ */
+void prog_extract(program_t *dst, const program_t *src, size_t start,
+		  size_t end)
+{
+	const uint32_t *op;
+	const char *word;
+	size_t pc, i, len;
+	uint32_t op_word;
+	int kind;
+
+	for (pc = start; pc < end; pc += len)
+	{
+		op = src->code + pc;
+		len = op_length(op);
+		prog_emit(dst, op[0]);
+		for (i = 1; i < len; i++)
+		{
+			kind = op_operand(op, i);
+			if (kind == OPND_STRING)
+			{
+				word = src->strings + op[i];
+				op_word = prog_add_word(dst, word, strlen(word),
+							word[-1]);
+				prog_emit(dst, op_word);
+			}
+			else if (kind == OPND_ADDRESS)
+				prog_emit(dst, op[i] - (uint32_t)start);
+			else
+				prog_emit(dst, op[i]);
+		}
+	}
+	prog_emit(dst, OP_END);
+}
+
+/**
+ * compile_script - Compile a whole script
+ * @prog: An empty program to compile into
+ * @buf: The contents of the script, followed by a NUL byte; it is
+ * rewritten in place by the lexer
+ * @len: The size of the script
+ *
+ * Return: None.
+ */
+void compile_script(program_t *prog, char *buf, size_t len)
+{
+	parse_program(prog, buf, len, 1, 1);
+}
@@ -0,0 +1,154 @@
+#include "main.h"
+
+/**
+ * enable_list - Print the builtins, sorted by name
+ *
+ * Return: 0.
+ */
+static int enable_list(void)
+{
+	command_table_t *t = &command_table;
+	char **names = malloc((t->count + 1) * sizeof(*names));
+	size_t i, n = 0;
+
+	if (names == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < t->size; i++)
+	{
+		if (t->slots[i] != NULL && t->slots[i]->builtin != NULL)
+			names[n++] = t->slots[i]->name;
+	}
+	qsort(names, n, sizeof(*names), glob_cmp);
+	for (i = 0; i < n; i++)
+		printf("enable %s\n", names[i]);
+	free(names);
+	return (0);
+}
+
+/**
+ * enable_load - Load builtins from a shared object
+ * @path: The shared object
+ * @names: The names of the builtins
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: A loaded builtin takes the place of the builtin of the same
+ * name, which it keeps to give back when it is removed.
+ *
+ * Return: 0 on success, 1 if a builtin could not be loaded.
+ */
+static int enable_load(const char *path, char **names, int line_number,
+		       char *program_name)
+{
+	command_t *cmd;
+	loadable_t *l;
+	int status = 0;
+
+	for (; *names != NULL; names++)
+	{
+		l = loadable_open(path, *names, line_number, program_name);
+		if (l == NULL)
+		{
+			status = 1;
+			continue;
+		}
+		cmd = cmd_lookup(*names, 1);
+		l->entry.name = cmd->name;
+		l->shadowed = cmd->loadable != NULL ? cmd->loadable->shadowed :
+			cmd->builtin;
+		cmd_save(cmd);
+		if (cmd->loadable != NULL)
+			loadable_release(cmd->loadable);
+		cmd->loadable = l;
+		cmd->builtin = &l->entry;
+	}
+	return (status);
+}
+
+/**
+ * enable_delete - Remove loaded builtins
+ * @names: The names of the builtins
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Return: 0 on success, 1 if a name is not that of a loaded builtin.
+ */
+static int enable_delete(char **names, int line_number, char *program_name)
+{
+	command_t *cmd;
+	int status = 0;
+
+	for (; *names != NULL; names++)
+	{
+		cmd = cmd_lookup(*names, 0);
+		if (cmd == NULL || cmd->loadable == NULL)
+		{
+			fprintf(stderr, "%s: %d: enable: %s: %s\n",
+				program_name, line_number, *names,
+				"not a loaded builtin");
+			status = 1;
+			continue;
+		}
+		cmd_save(cmd);
+		cmd->builtin = cmd->loadable->shadowed;
+		loadable_release(cmd->loadable);
+		cmd->loadable = NULL;
+	}
+	return (status);
+}
+
+/**
+ * builtin_enable - Load builtins from shared objects, or list the builtins
+ * @tokens: The command and its arguments: '-f FILE NAME...' loads the
+ * builtins NAME from FILE, '-d NAME...' removes loaded builtins, NAME...
+ * checks that they are builtins, and nothing lists them all
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: A loaded builtin is found in the command table like the
+ * others and runs in the shell process, so a small tool that would be
+ * forked and executed for every call costs a function call instead. The
+ * interface of the shared objects is that of loadables/hsh_builtin.h.
+ * The names checked are looked up in the command table, as dispatch_command
+ * looks them up, so a loaded builtin counts and a removed one does not.
+ *
+ * Return: 0 on success, 1 if a builtin could not be loaded or found, 2
+ * on a usage error.
+ */
+int builtin_enable(char **tokens, int line_number, char *program_name)
+{
+	const char *opt = tokens[1];
+	command_t *cmd;
+	int i, status = 0;
+
+	if (opt == NULL)
+		return (enable_list());
+	if (_strcmp(opt, "-f") == 0 && tokens[2] != NULL && tokens[3] != NULL)
+		return (enable_load(tokens[2], tokens + 3, line_number,
+				    program_name));
+	if (_strcmp(opt, "-d") == 0)
+		return (enable_delete(tokens + 2, line_number, program_name));
+	if (_strcmp(opt, "-f") == 0)
+		fprintf(stderr, "%s: %d: enable: usage: %s\n", program_name,
+			line_number, "enable -f FILE NAME...");
+	else if (opt[0] == '-' && opt[1] != '\0')
+		fprintf(stderr, "%s: %d: enable: Illegal option %.2s\n",
+			program_name, line_number, opt);
+	if (opt[0] == '-' && opt[1] != '\0')
+		return (2);
+	for (i = 1; tokens[i] != NULL; i++)
+	{
+		cmd = cmd_lookup(tokens[i], 0);
+		if (cmd == NULL || cmd->builtin == NULL)
+		{
+			fprintf(stderr, "%s: %d: enable: %s: %s\n",
+				program_name, line_number, tokens[i],
+				"not a shell builtin");
+			status = 1;
+		}
+	}
+	return (status);
+}
@@ -0,0 +1,131 @@
+#include "main.h"
+
+/**
+ * builtin_loadable - Run a builtin loaded from a shared object
+ * @tokens: The command and its arguments
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Description: This is the function of the builtin table entry of every
+ * loaded builtin; the entry of the command name tells which one runs. The
+ * call holds a reference, so a builtin that is replaced while it runs is
+ * not unloaded under it. What the builtin does is unknown, so stat_epoch
+ * is moved on once it returns.
+ *
+ * Return: The exit status the builtin returned.
+ */
+static int builtin_loadable(char **tokens, int line_number,
+			    char *program_name)
+{
+	loadable_t *l = cmd_lookup(tokens[0], 0)->loadable;
+	int argc, status;
+
+	(void)line_number;
+	(void)program_name;
+	for (argc = 0; tokens[argc] != NULL; argc++)
+		;
+	l->refs++;
+	optind = 0;
+	status = l->def->run(argc, tokens);
+	stat_epoch++;
+	loadable_release(l);
+	return (status & 0xff);
+}
+
+/**
+ * loadable_symbol - Build the name of the variable describing a builtin
+ * @name: The name of the builtin
+ *
+ * Return: NAME_hsh_builtin, allocated with malloc.
+ */
+static char *loadable_symbol(const char *name)
+{
+	size_t len = strlen(name);
+	char *sym = malloc(len + sizeof(HSH_BUILTIN_SUFFIX));
+
+	if (sym == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(sym, name, len);
+	memcpy(sym + len, HSH_BUILTIN_SUFFIX, sizeof(HSH_BUILTIN_SUFFIX));
+	return (sym);
+}
+
+/**
+ * loadable_open - Load a builtin from a shared object
+ * @path: The shared object, found by dlopen like a library when it has no
+ * slash
+ * @name: The name of the builtin
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: The object is opened once for each builtin loaded from it;
+ * dlopen counts the handles, so it stays mapped until the last of them is
+ * unloaded. A builtin compiled for a version of the interface newer than
+ * the shell is refused.
+ *
+ * Return: The builtin, with one reference, or NULL after reporting an
+ * error.
+ */
+loadable_t *loadable_open(const char *path, const char *name,
+			  int line_number, char *program_name)
+{
+	void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+	char *sym = loadable_symbol(name);
+	const hsh_builtin_t *def = NULL;
+	loadable_t *l;
+	int ok = 0;
+
+	if (handle == NULL)
+		fprintf(stderr, "%s: %d: enable: %s\n", program_name,
+			line_number, dlerror());
+	else if ((def = dlsym(handle, sym)) == NULL)
+		fprintf(stderr, "%s: %d: enable: cannot find %s in %s\n",
+			program_name, line_number, sym, path);
+	else if (def->abi < 1 || def->abi > HSH_BUILTIN_ABI ||
+		 def->run == NULL)
+		fprintf(stderr, "%s: %d: enable: %s: %s %d\n", program_name,
+			line_number, name, "unsupported interface", def->abi);
+	else if (def->load != NULL && def->load() != 0)
+		fprintf(stderr, "%s: %d: enable: %s: not loaded\n",
+			program_name, line_number, name);
+	else
+		ok = 1;
+	free(sym);
+	if (!ok && handle != NULL)
+		dlclose(handle);
+	if (!ok)
+		return (NULL);
+	l = calloc(1, sizeof(*l));
+	if (l == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	l->entry.func = builtin_loadable;
+	l->def = def;
+	l->handle = handle;
+	l->refs = 1;
+	return (l);
+}
+
+/**
+ * loadable_release - Drop a reference to a loaded builtin
+ * @l: The builtin
+ *
+ * Description: With the last reference, the unload function of the builtin
+ * is called and its handle on the shared object closed.
+ *
+ * Return: None.
+ */
+void loadable_release(loadable_t *l)
+{
+	if (--l->refs > 0)
+		return;
+	if (l->def->unload != NULL)
+		l->def->unload();
+	dlclose(l->handle);
+	free(l);
+}
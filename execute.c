@@ -9,28 +9,82 @@
  * @line_number: Line number of the command in the input
  * @program_name: Name of the program
  *
- * Description: This function executes a command by forking a child process,
- * using the `execve` system call to execute the command, and waiting for the
- * child process to finish. The function checks if the command exists in the
- * PATH directories, and if not, it prints an error message using the
- * `fprintf` function. If the command exists, the function uses `execve` to
- * execute the command with the given arguments. The function also handles
- * errors that may occur during forking and executing the command.
+ * Description: This function executes an external command. It looks the
+ * command up in the PATH directories with search_path, and if it is not
+ * found it prints an error message using the `fprintf` function and returns
+ * 127, the status /bin/sh uses for unknown commands, with the
+ * redirections of the command applied around the message so it goes where
+ * the command's errors would. Otherwise the command is
+ * started with spawn_command and the function waits for it to finish with
+ * wait_command.
+ *
+ * Return: The exit status of the command.
  */
-void execute_command(char **tokens, int line_number, char *program_name)
+int execute_command(char **tokens, int line_number, char *program_name)
 {
 	pid_t child_pid;
+	uint64_t start = probe_start();
 	char *path = search_path(tokens);
-	int status;
+	redir_list_t *rl = redir_pending;
 
+	probe_end(PHASE_LOOKUP, start);
 	if (path == NULL)
 	{
+		if (rl != NULL && redir_apply(rl) == -1)
+		{
+			redir_restore(rl);
+			return (2);
+		}
 		fprintf(stderr, "%s: %d: %s: not found\n",
 			program_name, line_number, tokens[0]);
-		exit(127);
+		if (rl != NULL)
+			redir_restore(rl);
+		return (127);
 	}
 
+	child_pid = spawn_command(path, tokens, line_number, program_name);
+	free(path);
+	return (wait_command(child_pid));
+}
+
+/**
+ * spawn_command - Start a program in a child process
+ * @path: Full path of the program to execute
+ * @tokens: Array of strings representing the command and its arguments
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the program
+ *
+ * Description: This function forks a child process and uses the `execve`
+ * system call to replace it with the program at `path`. Buffered standard
+ * output is flushed first so that it is not duplicated in the child. The
+ * parent does not wait for the child; callers that need the exit status
+ * pass the returned process ID to wait_command, or poll it themselves.
+ * The environment is the array of exported variables kept by var_environ.
+ * The CPU affinity and scheduling settings selected with the 'pin' and
+ * 'sched' builtins (or spread across CPUs when HSH_SPREAD is set) are
+ * applied in the child just before execve, after the redirections in
+ * redir_pending, whose files the shell has already opened, are made with
+ * redir_child. A child that fails to exec
+ * leaves with _exit, so the shell's exit handlers only run in the shell.
+ * The function also handles errors that may occur during forking and
+ * executing the command. The child may change any file, so stat_epoch is
+ * moved on, which empties the stat cache of test.
+ *
+ * Return: The process ID of the child.
+ */
+pid_t spawn_command(char *path, char **tokens, int line_number,
+		    char *program_name)
+{
+	pid_t child_pid;
+	spawn_attr_t attr = spawn_attr;
+	char **env = var_environ();
+	uint64_t start;
+
+	spread_cpus(&attr);
+	fflush(stdout);
+	start = probe_start();
 	child_pid = fork();
+	stat_epoch++;
 	if (child_pid == -1)
 	{
 		perror("Fork error");
@@ -39,23 +93,70 @@ void execute_command(char **tokens, int line_number, char *program_name)
 
 	if (child_pid == 0)
 	{
-		if (environ == NULL)
+		if (redir_pending != NULL)
+			redir_child(redir_pending);
+		if (env == NULL)
 		{
 			fprintf(stderr, "%s: %d: %s: not found\n",
 				program_name, line_number, tokens[0]);
-			exit(127);
+			_exit(127);
 		}
-		if (execve(path, tokens, environ) == -1)
+		apply_spawn_attr(&attr);
+		if (execve(path, tokens, env) == -1)
 		{
 			perror("Execve error");
-			exit(EXIT_FAILURE);
+			_exit(EXIT_FAILURE);
 		}
 	}
-	else
+	probe_end(PHASE_SPAWN, start);
+	return (child_pid);
+}
+
+/**
+ * wait_command - Wait for a child process and collect its exit status
+ * @child_pid: Process ID returned by spawn_command
+ *
+ * Description: This function waits for the given child to terminate,
+ * retrying if the wait is interrupted by a signal, and converts the raw
+ * wait status with decode_status. The child is reaped with wait4 so that
+ * its resource usage can be reported by the 'time' builtin.
+ *
+ * Return: The exit status of the child, or 1 if it could not be waited for.
+ */
+int wait_command(pid_t child_pid)
+{
+	int status;
+	struct rusage usage;
+	uint64_t start = probe_start();
+
+	probe_pid = child_pid;
+	while (wait4(child_pid, &status, 0, &usage) == -1)
 	{
-		waitpid(child_pid, &status, 0);
+		if (errno != EINTR)
+			return (1);
 	}
-	free(path);
+	probe_end(PHASE_WAIT, start);
+	account_child(&usage);
+	return (decode_status(status));
+}
+
+/**
+ * decode_status - Convert a raw wait status into a shell exit status
+ * @status: The status filled in by waitpid
+ *
+ * Description: A child that exited normally reports its exit code. A child
+ * that was terminated by a signal reports 128 plus the signal number, which
+ * is how /bin/sh presents it in $?.
+ *
+ * Return: The shell exit status.
+ */
+int decode_status(int status)
+{
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	if (WIFSIGNALED(status))
+		return (128 + WTERMSIG(status));
+	return (1);
 }
 
 /**
@@ -94,6 +195,8 @@ char *search_path(char **tokens)
 		free(path_copy);
 		return (_strdup(tokens[0]));
 	}
+	if (path_copy == NULL)
+		return (NULL);
 
 	token = strtok(path_copy, PATH_SEPARATOR);
 	while (token != NULL)
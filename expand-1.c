@@ -0,0 +1,177 @@
+#include "main.h"
+
+/**
+ * exp_grow - Make room for more bytes in the field being built
+ * @ex: The expansion
+ * @n: The number of bytes to add
+ *
+ * Description: The field starts in the inline buffer of @ex and only moves
+ * to the heap when it outgrows it, so expanding an ordinary word allocates
+ * nothing but its copy in the arena.
+ *
+ * Return: None.
+ */
+static void exp_grow(expand_t *ex, size_t n)
+{
+	char *buf;
+
+	if (ex->len + n + 1 <= ex->cap)
+		return;
+	while (ex->len + n + 1 > ex->cap)
+		ex->cap *= 2;
+	buf = malloc(ex->cap);
+	if (buf == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(buf, ex->buf, ex->len);
+	if (ex->buf != ex->inline_buf)
+		free(ex->buf);
+	ex->buf = buf;
+}
+
+/**
+ * ifs_chars - Get the characters fields are split at
+ *
+ * Return: The value of IFS, or space, tab and newline when it is not set.
+ */
+const char *ifs_chars(void)
+{
+	const char *ifs = var_get("IFS");
+
+	return (ifs != NULL ? ifs : " \t\n");
+}
+
+/**
+ * exp_split - Add the result of an unquoted expansion, splitting it
+ * @ex: The expansion
+ * @str: The result
+ * @len: Its length
+ * @ifs: The IFS characters, not empty
+ *
+ * Description: IFS white space separates fields and is dropped at their
+ * ends. Any other IFS character separates fields by itself, together with
+ * the white space around it, so two in a row delimit an empty field, but
+ * one at the end does not start a new field.
+ *
+ * Return: None.
+ */
+static void exp_split(expand_t *ex, const char *str, size_t len,
+		      const char *ifs)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+	{
+		if (_strchr(ifs, str[i]) == NULL)
+		{
+			exp_grow(ex, 2);
+			if (str[i] == '\\')
+			{
+				ex->buf[ex->len++] = '\\';
+				ex->escaped = 1;
+			}
+			else if (str[i] == '*' || str[i] == '?' ||
+				 str[i] == '[')
+				ex->glob = 1;
+			ex->buf[ex->len++] = str[i];
+			ex->started = 1;
+		}
+		else if (str[i] == ' ' || str[i] == '\t' || str[i] == '\n')
+		{
+			if (ex->started)
+			{
+				exp_field(ex);
+				ex->skip = 1;
+			}
+		}
+		else if (ex->started)
+			exp_field(ex);
+		else if (ex->skip)
+			ex->skip = 0;
+		else
+			exp_field(ex);
+	}
+}
+
+/**
+ * exp_put - Add text to the result of an expansion
+ * @ex: The expansion
+ * @str: The text
+ * @len: Its length
+ * @how: PUT_LITERAL for unquoted text of the word, PUT_QUOTED for quoted
+ * text, or PUT_EXPANDED for the result of an unquoted expansion
+ *
+ * Description: Only the results of unquoted expansions are split into
+ * fields. Quotes make a field exist even when they are empty. In a pattern
+ * the quoted characters are escaped, so glob_match takes them literally,
+ * and so are they in a field, which may be a pattern for pathname
+ * expansion, with the backslashes that are not quotes.
+ *
+ * Return: None.
+ */
+void exp_put(expand_t *ex, const char *str, size_t len, int how)
+{
+	const char *ifs;
+	size_t i;
+	int special;
+
+	if (how == PUT_EXPANDED && ex->mode == EXP_FIELDS)
+	{
+		ifs = ifs_chars();
+		if (*ifs != '\0')
+		{
+			exp_split(ex, str, len, ifs);
+			return;
+		}
+	}
+	if (how == PUT_QUOTED || len > 0)
+		ex->started = 1;
+	if (ex->mode == EXP_FIELDS ||
+	    (how == PUT_QUOTED && ex->mode == EXP_PATTERN))
+	{
+		exp_grow(ex, 2 * len);
+		for (i = 0; i < len; i++)
+		{
+			special = str[i] == '*' || str[i] == '?' ||
+				  str[i] == '[';
+			if (str[i] == '\\' || (special && how == PUT_QUOTED))
+			{
+				ex->buf[ex->len++] = '\\';
+				ex->escaped = 1;
+			}
+			else if (special)
+				ex->glob = 1;
+			ex->buf[ex->len++] = str[i];
+		}
+		return;
+	}
+	exp_grow(ex, len);
+	memcpy(ex->buf + ex->len, str, len);
+	ex->len += len;
+}
+
+/**
+ * exp_field - End the field being built and add it to the fields
+ * @ex: The expansion, in EXP_FIELDS mode
+ *
+ * Description: A field with an unquoted special character is a pattern,
+ * replaced by the paths it matches; one that matches nothing is kept, as
+ * is any other field, without the backslashes quoting its characters.
+ *
+ * Return: None.
+ */
+void exp_field(expand_t *ex)
+{
+	ex->buf[ex->len] = '\0';
+	if (!ex->glob || glob_expand(ex->buf, ex->out) == 0)
+		fields_add(ex->out, ex->escaped ?
+			   glob_unescape(ex->buf, ex->len) :
+			   arena_strndup(ex->buf, ex->len));
+	ex->len = 0;
+	ex->started = 0;
+	ex->skip = 0;
+	ex->glob = 0;
+	ex->escaped = 0;
+}
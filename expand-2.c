@@ -0,0 +1,191 @@
+#include "main.h"
+
+/**
+ * exp_skip - Find the end of a bracketed substitution
+ * @p: The opening '{' or '(' of the substitution
+ * @end: End of the text
+ *
+ * Description: The text inside a substitution was copied as it was
+ * written, so nested brackets, quoted strings and backslash escapes are
+ * skipped over like lex_balanced does when it reads them.
+ *
+ * Return: The position after the closing bracket, or @end.
+ */
+const char *exp_skip(const char *p, const char *end)
+{
+	char open = *p, close = *p == '(' ? ')' : '}', quote;
+	int depth = 0;
+
+	for (; p < end; p++)
+	{
+		if (*p == '\'' || *p == '"')
+		{
+			for (quote = *p++; p < end && *p != quote; p++)
+			{
+				if (quote == '"' && *p == '\\' && p + 1 < end)
+					p++;
+			}
+			if (p == end)
+				return (end);
+		}
+		else if (*p == '\\' && p + 1 < end)
+			p++;
+		else if (*p == open)
+			depth++;
+		else if (*p == close && --depth == 0)
+			return (p + 1);
+	}
+	return (end);
+}
+
+/**
+ * exp_plain - Measure a run of text that needs no expansion
+ * @p: The start of the text
+ * @end: End of the text
+ * @raw: Non-zero if quotes are written as themselves, as inside a
+ * substitution, rather than as the lexer's markers
+ *
+ * Return: The number of bytes before the next quote, marker, '$', '`', '~'
+ * or ':', which may start a tilde prefix in an assignment, at least 1.
+ */
+static size_t exp_plain(const char *p, const char *end, int raw)
+{
+	const char *q = p + 1;
+
+	while (q < end && *q != CTL_ESC && *q != CTL_DQ && *q != CTL_SQ &&
+	       *q != '$' && *q != '`' && *q != '~' && *q != ':' &&
+	       (!raw || (*q != '\'' && *q != '"' && *q != '\\')))
+		q++;
+	return ((size_t)(q - p));
+}
+
+/**
+ * exp_tilde - Expand a tilde prefix
+ * @ex: The expansion
+ * @p: The '~'
+ * @end: End of the text
+ *
+ * Description: "~" is the value of HOME and "~name" the home directory of
+ * the user name. The prefix is left as it is when it is quoted in any way
+ * or the directory is not known. The result is not split into fields.
+ *
+ * Return: The position after the prefix.
+ */
+static const char *exp_tilde(expand_t *ex, const char *p, const char *end)
+{
+	const char *q = p + 1, *home;
+	struct passwd *pw;
+
+	while (q < end && *q != '/' && !(ex->mode == EXP_ASSIGN && *q == ':'))
+	{
+		if (*q == CTL_ESC || *q == CTL_DQ || *q == CTL_SQ ||
+		    _strchr("$`'\"\\", *q) != NULL)
+		{
+			exp_put(ex, p, 1, PUT_LITERAL);
+			return (p + 1);
+		}
+		q++;
+	}
+	if (q == p + 1)
+		home = var_get("HOME");
+	else
+	{
+		pw = getpwnam(arena_strndup(p + 1, (size_t)(q - p - 1)));
+		home = pw != NULL ? pw->pw_dir : NULL;
+	}
+	if (home == NULL)
+	{
+		exp_put(ex, p, (size_t)(q - p), PUT_LITERAL);
+		return (q);
+	}
+	exp_put(ex, home, strlen(home), PUT_QUOTED);
+	return (q);
+}
+
+/**
+ * exp_text - Expand text
+ * @ex: The expansion
+ * @p: The start of the text
+ * @end: End of the text
+ * @dq: Non-zero if the text is inside double quotes
+ * @raw: Non-zero if quotes are written as themselves, as in the word of a
+ * "${name-word}" substitution, rather than as the lexer's markers
+ *
+ * Description: Quoted text is added as it is, parameters are expanded in
+ * place and a tilde prefix starts the text or, in an assignment, follows a
+ * ':'. Command substitutions are replaced by the output of their command.
+ * Text that needs nothing is added in runs.
+ *
+ * Return: None.
+ */
+void exp_text(expand_t *ex, const char *p, const char *end, int dq, int raw)
+{
+	const char *start = p, *q;
+	char c;
+
+	while (p < end && !ex->error)
+	{
+		c = *p;
+		if (c == CTL_SQ || (raw && !dq && c == '\''))
+		{
+			for (q = ++p; p < end && *p != c; p++)
+				;
+			exp_put(ex, q, (size_t)(p - q), PUT_QUOTED);
+			p += p < end;
+		}
+		else if (c == CTL_DQ || (raw && c == '"'))
+		{
+			if (dq && !ex->suppress)
+				ex->started = 1;
+			ex->suppress = 0;
+			dq = !dq;
+			p++;
+		}
+		else if ((c == CTL_ESC || (raw && c == '\\')) && p + 1 < end)
+			p = exp_escape(ex, p, dq);
+		else if (c == '$')
+			p = exp_dollar(ex, p, end, dq);
+		else if (c == '`')
+			p = exp_backquote(ex, p, end, dq);
+		else if (c == '~' && !dq && (p == start ||
+			 (ex->mode == EXP_ASSIGN && p[-1] == ':')))
+			p = exp_tilde(ex, p, end);
+		else
+		{
+			q = p;
+			p += exp_plain(p, end, raw);
+			exp_put(ex, q, (size_t)(p - q), dq ? PUT_QUOTED :
+				PUT_LITERAL);
+		}
+	}
+}
+
+/**
+ * exp_sub - Expand part of a word into a separate string
+ * @ex: The expansion the part belongs to
+ * @mode: EXP_STRING or EXP_PATTERN
+ * @p: The start of the part
+ * @end: Its end
+ * @dq: Non-zero if the part is inside double quotes
+ *
+ * Description: This expands the word of a substitution that is not added
+ * to the result as it is: the value assigned by "${name=word}", the
+ * message of "${name?word}" and the pattern of "${name#word}".
+ *
+ * Return: The string, in the arena, or NULL if the expansion failed, in
+ * which case @ex is marked as failed too.
+ */
+char *exp_sub(expand_t *ex, int mode, const char *p, const char *end,
+	      int dq)
+{
+	expand_t sub;
+	char *str;
+
+	exp_init(&sub, mode, NULL, ex->line, ex->program_name);
+	exp_text(&sub, p, end, dq, 1);
+	str = exp_finish(&sub);
+	if (!sub.error)
+		return (str);
+	ex->error = 1;
+	return (NULL);
+}
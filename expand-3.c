@@ -0,0 +1,182 @@
+#include "main.h"
+
+/**
+ * exp_bad - Report a substitution that cannot be parsed
+ * @ex: The expansion, which is marked as failed
+ *
+ * Description: Like a syntax error, it makes a shell that is not
+ * interactive exit.
+ *
+ * Return: None.
+ */
+void exp_bad(expand_t *ex)
+{
+	fprintf(stderr, "%s: %d: Syntax error: Bad substitution\n",
+		ex->program_name, ex->line);
+	ex->error = 1;
+	if (!interactive)
+		exit_requested = 1;
+}
+
+/**
+ * exp_dollar - Expand a '$' and what follows it
+ * @ex: The expansion
+ * @p: The '$'
+ * @end: End of the text
+ * @dq: Non-zero if the '$' is inside double quotes
+ *
+ * Description: "$name", "$1" to "$9" and the special parameters are
+ * expanded here, "${...}" by exp_brace, "$((...))" by exp_arith and
+ * "$(...)" by exp_command. A '$' that starts nothing is an ordinary
+ * character.
+ *
+ * Return: The position after the expansion.
+ */
+const char *exp_dollar(expand_t *ex, const char *p, const char *end,
+		       int dq)
+{
+	const char *name = p + 1, *q = name;
+	char c = name < end ? *name : '\0';
+
+	if (c == '{')
+		return (exp_brace(ex, p, end, dq));
+	if (c == '(' && name + 1 < end && name[1] == '(')
+	{
+		q = exp_arith(ex, p, end, dq);
+		if (q != NULL)
+			return (q);
+	}
+	if (c == '(')
+	{
+		q = exp_skip(name, end);
+		if (q[-1] == ')')
+			exp_command(ex, name + 1, q - 1, dq);
+		else
+			exp_bad(ex);
+		return (q);
+	}
+	if (c == '_' || isalpha((unsigned char)c))
+	{
+		while (q < end && (*q == '_' || isalnum((unsigned char)*q)))
+			q++;
+	}
+	else if (c != '\0' && (isdigit((unsigned char)c) ||
+			       _strchr("@*#?-$!", c) != NULL))
+		q++;
+	if (q == name)
+	{
+		exp_put(ex, p, 1, dq ? PUT_QUOTED : PUT_LITERAL);
+		return (p + 1);
+	}
+	exp_value(ex, name, (size_t)(q - name), dq);
+	return (q);
+}
+
+/**
+ * exp_lookup - Get the value of a parameter
+ * @name: The name of a variable, a positional parameter or a special
+ * parameter; it does not need to be terminated
+ * @len: The length of the name
+ *
+ * Description: Variables are looked up in the variable table with a single
+ * hash, and an array gives its element 0. Numbers are formatted into the
+ * arena. '$@' and '$*' are joined here, which is what the substitutions
+ * that take their value as a whole, such as "${#*}" or "${@:-word}", need.
+ *
+ * Return: The value, or NULL if the parameter is not set.
+ */
+const char *exp_lookup(const char *name, size_t len)
+{
+	char num[24];
+	int n = params != NULL ? params->argc : 0, i;
+	var_t *v;
+
+	if (isdigit((unsigned char)*name))
+	{
+		for (i = 0; len > 0 && i < 100000; len--, name++)
+			i = i * 10 + (*name - '0');
+		if (i == 0)
+			return (shell_name);
+		return (i <= n ? params->argv[i - 1] : NULL);
+	}
+	if (len == 1 && _strchr("#?$!-", *name) != NULL)
+	{
+		if (*name == '!')
+			return (NULL);
+		if (*name == '-')
+			return (interactive ? "i" : "");
+		snprintf(num, sizeof(num), "%d", *name == '#' ? n :
+			 *name == '?' ? last_status : (int)shell_pid);
+		return (arena_strndup(num, strlen(num)));
+	}
+	if (len == 1 && (*name == '@' || *name == '*'))
+		return (exp_join(*name == '*' ? *ifs_chars() : ' '));
+	v = var_lookup(name, len, 0);
+	if (v == NULL || v->array != NULL)
+		return (v != NULL ? array_get(v->array, 0) : NULL);
+	return (v->flags & VAR_UNSET ? NULL : v->str + v->name_len + 1);
+}
+
+/**
+ * exp_value - Add the value of a parameter to an expansion
+ * @ex: The expansion
+ * @name: The name of the parameter
+ * @len: The length of the name
+ * @dq: Non-zero inside double quotes
+ *
+ * Return: None.
+ */
+void exp_value(expand_t *ex, const char *name, size_t len, int dq)
+{
+	const char *value;
+
+	if (len == 1 && (*name == '@' || *name == '*'))
+	{
+		exp_args(ex, params != NULL ? params->argv : NULL,
+			 params != NULL ? params->argc : 0, *name, dq);
+		return;
+	}
+	value = exp_lookup(name, len);
+	if (value != NULL)
+		exp_put(ex, value, strlen(value), dq ? PUT_QUOTED :
+			PUT_EXPANDED);
+}
+
+/**
+ * exp_args - Expand '$@' or '$*', or the elements of an array
+ * @ex: The expansion
+ * @argv: The positional parameters, or the elements
+ * @n: Their number
+ * @c: '@' or '*'
+ * @dq: Non-zero inside double quotes
+ *
+ * Description: Unquoted, each positional parameter is split into fields of
+ * its own. "$@" makes each parameter a field, even an empty one, and
+ * nothing at all when there is none. "$*", and both forms when the result
+ * is a single string, join the parameters with the first character of IFS
+ * or, for '$@', a space.
+ *
+ * Return: None.
+ */
+void exp_args(expand_t *ex, char **argv, int n, char c, int dq)
+{
+	char sep = c == '*' ? *ifs_chars() : ' ';
+	int i;
+
+	if (n == 0 && dq && c == '@')
+		ex->suppress = 1;
+	for (i = 0; i < n; i++)
+	{
+		if (i > 0 && ex->mode == EXP_FIELDS && dq && c == '@')
+			exp_field(ex);
+		else if (i > 0 && ex->mode == EXP_FIELDS && !dq)
+		{
+			if (ex->started)
+				exp_field(ex);
+		}
+		else if (i > 0 && sep != '\0')
+			exp_put(ex, &sep, 1, PUT_QUOTED);
+		exp_put(ex, argv[i], strlen(argv[i]), dq ? PUT_QUOTED :
+			PUT_EXPANDED);
+	}
+}
@@ -0,0 +1,196 @@
+#include "main.h"
+
+/**
+ * exp_brace - Expand a "${...}" substitution
+ * @ex: The expansion
+ * @p: The '$'
+ * @end: End of the text
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: The parameter is a name, a number of any length or a single
+ * special character. "${#parameter}" is the length of its value; any other
+ * operator that follows the parameter is handled by exp_brace_op, and a
+ * subscript by exp_array.
+ *
+ * Return: The position after the closing brace.
+ */
+const char *exp_brace(expand_t *ex, const char *p, const char *end, int dq)
+{
+	const char *stop = exp_skip(p + 1, end), *name = p + 2, *q;
+	const char *value;
+	int length = 0;
+	char num[24];
+
+	if (stop[-1] != '}' || stop - p < 4)
+	{
+		exp_bad(ex);
+		return (stop);
+	}
+	if (*name == '#' && name + 2 < stop)
+		length = 1, name++;
+	q = name;
+	if (*q == '_' || isalpha((unsigned char)*q))
+		while (*q == '_' || isalnum((unsigned char)*q))
+			q++;
+	else if (isdigit((unsigned char)*q))
+		while (isdigit((unsigned char)*q))
+			q++;
+	else if (_strchr("@*#?-$!", *q) != NULL)
+		q++;
+	if (*q == '[' && (*name == '_' || isalpha((unsigned char)*name)))
+		exp_array(ex, p, stop, end, dq);
+	else if (q == name || (length && q != stop - 1))
+		exp_bad(ex);
+	else if (length)
+	{
+		value = exp_lookup(name, (size_t)(q - name));
+		snprintf(num, sizeof(num), "%lu", (unsigned long)
+			 (value == NULL ? 0 : (*name == '@' || *name == '*') &&
+			  params != NULL ? (size_t)params->argc :
+			  strlen(value)));
+		exp_put(ex, num, strlen(num), dq ? PUT_QUOTED : PUT_EXPANDED);
+	}
+	else if (q == stop - 1)
+		exp_value(ex, name, (size_t)(q - name), dq);
+	else
+		exp_brace_op(ex, name, (size_t)(q - name), q, stop - 1, dq);
+	return (stop);
+}
+
+/**
+ * exp_brace_op - Expand a "${parameter<op>word}" substitution
+ * @ex: The expansion
+ * @name: The name of the parameter
+ * @len: The length of the name
+ * @op: The operator
+ * @end: The closing brace
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: '-', '=', '?' and '+' are left to exp_cond. '#', '##', '%'
+ * and '%%' remove the
+ * shortest or longest prefix or suffix matching a pattern, which double
+ * quotes around the substitution do not quote, and ':offset' or
+ * ':offset:length' take a substring.
+ *
+ * Return: None.
+ */
+void exp_brace_op(expand_t *ex, const char *name, size_t len,
+		  const char *op, const char *end, int dq)
+{
+	int colon = *op == ':' && _strchr("-=?+", op[1]) != NULL;
+	int longest = op[1] == op[0];
+	const char *value, *word = op + colon + 1;
+	char c = op[colon], *str;
+
+	if (c == '#' || c == '%')
+	{
+		str = exp_sub(ex, EXP_PATTERN, word + longest, end, 0);
+		value = exp_lookup(name, len);
+		if (str != NULL)
+			str = exp_trim(value != NULL ? value : "", str,
+				       c == '%', longest);
+	}
+	else if (c == ':')
+		str = exp_substr(ex, name, len, word, end, dq);
+	else if (_strchr("-=?+", c) == NULL || c == '\0')
+	{
+		exp_bad(ex);
+		return;
+	}
+	else
+		str = exp_cond(ex, name, len, op, end, dq);
+	if (str != NULL)
+		exp_put(ex, str, strlen(str), dq ? PUT_QUOTED : PUT_EXPANDED);
+}
+
+/**
+ * exp_trim - Remove a prefix or suffix matching a pattern
+ * @value: The value to trim
+ * @pattern: The pattern
+ * @suffix: Non-zero to remove a suffix, 0 for a prefix
+ * @longest: Non-zero to remove the longest match, 0 for the shortest
+ *
+ * Description: The candidates are tried from the shortest or from the
+ * longest, so the first match is the one to remove. A prefix is matched by
+ * cutting the copy short in place for the time of the match.
+ *
+ * Return: The trimmed value, in the arena.
+ */
+char *exp_trim(const char *value, const char *pattern, int suffix,
+	       int longest)
+{
+	size_t len = strlen(value), k, i;
+	char *str = arena_strndup(value, len), c;
+	int match;
+
+	for (k = 0; k <= len; k++)
+	{
+		i = suffix == longest ? k : len - k;
+		if (suffix)
+		{
+			if (glob_match(pattern, str + i))
+			{
+				str[i] = '\0';
+				return (str);
+			}
+			continue;
+		}
+		c = str[i];
+		str[i] = '\0';
+		match = glob_match(pattern, str);
+		str[i] = c;
+		if (match)
+			return (str + i);
+	}
+	return (str);
+}
+
+/**
+ * exp_substr - Take a substring of a value
+ * @ex: The expansion
+ * @name: The name of the parameter
+ * @len: The length of the name
+ * @p: The offset, optionally followed by ':' and the length
+ * @end: The closing brace
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: A negative offset counts from the end of the value, and a
+ * negative length leaves that many characters out at the end.
+ *
+ * Return: The substring, in the arena, or NULL on error.
+ */
+char *exp_substr(expand_t *ex, const char *name, size_t len,
+		 const char *p, const char *end, int dq)
+{
+	char *spec = exp_sub(ex, EXP_STRING, p, end, dq), *rest;
+	const char *value;
+	long size, off, count;
+
+	if (spec == NULL)
+		return (NULL);
+	value = exp_lookup(name, len);
+	size = value != NULL ? (long)strlen(value) : 0;
+	off = strtol(spec, &rest, 10);
+	count = size;
+	if (*rest == ':')
+		count = strtol(rest + 1, &rest, 10);
+	while (*rest == ' ' || *rest == '\t')
+		rest++;
+	if (*rest != '\0' || rest == spec)
+	{
+		exp_bad(ex);
+		return (NULL);
+	}
+	if (off < 0)
+		off = off + size < 0 ? 0 : off + size;
+	if (off > size)
+		off = size;
+	if (count < 0)
+		count = size + count - off;
+	if (count < 0)
+		count = 0;
+	if (count > size - off)
+		count = size - off;
+	return (arena_strndup(value != NULL ? value + off : "",
+			      (size_t)count));
+}
@@ -0,0 +1,88 @@
+#include "main.h"
+
+/**
+ * expand_word - Expand a word into fields
+ * @word: The word, as the lexer rewrote it, with its quote markers
+ * @out: The list the fields are added to
+ * @line: The line number, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: Parameters and tilde prefixes are expanded, the results of
+ * unquoted expansions are split at the IFS characters, the fields that are
+ * patterns are replaced by the paths they match and the quotes are
+ * removed. A word may expand to no field at all, or to several.
+ *
+ * Return: 0 on success, -1 if an expansion failed.
+ */
+int expand_word(const char *word, fields_t *out, int line,
+		char *program_name)
+{
+	expand_t ex;
+
+	exp_init(&ex, EXP_FIELDS, out, line, program_name);
+	exp_text(&ex, word, word + strlen(word), 0, 0);
+	exp_finish(&ex);
+	return (ex.error ? -1 : 0);
+}
+
+/**
+ * expand_string - Expand a word into a single string
+ * @word: The word, as the lexer rewrote it, with its quote markers
+ * @mode: EXP_STRING, EXP_PATTERN, or EXP_ASSIGN for the value of an
+ * assignment, where a tilde prefix may also follow a ':'
+ * @line: The line number, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: This is the expansion of the words that are not split into
+ * fields: the values of assignments, the word of a case command and its
+ * patterns.
+ *
+ * Return: The string, in the arena, or NULL if an expansion failed.
+ */
+char *expand_string(const char *word, int mode, int line,
+		    char *program_name)
+{
+	expand_t ex;
+	char *str;
+
+	exp_init(&ex, mode, NULL, line, program_name);
+	exp_text(&ex, word, word + strlen(word), 0, 0);
+	str = exp_finish(&ex);
+	return (ex.error ? NULL : str);
+}
+
+/**
+ * expand_command - Expand the words of a simple command
+ * @prog: The program
+ * @pc: Index of the OP_CMD instruction
+ * @out: The list the fields of the command are added to
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: Only the words the lexer marked as containing a '$', a
+ * '~' or an unquoted pattern character are expanded; the others were
+ * unquoted by the parser and are used from the string pool as they are.
+ * The assignments that start the command are skipped, for
+ * var_assign_words to expand once the command's words are known, as POSIX
+ * orders it.
+ *
+ * Return: The number of assignments, or -1 if an expansion failed.
+ */
+int expand_command(const program_t *prog, size_t pc, fields_t *out,
+		   char *program_name)
+{
+	uint32_t argc = prog->code[pc + 2], i;
+	int line = (int)prog->code[pc + 1], assigns = 0;
+	const char *word;
+
+	for (i = 0; i < argc; i++)
+	{
+		word = prog_word(prog, pc, (int)i);
+		if (word[-1] & WORD_ASSIGN)
+			assigns++;
+		else if (!(word[-1] & (WORD_DOLLAR | WORD_TILDE | WORD_GLOB)))
+			fields_add(out, (char *)word);
+		else if (expand_word(word, out, line, program_name) == -1)
+			return (-1);
+	}
+	return (assigns);
+}
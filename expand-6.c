@@ -0,0 +1,112 @@
+#include "main.h"
+
+/**
+ * exp_escape - Expand a backslash and the character it quotes
+ * @ex: The expansion
+ * @p: The backslash, or the lexer's CTL_ESC, followed by a character
+ * @dq: Non-zero if the backslash is inside double quotes
+ *
+ * Description: Inside double quotes, a backslash written as itself only
+ * quotes '$', '`', '"', '\' and a newline, and is kept before any other
+ * character. A backslash-newline is removed.
+ *
+ * Return: The text after what was expanded.
+ */
+const char *exp_escape(expand_t *ex, const char *p, int dq)
+{
+	if (*p == '\\' && dq && _strchr("$`\"\\\n", p[1]) == NULL)
+	{
+		exp_put(ex, p, 1, PUT_QUOTED);
+		return (p + 1);
+	}
+	if (*p == CTL_ESC || p[1] != '\n')
+		exp_put(ex, p + 1, 1, PUT_QUOTED);
+	return (p + 2);
+}
+
+/**
+ * exp_join - Join the positional parameters into one string
+ * @sep: The character put between them, or NUL for none
+ *
+ * Description: This is the value of '$@' and '$*' for the substitutions
+ * that take it as a whole, such as "${#*}" or "${@:-word}".
+ *
+ * Return: The string, in the arena.
+ */
+char *exp_join(char sep)
+{
+	int n = params != NULL ? params->argc : 0, i;
+	size_t size = 0, len;
+	char *str;
+
+	for (i = 0; i < n; i++)
+		size += strlen(params->argv[i]) + 1;
+	str = arena_alloc(size + 1);
+	for (i = 0, size = 0; i < n; i++)
+	{
+		if (i > 0 && sep != '\0')
+			str[size++] = sep;
+		len = strlen(params->argv[i]);
+		memcpy(str + size, params->argv[i], len);
+		size += len;
+	}
+	str[size] = '\0';
+	return (str);
+}
+
+/**
+ * exp_cond - Expand a "${parameter-word}" substitution or one of its kin
+ * @ex: The expansion
+ * @name: The name of the parameter
+ * @len: The length of the name
+ * @op: The operator: '-', '=', '?' or '+', possibly after a ':'
+ * @end: The closing brace
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: The operators test whether the parameter is set, or with a
+ * ':' before them whether it is set and not empty; the word is only
+ * expanded when it is used. '?' reports the word as an error, and '='
+ * assigns it to the parameter, which must then be a variable.
+ *
+ * Return: The string left for the caller to add, or NULL if the
+ * substitution was added already, or failed.
+ */
+char *exp_cond(expand_t *ex, const char *name, size_t len, const char *op,
+	       const char *end, int dq)
+{
+	int colon = *op == ':', set;
+	const char *value = exp_lookup(name, len), *word = op + colon + 1;
+	char c = op[colon], *str;
+
+	set = value != NULL && (!colon || *value != '\0');
+	if (set != (c == '+'))
+	{
+		if (set)
+			exp_value(ex, name, len, dq);
+		return (NULL);
+	}
+	if (c == '-' || c == '+')
+	{
+		exp_text(ex, word, end, dq, 1);
+		return (NULL);
+	}
+	str = exp_sub(ex, EXP_STRING, word, end, dq);
+	if (str != NULL && c == '?')
+	{
+		fprintf(stderr, "%s: %d: %.*s: %s\n", ex->program_name,
+			ex->line, (int)len, name,
+			*str != '\0' ? str : "parameter not set");
+		ex->error = 1;
+		if (!interactive)
+			exit_requested = 1;
+		return (NULL);
+	}
+	if (str != NULL && !valid_name(name, len))
+	{
+		exp_bad(ex);
+		return (NULL);
+	}
+	if (str != NULL)
+		var_assign(var_lookup(name, len, 1), str, 0);
+	return (str);
+}
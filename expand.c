@@ -0,0 +1,111 @@
+#include "main.h"
+
+/**
+ * fields_init - Prepare an empty list of fields
+ * @f: The list
+ *
+ * Return: None.
+ */
+void fields_init(fields_t *f)
+{
+	f->v = f->inline_v;
+	f->n = 0;
+	f->cap = FIELDS_INLINE;
+	f->v[0] = NULL;
+}
+
+/**
+ * fields_add - Append a field to a list
+ * @f: The list
+ * @field: The field, which must outlive the list
+ *
+ * Description: The list leaves its inline storage for the heap when it is
+ * full, and then doubles, like the loop stack of run_program.
+ *
+ * Return: None.
+ */
+void fields_add(fields_t *f, char *field)
+{
+	char **v;
+
+	if (f->n + 2 > f->cap)
+	{
+		v = malloc(f->cap * 2 * sizeof(*v));
+		if (v == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(v, f->v, f->n * sizeof(*v));
+		if (f->v != f->inline_v)
+			free(f->v);
+		f->v = v;
+		f->cap *= 2;
+	}
+	f->v[f->n++] = field;
+	f->v[f->n] = NULL;
+}
+
+/**
+ * fields_free - Release a list of fields
+ * @f: The list; the fields themselves belong to the arena or the program
+ *
+ * Return: None.
+ */
+void fields_free(fields_t *f)
+{
+	if (f->v != f->inline_v)
+		free(f->v);
+}
+
+/**
+ * exp_init - Start the expansion of a word
+ * @ex: The expansion
+ * @mode: One of the EXP_ modes
+ * @out: The list the fields are added to in EXP_FIELDS mode, or NULL
+ * @line: The line number, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Return: None.
+ */
+void exp_init(expand_t *ex, int mode, fields_t *out, int line,
+	      char *program_name)
+{
+	ex->mode = mode;
+	ex->out = out;
+	ex->buf = ex->inline_buf;
+	ex->len = 0;
+	ex->cap = EXPAND_INLINE;
+	ex->started = 0;
+	ex->skip = 0;
+	ex->suppress = 0;
+	ex->glob = 0;
+	ex->escaped = 0;
+	ex->error = 0;
+	ex->line = line;
+	ex->program_name = program_name;
+}
+
+/**
+ * exp_finish - End the expansion of a word
+ * @ex: The expansion
+ *
+ * Description: In EXP_FIELDS mode the last field is added to the list,
+ * unless nothing went into it: an unquoted expansion that is empty
+ * produces no field at all.
+ *
+ * Return: In the other modes, the resulting string, in the arena; NULL in
+ * EXP_FIELDS mode.
+ */
+char *exp_finish(expand_t *ex)
+{
+	char *str = NULL;
+
+	if (ex->mode == EXP_FIELDS && ex->started)
+		exp_field(ex);
+	else if (ex->mode != EXP_FIELDS)
+		str = arena_strndup(ex->buf, ex->len);
+	if (ex->buf != ex->inline_buf)
+		free(ex->buf);
+	return (str);
+}
@@ -0,0 +1,95 @@
+#include "main.h"
+
+/* The positional parameters, NULL when there are none */
+param_frame_t *params;
+/* Number of function calls being run */
+int func_depth;
+
+/**
+ * func_define - Define or redefine a function
+ * @name: The name of the function
+ * @prog: The program holding the OP_FUNC instruction
+ * @start: Index of the first instruction of the body
+ * @end: Index of the end of the body
+ *
+ * Description: The body is copied out of @prog by prog_extract, since the
+ * program of an input line is compiled into again once the line has run.
+ * It is copied in compiled form, so calling the function never parses it
+ * again. Its aliases are fixed now by alias_bind, as /bin/sh replaces
+ * them when it reads the definition. A previous definition is released,
+ * but a call that is running it keeps its own reference to it. Inside a
+ * subshell run without forking, cmd_save keeps it for the end of the
+ * subshell.
+ *
+ * Return: None.
+ */
+void func_define(const char *name, const program_t *prog, size_t start,
+		 size_t end)
+{
+	command_t *cmd = cmd_lookup(name, 1);
+	function_t *fn = calloc(1, sizeof(*fn));
+
+	if (fn == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	prog_extract(&fn->prog, prog, start, end);
+	alias_bind(&fn->prog, prog, start);
+	fn->refs = 1;
+	cmd_save(cmd);
+	if (cmd->function != NULL)
+		func_release(cmd->function);
+	cmd->function = fn;
+}
+
+/**
+ * func_release - Drop a reference to a function
+ * @fn: The function
+ *
+ * Description: The function is freed with its last reference.
+ *
+ * Return: None.
+ */
+void func_release(function_t *fn)
+{
+	if (--fn->refs > 0)
+		return;
+	prog_free(&fn->prog);
+	free(fn);
+}
+
+/**
+ * func_call - Call a function
+ * @fn: The function
+ * @tokens: The command name and the arguments of the call
+ * @program_name: Name of the shell program
+ *
+ * Description: The arguments become the positional parameters through a
+ * frame on this function's stack that points into @tokens, so nothing is
+ * copied, and the caller's parameters are back in place once the body has
+ * run. The body stops early when 'return' is run.
+ *
+ * Return: The status of the last command of the body, or the status given
+ * to 'return'.
+ */
+int func_call(function_t *fn, char **tokens, char *program_name)
+{
+	param_frame_t frame;
+	int status;
+
+	frame.argv = tokens + 1;
+	for (frame.argc = 0; frame.argv[frame.argc] != NULL; frame.argc++)
+		;
+	frame.prev = params;
+	params = &frame;
+	fn->refs++;
+	func_depth++;
+	status = run_program(&fn->prog, program_name);
+	func_depth--;
+	func_release(fn);
+	params = frame.prev;
+	if (loop_request == LOOP_RETURN)
+		loop_request = 0;
+	return (status);
+}
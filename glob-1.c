@@ -0,0 +1,155 @@
+#include "main.h"
+
+/* Listings of the directories pathname expansion read, by hash of path */
+static glob_dir_t glob_dirs[GLOB_DIR_CACHE];
+
+/**
+ * glob_cmp - Compare two names for qsort
+ * @a: Pointer to the first name
+ * @b: Pointer to the second name
+ *
+ * Return: The result of strcmp on the names.
+ */
+int glob_cmp(const void *a, const void *b)
+{
+	return (strcmp(*(char * const *)a, *(char * const *)b));
+}
+
+/**
+ * glob_dir_free - Release a listing
+ * @d: The listing; its path is kept
+ *
+ * Return: None.
+ */
+static void glob_dir_free(glob_dir_t *d)
+{
+	free(d->pool);
+	free(d->names);
+	d->pool = NULL;
+	d->names = NULL;
+	d->n = 0;
+}
+
+/**
+ * glob_dir_fill - Read the names of a directory into a listing
+ * @d: The listing, empty
+ * @dir: The open directory
+ *
+ * Description: The names go into a single pool, each one after a byte
+ * holding its d_type, so telling a directory from a file later rarely
+ * needs a stat. The array of names is built once the pool stops moving,
+ * and sorted, since expanded paths are sorted.
+ *
+ * Return: None.
+ */
+static void glob_dir_fill(glob_dir_t *d, DIR *dir)
+{
+	size_t used = 0, cap = 0, len, i, *off = NULL;
+	struct dirent *ent;
+
+	while ((ent = readdir(dir)) != NULL)
+	{
+		len = strlen(ent->d_name) + 2;
+		if (used + len > cap)
+		{
+			cap = cap * 2 + len + 256;
+			d->pool = realloc(d->pool, cap);
+		}
+		if (d->n % 64 == 0)
+			off = realloc(off, (d->n + 64) * sizeof(*off));
+		if (d->pool == NULL || off == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		d->pool[used] = (char)ent->d_type;
+		memcpy(d->pool + used + 1, ent->d_name, len - 1);
+		off[d->n++] = used + 1;
+		used += len;
+	}
+	d->names = malloc((d->n + 1) * sizeof(*d->names));
+	if (d->names == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < d->n; i++)
+		d->names[i] = d->pool + off[i];
+	free(off);
+	qsort(d->names, d->n, sizeof(*d->names), glob_cmp);
+}
+
+/**
+ * glob_dir_open - Get the listing of a directory
+ * @path: The directory
+ *
+ * Description: Listings are cached, so expanding the same patterns again,
+ * in a loop for instance, does not read the directories again. A stat of
+ * the directory checks that its inode and modification time are those of
+ * the listing; a listing read during the second of the modification time
+ * is read again, since the directory may have changed after it within
+ * that second. A listing in use that another directory would replace is
+ * left alone, and that directory gets a listing of its own.
+ *
+ * Return: The listing, to give back with glob_dir_close, or NULL if the
+ * directory cannot be read.
+ */
+glob_dir_t *glob_dir_open(const char *path)
+{
+	glob_dir_t *d = &glob_dirs[hash_string(path) & (GLOB_DIR_CACHE - 1)];
+	time_t now = time(NULL);
+	struct stat st;
+	DIR *dir;
+
+	if (stat(path, &st) == -1 || !S_ISDIR(st.st_mode))
+		return (NULL);
+	if (d->path != NULL && _strcmp(d->path, path) == 0 &&
+	    d->dev == st.st_dev && d->ino == st.st_ino &&
+	    d->mtime.tv_sec == st.st_mtim.tv_sec &&
+	    d->mtime.tv_nsec == st.st_mtim.tv_nsec &&
+	    d->read_at > st.st_mtim.tv_sec)
+	{
+		d->busy++;
+		return (d);
+	}
+	dir = opendir(path);
+	if (dir == NULL)
+		return (NULL);
+	if (d->busy)
+		d = calloc(1, sizeof(*d));
+	else
+	{
+		free(d->path);
+		glob_dir_free(d);
+		d->cached = 1;
+	}
+	if (d == NULL || (d->path = _strdup(path)) == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	d->dev = st.st_dev;
+	d->ino = st.st_ino;
+	d->mtime = st.st_mtim;
+	d->read_at = now;
+	glob_dir_fill(d, dir);
+	closedir(dir);
+	d->busy = 1;
+	return (d);
+}
+
+/**
+ * glob_dir_close - Give back a listing obtained with glob_dir_open
+ * @d: The listing
+ *
+ * Return: None.
+ */
+void glob_dir_close(glob_dir_t *d)
+{
+	d->busy--;
+	if (d->cached)
+		return;
+	glob_dir_free(d);
+	free(d->path);
+	free(d);
+}
@@ -0,0 +1,174 @@
+#include "main.h"
+
+/**
+ * glob_has_magic - Check if a pattern has special characters
+ * @pattern: The pattern, its quoted characters escaped with a backslash
+ * @len: Its length
+ *
+ * Description: A '[' is only special when a ']' closes it, so a lone
+ * '[', like the name of the test command, is not a pattern.
+ *
+ * Return: 1 if @pattern has an unescaped '*', '?' or bracket expression,
+ * 0 otherwise.
+ */
+int glob_has_magic(const char *pattern, size_t len)
+{
+	size_t i, j;
+
+	for (i = 0; i < len; i++)
+	{
+		if (pattern[i] == '\\')
+			i++;
+		else if (pattern[i] == '*' || pattern[i] == '?')
+			return (1);
+		else if (pattern[i] == '[')
+		{
+			j = i + 1;
+			if (j < len && (pattern[j] == '!' || pattern[j] == '^'))
+				j++;
+			j += j < len && pattern[j] == ']';
+			while (j < len && pattern[j] != ']' &&
+			       pattern[j] != '/')
+				j++;
+			if (j < len && pattern[j] == ']')
+				return (1);
+		}
+	}
+	return (0);
+}
+
+/**
+ * glob_unescape - Remove the backslashes that quote characters of a pattern
+ * @str: The pattern
+ * @len: Its length
+ *
+ * Return: The text the pattern stands for, in the arena.
+ */
+char *glob_unescape(const char *str, size_t len)
+{
+	char *out = arena_alloc(len + 1);
+	size_t i, j = 0;
+
+	for (i = 0; i < len; i++)
+	{
+		if (str[i] == '\\' && i + 1 < len)
+			i++;
+		out[j++] = str[i];
+	}
+	out[j] = '\0';
+	return (out);
+}
+
+/**
+ * glob_compile - Compile a component of a pattern
+ * @pat: The compiled component
+ * @text: The component
+ *
+ * Description: Most patterns are a '*' with text before or after it, like
+ * "*.log", which are matched by comparing that text with the end or the
+ * start of each name. The others are interpreted by glob_match.
+ *
+ * Return: None.
+ */
+static void glob_compile(glob_pat_t *pat, const char *text)
+{
+	size_t len = strlen(text);
+
+	pat->text = text;
+	pat->lit = NULL;
+	pat->lit_len = 0;
+	pat->dot = text[0] == '.' || (text[0] == '\\' && text[1] == '.');
+	pat->kind = GLOB_GENERIC;
+	if (len == 1 && text[0] == '*')
+		pat->kind = GLOB_ALL;
+	else if (len > 1 && text[0] == '*' &&
+		 strcspn(text + 1, "*?[\\") == len - 1)
+	{
+		pat->kind = GLOB_SUFFIX;
+		pat->lit = text + 1;
+		pat->lit_len = len - 1;
+	}
+	else if (len > 1 && text[len - 1] == '*' &&
+		 strcspn(text, "*?[\\") == len - 1)
+	{
+		pat->kind = GLOB_PREFIX;
+		pat->lit = text;
+		pat->lit_len = len - 1;
+	}
+}
+
+/**
+ * glob_test - Match a name against a compiled component
+ * @pat: The component
+ * @name: The name
+ *
+ * Description: A name starting with a '.' is only matched by a component
+ * starting with one, as POSIX requires.
+ *
+ * Return: 1 if it matches, 0 otherwise.
+ */
+static int glob_test(const glob_pat_t *pat, const char *name)
+{
+	size_t len;
+
+	if (name[0] == '.' && !pat->dot)
+		return (0);
+	switch (pat->kind)
+	{
+	case GLOB_ALL:
+		return (1);
+	case GLOB_SUFFIX:
+		len = strlen(name);
+		return (len >= pat->lit_len &&
+			memcmp(name + len - pat->lit_len, pat->lit,
+			       pat->lit_len) == 0);
+	case GLOB_PREFIX:
+		return (_strncmp(name, pat->lit, pat->lit_len) == 0);
+	}
+	return (glob_match(pat->text, name));
+}
+
+/**
+ * glob_dir_match - Expand a component of a pattern that has special
+ * characters
+ * @w: The expansion, whose path is the directory to look in
+ * @i: Index of the component
+ *
+ * Description: The component is compiled once and matched against every
+ * name of the cached listing of the directory. A name that matches is
+ * added to the path, and the expansion goes on with the next component,
+ * which needs the name to be a directory.
+ *
+ * Return: None.
+ */
+void glob_dir_match(glob_walk_t *w, size_t i)
+{
+	glob_dir_t *d = glob_dir_open(w->len > 0 ? w->path : ".");
+	size_t k, len = w->len;
+	glob_pat_t pat;
+	struct stat st;
+	char *name;
+
+	if (d == NULL)
+		return;
+	glob_compile(&pat, w->comps[i]);
+	for (k = 0; k < d->n; k++)
+	{
+		name = d->names[k];
+		if (!glob_test(&pat, name))
+			continue;
+		glob_push(w, name, strlen(name));
+		if (i + 1 < w->n && name[-1] != DT_DIR &&
+		    ((name[-1] != DT_UNKNOWN && name[-1] != DT_LNK) ||
+		     stat(w->path, &st) == -1 || !S_ISDIR(st.st_mode)))
+		{
+			w->len = len;
+			continue;
+		}
+		if (i + 1 < w->n)
+			glob_push(w, "/", 1);
+		glob_walk(w, i + 1, 0);
+		w->len = len;
+	}
+	glob_dir_close(d);
+}
@@ -0,0 +1,118 @@
+#include "main.h"
+
+/**
+ * glob_push - Add text to the path of a pathname expansion
+ * @w: The expansion
+ * @str: The text
+ * @len: Its length
+ *
+ * Return: None.
+ */
+void glob_push(glob_walk_t *w, const char *str, size_t len)
+{
+	char *path;
+
+	if (w->len + len + 1 > w->cap)
+	{
+		w->cap = (w->len + len + 1) * 2;
+		path = realloc(w->path, w->cap);
+		if (path == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		w->path = path;
+	}
+	memcpy(w->path + w->len, str, len);
+	w->len += len;
+	w->path[w->len] = '\0';
+}
+
+/**
+ * glob_walk - Expand the components of a pattern from one on
+ * @w: The expansion, whose path holds the expansion of the components
+ * before @i
+ * @i: Index of the component
+ * @literal: Non-zero if the component before @i had nothing special, so
+ * the path may not exist
+ *
+ * Description: A component without special characters is added to the
+ * path as it is, without reading any directory; whether the path exists
+ * is only checked once it is complete.
+ *
+ * Return: None.
+ */
+void glob_walk(glob_walk_t *w, size_t i, int literal)
+{
+	const char *comp;
+	size_t len = w->len;
+	struct stat st;
+
+	if (i == w->n)
+	{
+		if (!literal || lstat(w->path, &st) == 0)
+		{
+			fields_add(w->out, arena_strndup(w->path, w->len));
+			w->found++;
+		}
+		return;
+	}
+	comp = w->comps[i];
+	if (glob_has_magic(comp, strlen(comp)))
+	{
+		glob_dir_match(w, i);
+		return;
+	}
+	comp = glob_unescape(comp, strlen(comp));
+	glob_push(w, comp, strlen(comp));
+	if (i + 1 < w->n)
+		glob_push(w, "/", 1);
+	glob_walk(w, i + 1, 1);
+	w->len = len;
+}
+
+/**
+ * glob_expand - Expand a pattern into the paths it matches
+ * @pattern: The pattern, its quoted characters escaped with a backslash
+ * @out: The list the paths are added to
+ *
+ * Description: The pattern is split at its slashes into components, and
+ * only the directories that components with special characters apply to
+ * are read, through the cache of listings. The paths are sorted.
+ *
+ * Return: The number of paths added, 0 if the pattern matches nothing or
+ * is not a pattern.
+ */
+size_t glob_expand(const char *pattern, fields_t *out)
+{
+	glob_walk_t w;
+	size_t len = strlen(pattern), i, start = out->n, magic = 0;
+	char *copy;
+
+	if (!glob_has_magic(pattern, len))
+		return (0);
+	copy = arena_strndup(pattern, len);
+	for (i = 0, w.n = 1; i < len; i++)
+		w.n += copy[i] == '/';
+	w.comps = arena_alloc(w.n * sizeof(*w.comps));
+	w.comps[0] = copy;
+	for (i = 0, w.n = 1; i < len; i++)
+	{
+		if (copy[i] != '/')
+			continue;
+		copy[i] = '\0';
+		magic += glob_has_magic(w.comps[w.n - 1],
+					strlen(w.comps[w.n - 1]));
+		w.comps[w.n++] = copy + i + 1;
+	}
+	w.path = NULL;
+	w.len = 0;
+	w.cap = 0;
+	w.out = out;
+	w.found = 0;
+	glob_walk(&w, 0, 0);
+	free(w.path);
+	if (magic > 0 && w.found > 1)
+		qsort(out->v + start, w.found, sizeof(*out->v), glob_cmp);
+	return (w.found);
+}
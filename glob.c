@@ -0,0 +1,116 @@
+#include "main.h"
+
+/**
+ * glob_bracket - Match a character against a bracket expression
+ * @pattern: The pattern, positioned on the '['
+ * @c: The character
+ * @len: Set to the length of the bracket expression
+ *
+ * Description: A leading '!' or '^' negates the expression, a ']' right
+ * after the opening bracket is an ordinary character, and "a-z" is a
+ * range. A '[' without a closing ']' is an ordinary character.
+ *
+ * Return: 1 if @c matches, 0 if it does not.
+ */
+static int glob_bracket(const char *pattern, char c, size_t *len)
+{
+	const char *p = pattern + 1;
+	int negate = 0, match = 0;
+	char low, high;
+
+	if (*p == '!' || *p == '^')
+	{
+		negate = 1;
+		p++;
+	}
+	do {
+		if (*p == '\0')
+		{
+			*len = 1;
+			return (c == '[');
+		}
+		low = *p == '\\' && p[1] != '\0' ? *++p : *p;
+		high = low;
+		if (p[1] == '-' && p[2] != ']' && p[2] != '\0')
+		{
+			p += 2;
+			high = *p == '\\' && p[1] != '\0' ? *++p : *p;
+		}
+		if ((unsigned char)c >= (unsigned char)low &&
+		    (unsigned char)c <= (unsigned char)high)
+			match = 1;
+		p++;
+	} while (*p != ']');
+	*len = (size_t)(p + 1 - pattern);
+	return (match != negate);
+}
+
+/**
+ * glob_one - Match one character against one element of a pattern
+ * @pattern: The pattern, positioned on a '?', a bracket expression, an
+ * escaped or an ordinary character
+ * @c: The character
+ *
+ * Return: The length of the element if it matches, 0 otherwise.
+ */
+static size_t glob_one(const char *pattern, char c)
+{
+	size_t len;
+
+	switch (*pattern)
+	{
+	case '\0':
+		return (0);
+	case '?':
+		return (1);
+	case '[':
+		return (glob_bracket(pattern, c, &len) ? len : 0);
+	case '\\':
+		if (pattern[1] != '\0')
+			return (pattern[1] == c ? 2 : 0);
+	}
+	return (*pattern == c ? 1 : 0);
+}
+
+/**
+ * glob_match - Match a string against a shell pattern
+ * @pattern: The pattern, where '*', '?' and bracket expressions are special
+ * and a backslash makes the next character ordinary
+ * @str: The string
+ *
+ * Description: The matcher keeps only the position of the last '*' and
+ * backtracks to it on a mismatch, letting it absorb one more character,
+ * which matches in time proportional to the product of the lengths at
+ * worst, without recursion or allocation.
+ *
+ * Return: 1 if the whole string matches, 0 otherwise.
+ */
+int glob_match(const char *pattern, const char *str)
+{
+	const char *star = NULL, *resume = NULL;
+	size_t len;
+
+	while (*str != '\0')
+	{
+		if (*pattern == '*')
+		{
+			star = ++pattern;
+			resume = str;
+			continue;
+		}
+		len = glob_one(pattern, *str);
+		if (len != 0)
+		{
+			pattern += len;
+			str++;
+			continue;
+		}
+		if (star == NULL)
+			return (0);
+		pattern = star;
+		str = ++resume;
+	}
+	while (*pattern == '*')
+		pattern++;
+	return (*pattern == '\0');
+}
@@ -0,0 +1,123 @@
+#include "main.h"
+
+#define NSEC_PER_SEC 1000000000UL
+
+/**
+ * now_ns - Read the monotonic clock
+ *
+ * Description: This function returns the current value of CLOCK_MONOTONIC
+ * as a single count of nanoseconds. The monotonic clock is not affected by
+ * changes to the wall clock, which makes it suitable for deadlines and for
+ * measuring how long something took.
+ *
+ * Return: The current monotonic time in nanoseconds.
+ */
+uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * ns_to_timespec - Split a nanosecond count into a struct timespec
+ * @ns: The number of nanoseconds
+ * @ts: The structure to fill in
+ *
+ * Return: None.
+ */
+void ns_to_timespec(uint64_t ns, struct timespec *ts)
+{
+	ts->tv_sec = (time_t)(ns / NSEC_PER_SEC);
+	ts->tv_nsec = (long)(ns % NSEC_PER_SEC);
+}
+
+/**
+ * unit_multiplier - Get the number of nanoseconds in a duration unit
+ * @suffix: The text following the number, possibly empty
+ *
+ * Return: The multiplier for the suffix, or 0 if the suffix is invalid.
+ */
+static uint64_t unit_multiplier(const char *suffix)
+{
+	if (suffix[0] == '\0' || _strcmp(suffix, "s") == 0)
+		return (NSEC_PER_SEC);
+	if (_strcmp(suffix, "m") == 0)
+		return (60 * NSEC_PER_SEC);
+	if (_strcmp(suffix, "h") == 0)
+		return (3600 * NSEC_PER_SEC);
+	if (_strcmp(suffix, "d") == 0)
+		return (86400 * NSEC_PER_SEC);
+	return (0);
+}
+
+/**
+ * parse_duration - Parse a duration such as "2", "0.25" or "1.5m"
+ * @str: The string to parse
+ * @ns: Where to store the duration in nanoseconds
+ *
+ * Description: This function accepts a non-negative decimal number with an
+ * optional fractional part, followed by an optional unit suffix: 's' for
+ * seconds (the default), 'm' for minutes, 'h' for hours or 'd' for days,
+ * the same format GNU sleep and timeout accept. The number is parsed with
+ * integer arithmetic only, so "0.1" is exactly 100000000 nanoseconds and
+ * there is no floating point rounding. Digits beyond nanosecond precision
+ * are ignored. Values that do not fit in 64 bits are rejected.
+ *
+ * Return: 0 on success, -1 if the string is not a valid duration.
+ */
+int parse_duration(const char *str, uint64_t *ns)
+{
+	uint64_t whole = 0, frac = 0, scale = NSEC_PER_SEC, unit;
+	int digits = 0;
+
+	for (; *str >= '0' && *str <= '9'; str++, digits++)
+	{
+		if (whole > (UINT64_MAX - 9) / 10)
+			return (-1);
+		whole = whole * 10 + (uint64_t)(*str - '0');
+	}
+	if (*str == '.')
+	{
+		for (str++; *str >= '0' && *str <= '9'; str++, digits++)
+		{
+			if (scale > 1)
+			{
+				scale /= 10;
+				frac += (uint64_t)(*str - '0') * scale;
+			}
+		}
+	}
+	unit = unit_multiplier(str);
+	if (digits == 0 || unit == 0 || whole > UINT64_MAX / unit)
+		return (-1);
+	frac *= unit / NSEC_PER_SEC;
+	*ns = whole * unit;
+	if (*ns > UINT64_MAX - frac)
+		return (-1);
+	*ns += frac;
+	return (0);
+}
+
+/**
+ * hash_string - Compute the FNV-1a hash of a string
+ * @str: The string to hash
+ *
+ * Description: FNV-1a is a simple multiplicative hash that spreads short
+ * strings such as command names well, which is all the shell's hash tables
+ * need.
+ *
+ * Return: The 64-bit hash of the string.
+ */
+unsigned long hash_string(const char *str)
+{
+	unsigned long hash = 14695981039346656037UL;
+
+	while (*str != '\0')
+	{
+		hash ^= (unsigned char)*str++;
+		hash *= 1099511628211UL;
+	}
+	return (hash);
+}
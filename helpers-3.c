@@ -51,3 +51,26 @@ ssize_t _getline(char **lineptr, size_t *n, FILE *stream)
 	*n = ret;
 	return (ret);
 }
+
+/**
+ * hash_bytes - Compute the FNV-1a hash of a sized string
+ * @str: The bytes to hash
+ * @len: The number of bytes
+ *
+ * Description: This is hash_string for strings that are not terminated,
+ * such as a name at the start of a "NAME=value" entry. Both functions
+ * return the same hash for the same characters.
+ *
+ * Return: The 64-bit hash of the bytes.
+ */
+unsigned long hash_bytes(const char *str, size_t len)
+{
+	unsigned long hash = 14695981039346656037UL;
+
+	while (len-- > 0)
+	{
+		hash ^= (unsigned char)*str++;
+		hash *= 1099511628211UL;
+	}
+	return (hash);
+}
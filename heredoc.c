@@ -0,0 +1,113 @@
+#include "main.h"
+
+/* The sealed files of literal here-documents, by hash of their body */
+static heredoc_file_t heredoc_cache[HEREDOC_CACHE];
+
+/**
+ * heredoc_file - Create a file holding the body of a here-document
+ * @text: The body
+ * @len: Its length
+ *
+ * Description: The file is a memfd, an anonymous file in memory, so no
+ * temporary file is created in a directory and nothing has to be removed.
+ * Once written, it is sealed against any change and rewound, ready to be
+ * read from the start. Where memfd_create is not available, an unnamed
+ * O_TMPFILE file is used instead, without the seals.
+ *
+ * Return: The descriptor of the file, or -1 on error.
+ */
+static int heredoc_file(const char *text, size_t len)
+{
+	size_t done = 0;
+	ssize_t n;
+	int fd = memfd_create("hsh-heredoc", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+
+	if (fd == -1)
+		fd = open(P_tmpdir, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+	if (fd == -1)
+		return (-1);
+	while (done < len)
+	{
+		n = write(fd, text + done, len - done);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n == -1)
+		{
+			close(fd);
+			return (-1);
+		}
+		done += (size_t)n;
+	}
+	fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE |
+	      F_SEAL_SEAL);
+	lseek(fd, 0, SEEK_SET);
+	return (fd);
+}
+
+/**
+ * heredoc_reopen - Open a cached file again for one redirection
+ * @fd: The descriptor the cache keeps
+ *
+ * Description: Going through /proc gives a new open file description, with
+ * an offset of its own, so a here-document used again while an earlier use
+ * of the same body is still being read does not move that reader.
+ *
+ * Return: The new descriptor, at the start of the file, or -1 on error.
+ */
+static int heredoc_reopen(int fd)
+{
+	char path[32];
+
+	snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+	return (open(path, O_RDONLY | O_CLOEXEC));
+}
+
+/**
+ * heredoc_open - Get a file to read the body of a here-document from
+ * @text: The body, expanded
+ * @literal: Non-zero if the body had nothing to expand, so it is the same
+ * every time the redirection is made
+ * @cached: Set to 0, since the caller always owns the descriptor, even that
+ * of a cached file
+ *
+ * Description: The file of a literal body is kept open in a small table
+ * indexed by the hash of the body, where a new body replaces the one in
+ * its entry, so a here-document in a loop is written once and only opened
+ * again on the next iterations. A sealed file cannot have been changed by
+ * the commands that read it. Where it cannot be opened again, a new file
+ * is written for the redirection.
+ *
+ * Return: The descriptor, or -1 on error.
+ */
+int heredoc_open(const char *text, int literal, int *cached)
+{
+	heredoc_file_t *e = &heredoc_cache[hash_string(text) &
+					    (HEREDOC_CACHE - 1)];
+	int fd;
+
+	*cached = 0;
+	if (literal && e->text != NULL && _strcmp(e->text, text) == 0)
+	{
+		fd = heredoc_reopen(e->fd);
+		return (fd != -1 ? fd : heredoc_file(text, strlen(text)));
+	}
+	fd = heredoc_file(text, strlen(text));
+	if (fd == -1 || !literal)
+		return (fd);
+	if (e->text != NULL)
+	{
+		close(e->fd);
+		free(e->text);
+	}
+	e->text = _strdup(text);
+	if (e->text == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	e->fd = fd;
+	fd = heredoc_reopen(e->fd);
+	if (fd == -1)
+		fd = heredoc_file(text, strlen(text));
+	return (fd);
+}
@@ -0,0 +1,110 @@
+#!/bin/bash
+
+################################################################################
+# Description for the intranet check (one line, support Markdown syntax)
+# Run `/bin/true` with HSH_STATS=1 and check the JSON report written at exit
+
+################################################################################
+# The variable 'compare_with_sh' IS OPTIONNAL
+#
+# Uncomment the following line if you don't want the output of the shell
+# to be compared against the output of /bin/sh
+#
+# It can be useful when you want to check a builtin command that sh doesn't
+# implement
+compare_with_sh=0
+
+################################################################################
+# The variable 'shell_input' HAS TO BE DEFINED
+#
+# The content of this variable will be piped to the student's shell and to sh
+# as follows: "echo $shell_input | ./hsh"
+#
+# It can be empty and multiline
+shell_input="/bin/true"
+
+################################################################################
+# The variable 'shell_params' IS OPTIONNAL
+#
+# The content of this variable will be passed to as the paramaters array to the
+# shell as follows: "./hsh $shell_params"
+#
+# It can be empty
+# shell_params=""
+
+################################################################################
+# The function 'check_setup' will be called BEFORE the execution of the shell
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function check_setup()
+{
+	export HSH_STATS=1
+
+	return 0
+}
+
+################################################################################
+# The function 'sh_setup' will be called AFTER the execution of the students
+# shell, and BEFORE the execution of the real shell (sh)
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function sh_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function `check_callback` will be called AFTER the execution of the shell
+# It allows you to clear VARIABLES, cleanup files, ...
+#
+# It is also possible to perform additionnal checks.
+# Here is a list of available variables:
+# STATUS -> Path to the file containing the exit status of the shell
+# OUTPUTFILE -> Path to the file containing the stdout of the shell
+# ERROR_OUTPUTFILE -> Path to the file containing the stderr of the shell
+# EXPECTED_STATUS -> Path to the file containing the exit status of sh
+# EXPECTED_OUTPUTFILE -> Path to the file containing the stdout of sh
+# EXPECTED_ERROR_OUTPUTFILE -> Path to the file continaing the stderr of sh
+#
+# Parameters:
+#     $1 -> Status of the comparison with sh
+#             0 -> The output is the same as sh
+#             1 -> The output differs from sh
+#
+# Return value:
+#     0  -> Check succeed
+#     1  -> Check fails
+function check_callback()
+{
+	let status=0
+
+	unset HSH_STATS
+	# Keep the shape of the JSON report written on stderr at exit
+	$SED -i -E -e 's/"count": 1,/"count": ONE,/' -e 's/[0-9]+/N/g' $ERROR_OUTPUTFILE
+	$ECHO -n "" > $EXPECTED_OUTPUTFILE
+	$ECHO -n "" > $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '{' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '  "pid": N,' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '  "unit": "ns",' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '  "commands": {' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '    "/bin/true": {' >> $EXPECTED_ERROR_OUTPUTFILE
+	for phase in tokenize dispatch search_path spawn
+	do
+		$ECHO '      "'$phase'": {"count": ONE, "min": N, "mean": N, "pN": N, "pN": N, "pN": N, "pN": N, "max": N},' >> $EXPECTED_ERROR_OUTPUTFILE
+	done
+	$ECHO '      "wait": {"count": ONE, "min": N, "mean": N, "pN": N, "pN": N, "pN": N, "pN": N, "max": N}' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '    }' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '  }' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO '}' >> $EXPECTED_ERROR_OUTPUTFILE
+	$ECHO -n "0" > $EXPECTED_STATUS
+
+	check_diff
+
+	return $status
+}
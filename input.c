@@ -0,0 +1,116 @@
+#include "main.h"
+
+/**
+ * input_init - Prepare a line reader
+ * @in: The reader
+ * @stream: The stream to read commands from
+ * @prompt: The prompt to display, or NULL when not interactive
+ *
+ * Return: None.
+ */
+void input_init(input_t *in, FILE *stream, char *prompt)
+{
+	memset(in, 0, sizeof(*in));
+	in->stream = stream;
+	in->prompt = prompt;
+	in->line_number = 1;
+}
+
+/**
+ * input_append - Add a line to the command being read
+ * @in: The reader
+ * @line: The line
+ * @len: The length of the line
+ *
+ * Return: None.
+ */
+static void input_append(input_t *in, const char *line, size_t len)
+{
+	char *raw, *work;
+	size_t cap = in->raw_cap ? in->raw_cap : 256;
+
+	while (in->raw_len + len + 1 > cap)
+		cap *= 2;
+	if (cap != in->raw_cap)
+	{
+		raw = realloc(in->raw, cap);
+		work = raw == NULL ? NULL : realloc(in->work, cap);
+		if (raw == NULL || work == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		in->raw = raw;
+		in->work = work;
+		in->raw_cap = cap;
+	}
+	memcpy(in->raw + in->raw_len, line, len);
+	in->raw_len += len;
+}
+
+/**
+ * read_program - Read and compile the next complete command
+ * @in: The reader
+ * @prog: The program to compile into; its previous contents are dropped
+ *
+ * Description: Lines are read until they form a complete command: while
+ * a quote, a compound command or an '&&' is left open, another line is
+ * read, with the "> " prompt when interactive. The lexer rewrites its input
+ * in place, so each attempt works on a copy of the lines read so far. At
+ * the end of the input an unfinished command compiles to a syntax error.
+ *
+ * Return: 0 when a program was compiled, -1 at the end of the input.
+ */
+int read_program(input_t *in, program_t *prog)
+{
+	int first = in->line_number, status = PARSE_INCOMPLETE, at_eof = 0;
+	ssize_t len;
+	uint64_t start;
+
+	in->raw_len = 0;
+	while (status == PARSE_INCOMPLETE)
+	{
+		if (in->prompt != NULL)
+		{
+			printf("%s", in->raw_len == 0 ? in->prompt : "> ");
+			fflush(stdout);
+		}
+		len = getline(&in->line, &in->line_size, in->stream);
+		if (len == -1)
+		{
+			if (in->raw_len == 0)
+				return (-1);
+			at_eof = 1;
+		}
+		else
+		{
+			input_append(in, in->line, (size_t)len);
+			in->line_number++;
+		}
+		memcpy(in->work, in->raw, in->raw_len);
+		in->work[in->raw_len] = '\0';
+		prog->code_len = 0;
+		prog->str_len = 0;
+		start = probe_start();
+		status = parse_program(prog, in->work, in->raw_len, first,
+				       at_eof);
+		probe_name = prog_first_name(prog);
+		probe_line = first;
+		probe_end(PHASE_TOKENIZE, start);
+		probe_name = NULL;
+	}
+	return (0);
+}
+
+/**
+ * input_free - Release the buffers of a line reader
+ * @in: The reader
+ *
+ * Return: None.
+ */
+void input_free(input_t *in)
+{
+	free(in->line);
+	free(in->raw);
+	free(in->work);
+}
@@ -0,0 +1,44 @@
+#include "main.h"
+
+/**
+ * json_escape - Copy a string, escaping it for use in a JSON string
+ * @dst: The buffer to write to
+ * @size: The size of the buffer, including room for the terminating '\0'
+ * @src: The string to escape
+ *
+ * Description: Quotes and backslashes are escaped with a backslash and
+ * control characters are written as \u00XX, so command names taken from
+ * user input always produce valid JSON. The output is truncated, on a
+ * character boundary, if it does not fit in the buffer.
+ *
+ * Return: The length of the escaped string.
+ */
+size_t json_escape(char *dst, size_t size, const char *src)
+{
+	static const char hex[] = "0123456789abcdef";
+	size_t len = 0;
+	unsigned char c;
+
+	for (; *src != '\0'; src++)
+	{
+		c = (unsigned char)*src;
+		if (c < 0x20 && len + 6 < size)
+		{
+			_memcpy(dst + len, "\\u00", 4);
+			dst[len + 4] = hex[c >> 4];
+			dst[len + 5] = hex[c & 15];
+			len += 6;
+		}
+		else if ((c == '"' || c == '\\') && len + 2 < size)
+		{
+			dst[len++] = '\\';
+			dst[len++] = (char)c;
+		}
+		else if (c >= 0x20 && c != '"' && c != '\\' && len + 1 < size)
+			dst[len++] = (char)c;
+		else
+			break;
+	}
+	dst[len] = '\0';
+	return (len);
+}
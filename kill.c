@@ -0,0 +1,183 @@
+#include "main.h"
+
+/**
+ * kill_number - Convert a process ID or an exit status
+ * @str: The decimal number, which may be negative for a process group
+ * @n: Where the number is stored
+ *
+ * Return: 0 on success, -1 if @str is not a number that fits in an int.
+ */
+static int kill_number(const char *str, long *n)
+{
+	const char *p = str + (*str == '-');
+
+	*n = 0;
+	for (; *p >= '0' && *p <= '9' && *n <= INT_MAX; p++)
+		*n = *n * 10 + (*p - '0');
+	if (*p != '\0' || p == str + (*str == '-') || *n > INT_MAX)
+		return (-1);
+	if (*str == '-')
+		*n = -*n;
+	return (0);
+}
+
+/**
+ * kill_print - Print the name of a signal, as 'kill -l' does
+ * @sig: The signal number
+ *
+ * Description: The real-time signals are named from the nearest end of
+ * their range, and signals without a name are printed as numbers.
+ *
+ * Return: None.
+ */
+static void kill_print(int sig)
+{
+	const char *name = signal_name(sig);
+
+	if (name != NULL)
+		printf("%s\n", name);
+	else if (sig == SIGRTMIN || sig == SIGRTMAX)
+		printf("%s\n", sig == SIGRTMIN ? "RTMIN" : "RTMAX");
+	else if (sig > SIGRTMIN && sig - SIGRTMIN <= (SIGRTMAX - SIGRTMIN) / 2)
+		printf("RTMIN+%d\n", sig - SIGRTMIN);
+	else if (sig > SIGRTMIN && sig < SIGRTMAX)
+		printf("RTMAX-%d\n", SIGRTMAX - sig);
+	else
+		printf("%d\n", sig);
+}
+
+/**
+ * kill_list - List the signals, or name the one that ended a command
+ * @arg: NULL to list them all, or a signal number or an exit status
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: An exit status above 128 is that of a command killed by
+ * the signal 128 less.
+ *
+ * Return: 0 on success, 2 after reporting an error.
+ */
+static int kill_list(const char *arg, int line_number, char *program_name)
+{
+	long n;
+	int sig;
+
+	if (arg == NULL)
+	{
+		for (sig = 0; sig < NSIG; sig++)
+			kill_print(sig);
+		return (0);
+	}
+	if (kill_number(arg, &n) == -1)
+	{
+		fprintf(stderr, "%s: %d: kill: Illegal number: %s\n",
+			program_name, line_number, arg);
+		return (2);
+	}
+	if (n > 128)
+		n -= 128;
+	if (n <= 0 || n >= NSIG)
+	{
+		fprintf(stderr, "%s: %d: kill: invalid signal number or exit "
+			"status: %s\n", program_name, line_number, arg);
+		return (2);
+	}
+	kill_print((int)n);
+	return (0);
+}
+
+/**
+ * kill_signal - Parse the signal option of kill
+ * @tokens: The command and its arguments
+ * @sig: Set to the signal, SIGTERM by default
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: The signal is given as '-s name', '-sname', '-name' or
+ * '-number', names with or without "SIG" and in any case, and may be
+ * followed by '--'.
+ *
+ * Return: The index of the first operand, or -1 after reporting an error.
+ */
+static int kill_signal(char **tokens, int *sig, int line_number,
+		       char *program_name)
+{
+	const char *arg = tokens[1], *name = arg + 1;
+	int i;
+
+	*sig = SIGTERM;
+	if (arg[0] != '-' || arg[1] == '\0')
+		return (1);
+	if (_strcmp(arg, "--") == 0)
+		return (2);
+	if (arg[1] == 's' && arg[2] == '\0' && tokens[2] == NULL)
+	{
+		fprintf(stderr, "%s: %d: kill: No arg for -s option\n",
+			program_name, line_number);
+		return (-1);
+	}
+	if (arg[1] == 's')
+		name = arg[2] != '\0' ? arg + 2 : tokens[2];
+	*sig = signal_from_name(name);
+	if (*sig == -1 && arg[1] == 's')
+		fprintf(stderr, "%s: %d: kill: invalid signal number or name: "
+			"%s\n", program_name, line_number, name);
+	else if (*sig == -1)
+		fprintf(stderr, "%s: %d: kill: Illegal option -%c\n",
+			program_name, line_number, arg[1]);
+	if (*sig == -1)
+		return (-1);
+	i = arg[1] == 's' && arg[2] == '\0' ? 3 : 2;
+	return (tokens[i] != NULL && _strcmp(tokens[i], "--") == 0 ? i + 1 : i);
+}
+
+/**
+ * builtin_kill - Send a signal to processes
+ * @tokens: The command, the signal and the process IDs, or '-l' and an
+ * optional exit status
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: A negative ID stands for a process group. This shell runs
+ * no job in the background, so any job spec, such as '%1', names no job.
+ * The messages are those of /bin/sh.
+ *
+ * Return: 0 on success, 1 if a signal could not be sent, 2 on a usage
+ * error.
+ */
+int builtin_kill(char **tokens, int line_number, char *program_name)
+{
+	int sig = SIGTERM, i = 1, status = 0;
+	long pid;
+
+	if (tokens[1] != NULL && _strcmp(tokens[1], "-l") == 0)
+		return (kill_list(tokens[2], line_number, program_name));
+	if (tokens[1] != NULL)
+		i = kill_signal(tokens, &sig, line_number, program_name);
+	if (i == -1)
+		return (2);
+	if (tokens[i] == NULL)
+	{
+		fprintf(stderr, "%s: %d: kill: Usage: kill [-s sigspec | "
+			"-signum | -sigspec] [pid | job]... or\nkill -l "
+			"[exitstatus]\n", program_name, line_number);
+		return (2);
+	}
+	for (; tokens[i] != NULL; i++)
+	{
+		if (tokens[i][0] == '%' || kill_number(tokens[i], &pid) == -1)
+		{
+			fprintf(stderr, "%s: %d: kill: %s: %s\n", program_name,
+				line_number, tokens[i][0] == '%' ?
+				"No such job" : "Illegal number", tokens[i]);
+			return (2);
+		}
+		if (kill((pid_t)pid, sig) == -1)
+		{
+			fprintf(stderr, "%s: %d: kill: %s\n", program_name,
+				line_number, strerror(errno));
+			status = 1;
+		}
+	}
+	return (status);
+}
@@ -0,0 +1,176 @@
+#include "main.h"
+
+/**
+ * lex_squote - Read a single-quoted string
+ * @lx: The lexer, positioned on the opening quote
+ *
+ * Description: The quotes are replaced by CTL_SQ and the text between them
+ * is kept as it is, since nothing is special inside single quotes.
+ *
+ * Return: 0 on success, -1 if the closing quote is missing.
+ */
+int lex_squote(lexer_t *lx)
+{
+	*lx->out++ = CTL_SQ;
+	lx->pos++;
+	while (lx->pos < lx->end && *lx->pos != '\'')
+	{
+		if (*lx->pos == '\n')
+			lx->line++;
+		*lx->out++ = *lx->pos++;
+	}
+	if (lx->pos == lx->end)
+		return (-1);
+	*lx->out++ = CTL_SQ;
+	lx->pos++;
+	lx->flags |= WORD_QUOTED;
+	return (0);
+}
+
+/**
+ * lex_dquote - Read a double-quoted string
+ * @lx: The lexer, positioned on the opening quote
+ *
+ * Description: The quotes are replaced by CTL_DQ. Inside them a backslash
+ * only quotes '$', '`', '"', '\' and newline, and substitutions are
+ * still recognized.
+ *
+ * Return: 0 on success, -1 if the closing quote is missing.
+ */
+int lex_dquote(lexer_t *lx)
+{
+	int ret = 0;
+
+	*lx->out++ = CTL_DQ;
+	lx->pos++;
+	while (ret == 0 && lx->pos < lx->end && *lx->pos != '"')
+	{
+		if (*lx->pos == '\\' && lx->pos + 1 < lx->end &&
+		    lx->pos[1] == '\n')
+			lx->pos += 2, lx->line++;
+		else if (*lx->pos == '\\' && lx->pos + 1 < lx->end &&
+			 _strchr("$`\"\\", lx->pos[1]) != NULL)
+		{
+			*lx->out++ = CTL_ESC;
+			*lx->out++ = lx->pos[1];
+			lx->pos += 2;
+		}
+		else if (*lx->pos == '$')
+			ret = lex_dollar(lx);
+		else if (*lx->pos == '`')
+			ret = lex_backquote(lx);
+		else
+		{
+			if (*lx->pos == '\n')
+				lx->line++;
+			*lx->out++ = *lx->pos++;
+		}
+	}
+	if (ret != 0 || lx->pos == lx->end)
+		return (-1);
+	*lx->out++ = CTL_DQ;
+	lx->pos++;
+	lx->flags |= WORD_QUOTED;
+	return (0);
+}
+
+/**
+ * lex_balanced - Copy a bracketed substitution up to its closing bracket
+ * @lx: The lexer, positioned on the opening bracket
+ * @open: The opening bracket
+ * @close: The closing bracket
+ *
+ * Description: Nested brackets, quoted strings and backslash escapes are
+ * skipped over, so "$(echo ')')" ends at the right parenthesis.
+ *
+ * Return: 0 on success, -1 if the closing bracket is missing.
+ */
+static int lex_balanced(lexer_t *lx, char open, char close)
+{
+	int depth = 0;
+	char c;
+
+	while (lx->pos < lx->end)
+	{
+		c = *lx->pos;
+		if (c == '\'' || c == '"')
+		{
+			*lx->out++ = *lx->pos++;
+			while (lx->pos < lx->end && *lx->pos != c)
+			{
+				if (c == '"' && *lx->pos == '\\' &&
+				    lx->pos + 1 < lx->end)
+					*lx->out++ = *lx->pos++;
+				if (*lx->pos == '\n')
+					lx->line++;
+				*lx->out++ = *lx->pos++;
+			}
+			if (lx->pos == lx->end)
+				return (-1);
+		}
+		else if (c == '\\' && lx->pos + 1 < lx->end)
+			*lx->out++ = *lx->pos++;
+		else if (c == open)
+			depth++;
+		else if (c == close && --depth == 0)
+		{
+			*lx->out++ = *lx->pos++;
+			return (0);
+		}
+		if (*lx->pos == '\n')
+			lx->line++;
+		*lx->out++ = *lx->pos++;
+	}
+	return (-1);
+}
+
+/**
+ * lex_dollar - Read a '$' and the substitution it may start
+ * @lx: The lexer, positioned on the '$'
+ *
+ * Description: "${...}", "$(...)" and "$((...))" are copied up to their
+ * closing bracket. A '$' followed by a name or a special parameter marks
+ * the word with WORD_DOLLAR; any other '$' is an ordinary character.
+ *
+ * Return: 0 on success, -1 if a substitution is not terminated.
+ */
+int lex_dollar(lexer_t *lx)
+{
+	char c = lx->pos + 1 < lx->end ? lx->pos[1] : '\0';
+
+	if (c == '(' || c == '{')
+	{
+		lx->flags |= WORD_DOLLAR;
+		*lx->out++ = *lx->pos++;
+		return (lex_balanced(lx, c, c == '(' ? ')' : '}'));
+	}
+	if (c == '_' || isalnum((unsigned char)c) ||
+	    (c != '\0' && _strchr("@*#?-$!", c) != NULL))
+		lx->flags |= WORD_DOLLAR;
+	*lx->out++ = *lx->pos++;
+	return (0);
+}
+
+/**
+ * lex_backquote - Copy an old-style `...` command substitution
+ * @lx: The lexer, positioned on the opening backquote
+ *
+ * Return: 0 on success, -1 if the closing backquote is missing.
+ */
+int lex_backquote(lexer_t *lx)
+{
+	*lx->out++ = *lx->pos++;
+	while (lx->pos < lx->end && *lx->pos != '`')
+	{
+		if (*lx->pos == '\\' && lx->pos + 1 < lx->end)
+			*lx->out++ = *lx->pos++;
+		if (*lx->pos == '\n')
+			lx->line++;
+		*lx->out++ = *lx->pos++;
+	}
+	if (lx->pos == lx->end)
+		return (-1);
+	*lx->out++ = *lx->pos++;
+	lx->flags |= WORD_DOLLAR;
+	return (0);
+}
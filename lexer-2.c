@@ -0,0 +1,36 @@
+#include "main.h"
+
+/**
+ * lex_backslash - Read a backslash in a word
+ * @lx: The lexer, positioned on the backslash
+ *
+ * Description: The backslash and the character it quotes become CTL_ESC
+ * and that character. A backslash-newline is removed, and one that ends
+ * the input is kept as it is when no input can follow.
+ *
+ * Return: 0 on success, -1 if the word may go on in input still to come.
+ */
+int lex_backslash(lexer_t *lx)
+{
+	if (lx->pos + 1 == lx->end)
+	{
+		if (!lx->at_eof)
+			return (-1);
+		*lx->out++ = *lx->pos++;
+	}
+	else if (lx->pos[1] == '\n')
+	{
+		lx->pos += 2;
+		lx->line++;
+		if (lx->pos == lx->end && !lx->at_eof)
+			return (-1);
+	}
+	else
+	{
+		*lx->out++ = CTL_ESC;
+		*lx->out++ = lx->pos[1];
+		lx->pos += 2;
+		lx->flags |= WORD_QUOTED;
+	}
+	return (0);
+}
@@ -0,0 +1,187 @@
+#include "main.h"
+
+/**
+ * lex_init - Prepare the lexer to read a buffer
+ * @lx: The lexer
+ * @buf: The input; words are rewritten in place, so it must be writable
+ * @len: The length of the input
+ * @line: The line number of the first line of the input
+ * @at_eof: Non-zero if no input can follow, so that constructs left open
+ * at the end are errors instead of a request for more input
+ *
+ * Return: None.
+ */
+void lex_init(lexer_t *lx, char *buf, size_t len, int line, int at_eof)
+{
+	lx->pos = buf;
+	lx->out = buf;
+	lx->end = buf + len;
+	lx->line = line;
+	lx->at_eof = at_eof;
+	lx->incomplete = 0;
+	lx->flags = 0;
+}
+
+/**
+ * is_meta - Check if a character ends an unquoted word
+ * @c: The character
+ *
+ * Return: 1 for blanks, newlines and operator characters, 0 otherwise.
+ */
+static int is_meta(char c)
+{
+	switch (c)
+	{
+	case ' ': case '\t': case '\n': case ';': case '&': case '|':
+	case '<': case '>': case '(': case ')':
+		return (1);
+	}
+	return (0);
+}
+
+/**
+ * lex_operator - Read an operator
+ * @lx: The lexer, positioned on an operator character
+ * @tok: The token to fill in
+ *
+ * Description: The table is ordered so that the longest operator starting
+ * at the current position is found first.
+ *
+ * Return: The type of the operator.
+ */
+static int lex_operator(lexer_t *lx, token_t *tok)
+{
+	static const struct
+	{
+		const char *text;
+		int type;
+	} ops[] = {
+		{"<<<", TOK_TLESS}, {"<<-", TOK_DLESSDASH}, {"&&", TOK_AND_IF},
+		{"||", TOK_OR_IF}, {";;", TOK_DSEMI}, {"<<", TOK_DLESS},
+		{">>", TOK_DGREAT}, {"<&", TOK_LESSAND}, {">&", TOK_GREATAND},
+		{"<>", TOK_LESSGREAT}, {">|", TOK_CLOBBER}, {"<", TOK_LESS},
+		{">", TOK_GREAT}, {"&", TOK_AMP}, {"|", TOK_PIPE},
+		{";", TOK_SEMI}, {"(", TOK_LPAREN}, {")", TOK_RPAREN},
+		{NULL, 0}
+	};
+	size_t i, len, left = (size_t)(lx->end - lx->pos);
+
+	for (i = 0; ops[i].text != NULL; i++)
+	{
+		len = strlen(ops[i].text);
+		if (len <= left && _strncmp(lx->pos, ops[i].text, len) == 0)
+			break;
+	}
+	tok->len = strlen(ops[i].text);
+	lx->pos += tok->len;
+	return (ops[i].type);
+}
+
+/**
+ * lex_word - Read a word, rewriting it in place
+ * @lx: The lexer, positioned on the first character of the word
+ * @tok: The token to fill in
+ *
+ * Description: The word is copied onto itself with every quote replaced
+ * by a marker: a backslash becomes CTL_ESC, and single and double quotes
+ * become CTL_SQ and CTL_DQ around the quoted text. A backslash-newline is
+ * removed. None of these rewrites makes the text longer, so the word never
+ * overtakes the input that is still to be read and no memory is
+ * allocated. Substitutions are kept as they are written, to be parsed when
+ * they are expanded.
+ *
+ * Return: TOK_WORD, TOK_IO_NUMBER, or TOK_ERROR if a quote or
+ * substitution is not terminated.
+ */
+static int lex_word(lexer_t *lx, token_t *tok)
+{
+	int ret = 0, digits = 1;
+
+	lx->out = lx->pos;
+	lx->flags = 0;
+	while (ret == 0 && lx->pos < lx->end && !is_meta(*lx->pos))
+	{
+		if (*lx->pos < '0' || *lx->pos > '9')
+			digits = 0;
+		if (*lx->pos == '\\')
+			ret = lex_backslash(lx);
+		else if (*lx->pos == '\'')
+			ret = lex_squote(lx);
+		else if (*lx->pos == '"')
+			ret = lex_dquote(lx);
+		else if (*lx->pos == '$')
+			ret = lex_dollar(lx);
+		else if (*lx->pos == '`')
+			ret = lex_backquote(lx);
+		else
+		{
+			if (*lx->pos == '*' || *lx->pos == '?' ||
+			    *lx->pos == '[')
+				lx->flags |= WORD_GLOB;
+			else if (*lx->pos == '~')
+				lx->flags |= WORD_TILDE;
+			*lx->out++ = *lx->pos++;
+		}
+	}
+	tok->len = (size_t)(lx->out - tok->start);
+	tok->flags = lx->flags;
+	if (ret != 0)
+		return (TOK_ERROR);
+	if (digits && tok->len > 0 && lx->pos < lx->end &&
+	    (*lx->pos == '<' || *lx->pos == '>'))
+		return (TOK_IO_NUMBER);
+	return (TOK_WORD);
+}
+
+/**
+ * lex_next - Read the next token
+ * @lx: The lexer
+ * @tok: The token to fill in
+ *
+ * Description: Blanks, backslash-newlines and comments before the token
+ * are skipped. When the input ends inside a quote, a substitution or after
+ * a backslash-newline and more input may follow, lx->incomplete is set and
+ * TOK_ERROR is returned, so the caller can read another line and lex the
+ * command again.
+ *
+ * Return: The type of the token.
+ */
+int lex_next(lexer_t *lx, token_t *tok)
+{
+	int continued = 0;
+
+	while (lx->pos < lx->end)
+	{
+		continued = 0;
+		if (*lx->pos == ' ' || *lx->pos == '\t')
+			lx->pos++;
+		else if (*lx->pos == '\\' && lx->pos + 1 < lx->end &&
+			 lx->pos[1] == '\n')
+			lx->pos += 2, lx->line++, continued = 1;
+		else if (*lx->pos == '#')
+			while (lx->pos < lx->end && *lx->pos != '\n')
+				lx->pos++;
+		else
+			break;
+	}
+	tok->start = lx->pos;
+	tok->line = lx->line;
+	tok->flags = 0;
+	tok->len = 0;
+	if (lx->pos == lx->end)
+		tok->type = continued && !lx->at_eof ? TOK_ERROR : TOK_EOF;
+	else if (*lx->pos == '\n')
+	{
+		tok->type = TOK_NEWLINE;
+		tok->len = 1;
+		lx->pos++;
+		lx->line++;
+	}
+	else if (is_meta(*lx->pos))
+		tok->type = lex_operator(lx, tok);
+	else
+		tok->type = lex_word(lx, tok);
+	if (tok->type == TOK_ERROR && !lx->at_eof)
+		lx->incomplete = 1;
+	return (tok->type);
+}
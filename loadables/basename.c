@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <string.h>
+#include "hsh_builtin.h"
+
+/**
+ * basename_run - Print the last component of a path
+ * @argc: Number of arguments
+ * @argv: 'basename', the path and an optional suffix to remove
+ *
+ * Description: The POSIX basename utility, as a loadable builtin: trailing
+ * slashes are ignored, a path made of slashes only gives '/', and the
+ * suffix is removed unless it is the whole component. Load it with
+ * 'enable -f ./basename.so basename' after building it with
+ * 'gcc -shared -fPIC -o basename.so basename.c'.
+ *
+ * Return: 0 on success, 1 on a usage error.
+ */
+static int basename_run(int argc, char **argv)
+{
+	const char *path, *p;
+	size_t len, slen;
+
+	if (argc > 1 && strcmp(argv[1], "--") == 0)
+		argc--, argv++;
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "basename: %s\n", argc < 2 ?
+			"missing operand" : "extra operand");
+		return (1);
+	}
+	path = argv[1];
+	len = strlen(path);
+	while (len > 1 && path[len - 1] == '/')
+		len--;
+	if (len == 1 && path[0] == '/')
+		p = path;
+	else
+		for (p = path + len; p > path && p[-1] != '/'; p--)
+			;
+	len -= (size_t)(p - path);
+	slen = argc == 3 ? strlen(argv[2]) : 0;
+	if (slen > 0 && slen < len &&
+	    memcmp(p + len - slen, argv[2], slen) == 0)
+		len -= slen;
+	printf("%.*s\n", (int)len, p);
+	return (0);
+}
+
+/* The builtin, as enable looks it up */
+const hsh_builtin_t basename_hsh_builtin = {
+	HSH_BUILTIN_ABI, basename_run, NULL, NULL
+};
@@ -0,0 +1,49 @@
+#ifndef HSH_BUILTIN_H
+#define HSH_BUILTIN_H
+
+/*
+ * The interface of the builtins hsh loads from shared objects with
+ * 'enable -f FILE NAME'. The object exports, for each builtin NAME, a
+ * variable of type hsh_builtin_t named NAME_hsh_builtin:
+ *
+ *	const hsh_builtin_t hello_hsh_builtin = {
+ *		HSH_BUILTIN_ABI, hello_run, NULL, NULL
+ *	};
+ *
+ * and is built with 'gcc -shared -fPIC'. See basename.c for an example.
+ *
+ * The builtin runs in the shell process, with the redirections of its
+ * command applied to the descriptors 0, 1 and 2. It may write with stdio
+ * or with write(2): the shell flushes stdout when it returns. It must not
+ * call exit, which would end the shell, nor keep the arguments once it
+ * returns. optind is reset before each call, so getopt can be used.
+ *
+ * The structure only grows at its end, and HSH_BUILTIN_ABI changes when it
+ * does, so a builtin built against an older version keeps loading.
+ */
+
+/* Version of the interface, as the builtin was compiled with it */
+#define HSH_BUILTIN_ABI 1
+
+/* Suffix of the name of the variable a shared object exports */
+#define HSH_BUILTIN_SUFFIX "_hsh_builtin"
+
+/**
+ * struct hsh_builtin_s - A builtin in a shared object
+ * @abi: HSH_BUILTIN_ABI
+ * @run: Runs the builtin; argv[0] is the name it was called by and
+ * argv[argc] is NULL. It returns the exit status of the command.
+ * @load: Called once when the builtin is loaded, or NULL; a non-zero
+ * return refuses the load
+ * @unload: Called when the builtin is removed, before the object is
+ * closed, or NULL
+ */
+typedef struct hsh_builtin_s
+{
+	int abi;
+	int (*run)(int argc, char **argv);
+	int (*load)(void);
+	void (*unload)(void);
+} hsh_builtin_t;
+
+#endif /* HSH_BUILTIN_H */
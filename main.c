@@ -1,73 +1,42 @@
-#define PATH_SEPARATOR " \t\r\n"
-
 #include "main.h"
 
 /* Global Variables */
-int status = 0;
+int last_status;
+int exit_requested;
+int interactive;
+int noexec;
+/* The value of '$0': the script being run, or the shell itself */
+char *shell_name;
+/* The value of '$$' */
+pid_t shell_pid;
 
 /**
  * noninteractive_mode - Execute shell commands in non-interactive mode
  * @program_name: Name of the shell program
  *
  * Description: This function reads shell commands from stdin in
- * non-interactive mode and executes them accordingly. It uses the getline
- * function to read input from stdin and tokenizes each line of input using the
- * tokenize function.
- * It then checks the first token to determine the appropriate action:
- *   - If the first token is 'echo $PATH', it calls the execute_echo_path
- *     function.
- *   - If the first token is 'env', it calls the execute_env function.
- *   - If the first token is 'exit', it calls the execute_exit function with
- *     the second token as the argument. If no argument is provided, the status
- *     code is set to 0 indicating successful termination.
- *   - If the first token is 'setenv', it calls the _setenv function with the
- *     corresponding arguments.
- *   - If the first token is 'unsetenv', it calls the _unsetenv function with
- *     the corresponding argument.
- *   - For any other command, it calls the execute_command function to execute
- *     a generic command.
- * The function continues reading and executing commands until the end of input
- * is reached. It frees the memory allocated for tokens and the input buffer
- * before returning.
+ * non-interactive mode and executes them accordingly. read_program reads
+ * lines with getline until they form a complete command and compiles it,
+ * and run_program executes the result, handing every simple command to
+ * dispatch_command. The exit status of every command is stored in
+ * last_status.
+ * The function continues reading and executing commands until the end of
+ * input is reached or the exit builtin has run. It frees the compiled
+ * program and the input buffers before returning.
  *
  * Return: This function does not return a value.
  */
 void noninteractive_mode(char *program_name)
 {
-	char *buf = NULL;
-	size_t n = 0;
-	ssize_t val;
-	char **tokens;
-	int line_number = 1, status;
-
-	while ((val = getline(&buf, &n, stdin)) != -1)
-	{
-		tokens = tokenize(buf);
-		if (tokens == NULL)
-			continue;
-
-		if (strcmp(tokens[0], "echo") == 0 && strcmp(tokens[1], "$PATH") == 0)
-			execute_echo_path();
-		else if (strcmp(tokens[0], "env") == 0)
-			execute_env();
-		else if (strcmp(tokens[0], "exit") == 0)
-		{
-			status = execute_exit(tokens[1], line_number, program_name);
-			free(tokens);
-			free(buf);
-			exit(status);
-		}
-		else if (strcmp(tokens[0], "setenv") == 0)
-			_setenv(tokens[1], tokens[2]);
-		else if (strcmp(tokens[0], "unsetenv") == 0)
-			_unsetenv(tokens[1]);
-		else
-			execute_command(tokens, line_number, program_name);
+	input_t in;
+	program_t prog;
 
-		free(tokens);
-		line_number++;
-	}
-	free(buf);
+	memset(&prog, 0, sizeof(prog));
+	input_init(&in, stdin, NULL);
+	while (!exit_requested && read_program(&in, &prog) == 0)
+		run_program(&prog, program_name);
+	prog_free(&prog);
+	input_free(&in);
 }
 
 /**
@@ -77,69 +46,28 @@ void noninteractive_mode(char *program_name)
  *
  * Description: This function runs the shell program in interactive mode,
  * where it prompts the user for input and executes the corresponding shell
- * commands. It displays the specified prompt before each user input. The
- * function uses the getline function to read input from stdin and tokenizes
- * each line of input using the tokenize function. It then checks the first
- * token to determine the appropriate action:
- *   - If the first token is 'echo $PATH', it calls the execute_echo_path
- *     function.
- *   - If the first token is 'env', it calls the execute_env function.
- *   - If the first token is 'exit', it calls the execute_exit function with
- *     the second token as the argument. The function breaks out of the loop
- *     and terminates the shell program.
- *   - If the first token is 'setenv', it calls the _setenv function with the
- *     corresponding arguments.
- *   - If the first token is 'unsetenv', it calls the _unsetenv function with
- *     the corresponding argument.
- *   - For any other command, it calls the execute_command function to execute
- *     a generic command.
- * The function continues prompting for input and executing commands until the
- * user terminates the program by entering the 'exit' command. It frees the
- * memory allocated for tokens and the input buffer before returning.
+ * commands. It displays the specified prompt before each command, and the
+ * "> " prompt while a command continues on the next line. Commands are
+ * read, compiled and run like in non-interactive mode, except that a
+ * syntax error does not terminate the shell.
+ * The function continues prompting for input and executing commands until
+ * the end of input or until the user enters the 'exit' command. It frees
+ * the compiled program and the input buffers before returning.
  *
  * Return: This function does not return a value.
  */
 void interactive_mode(char *prompt, char *program_name)
 {
-	char *buf = NULL;
-	size_t n = 0;
-	ssize_t val;
-	char **tokens;
-	int line_number = 1;
+	input_t in;
+	program_t prog;
 
-	while (1)
-	{
-		printf("%s", prompt);
-		fflush(stdout);
-		val = getline(&buf, &n, stdin);
-		if (val == -1)
-			break;
-		tokens = tokenize(buf);
-		if (tokens[0] == NULL)
-		{
-			free(tokens);
-			continue;
-		}
-		line_number++;
-		if (strcmp(tokens[0], "echo") == 0 && strcmp(tokens[1], "$PATH") == 0)
-			execute_echo_path();
-		else if (strcmp(tokens[0], "env") == 0)
-			execute_env();
-		else if (strcmp(tokens[0], "exit") == 0)
-		{
-			execute_exit(tokens[1], line_number, program_name);
-			free(tokens);
-			break;
-		}
-		else if (strcmp(tokens[0], "setenv") == 0)
-			_setenv(tokens[1], tokens[2]);
-		else if (strcmp(tokens[0], "unsetenv") == 0)
-			_unsetenv(tokens[1]);
-		else
-			execute_command(tokens, line_number, program_name);
-		free(tokens);
-	}
-	free(buf);
+	interactive = 1;
+	memset(&prog, 0, sizeof(prog));
+	input_init(&in, stdin, prompt);
+	while (!exit_requested && read_program(&in, &prog) == 0)
+		run_program(&prog, program_name);
+	prog_free(&prog);
+	input_free(&in);
 }
 
 /**
@@ -148,22 +76,54 @@ void interactive_mode(char *prompt, char *program_name)
  * @argv: Array of command-line arguments
  *
  * Description: This function is the entry point of the shell program.
- * It checks if the program is running in interactive mode or non-interactive
- * mode based on whether stdin is associated with a terminal. If stdin is not a
+ * The options are '-n', which reads and checks commands without executing
+ * them, and '--trace=FILE', which writes a Chrome trace of every line the
+ * shell processes to FILE. The first other argument names a script,
+ * which is run by script_mode; '-' names the standard input, and the
+ * arguments after the script are not options but its positional
+ * parameters.
+ * Without a script, it checks if the program is running in interactive mode
+ * or non-interactive mode based on whether stdin is associated with a
+ * terminal. If stdin is not a
  * terminal, the program runs in non-interactive mode by calling the
  * noninteractive_mode function with the program name. If stdin is a terminal,
  * the program runs in interactive mode by calling the interactive_mode
  * function with the specified prompt and program name.
- * The function returns 0 upon successful completion.
+ * The environment is imported into the variable table and the builtins
+ * into the command table first, and latency statistics are enabled if
+ * HSH_STATS is set.
+ * The function returns the status of the last command that was executed,
+ * like /bin/sh does when it reaches the end of its input.
  *
- * Return: 0 upon successful completion.
+ * Return: The exit status of the last command.
  */
 int main(int argc, char **argv)
 {
 	char *prompt = "hsh: $ ";
-	(void)argc;
+	param_frame_t script_params;
+	int i = shell_options(argc, argv);
 
-	if (!isatty(STDIN_FILENO))
+	if (i == -1)
+		return (2);
+	vars_init();
+	builtins_register();
+	stats_init();
+	shell_name = argv[0];
+	shell_pid = getpid();
+	if (i < argc)
+	{
+		if (_strcmp(argv[i], "-") != 0)
+			shell_name = argv[i];
+		script_params.argv = argv + i + 1;
+		script_params.argc = argc - i - 1;
+		script_params.prev = NULL;
+		params = &script_params;
+	}
+	if (i < argc && _strcmp(argv[i], "-") != 0)
+	{
+		last_status = script_mode(argv[i], argv[0]);
+	}
+	else if (!isatty(STDIN_FILENO))
 	{
 		noninteractive_mode(argv[0]);
 	}
@@ -172,49 +132,111 @@ int main(int argc, char **argv)
 		interactive_mode(prompt, argv[0]);
 	}
 
-	return (0);
+	return (last_status);
 }
 
 /**
- * tokenize - Split a string into tokens
- * @input: The string to be tokenized
+ * dispatch_shell - Run a builtin or a function in the shell process
+ * @cmd: Its entry in the command table
+ * @tokens: The command and its arguments
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ * @start: When the dispatch started, for the probes
  *
- * Description: This function receives a string and splits it into tokens based
- * on the delimiters " " and "\n". It uses the _strtok function to do the
- * tokenization and stores the tokens in a dynamically allocated
- * array of strings. The tokens are separated by NULL.
- * The function returns a pointer to the array of strings.
+ * Description: The redirections of the command, if any, are applied
+ * around it with redir_apply and redir_restore. They are taken from
+ * redir_pending first, so the commands the builtin or function runs do not
+ * apply them again. What a builtin wrote to the buffer of the standard
+ * output is flushed once it returns, in a single write, so it comes out
+ * in order with the error messages of the next commands, as in /bin/sh;
+ * if it cannot be written, the status of the builtin is 1.
  *
- * Return: A pointer to a dynamically allocated array of strings (tokens).
- * If there is a memory allocation error, the function returns NULL.
+ * Return: The exit status of the command, or 2 if a redirection failed.
  */
-char **tokenize(char *input)
+static int dispatch_shell(command_t *cmd, char **tokens, int line_number,
+			  char *program_name, uint64_t start)
 {
-	char **tokens = malloc(BUFSIZE * sizeof(char *));
-	char *token;
-	int i;
+	redir_list_t *rl = redir_pending;
+	int status = 2;
 
-	i = 0;
-	if (!tokens)
+	redir_pending = NULL;
+	if (rl != NULL && redir_apply(rl) == -1)
+		probe_end(PHASE_DISPATCH, start);
+	else if (cmd->function != NULL && !cmd->special)
 	{
-		perror("Memory allocation error");
-		free(tokens);
-		exit(EXIT_FAILURE);
+		probe_end(PHASE_DISPATCH, start);
+		status = func_call(cmd->function, tokens, program_name);
 	}
-
-	token = strtok(input, PATH_SEPARATOR);
-	while (token != NULL)
+	else
 	{
-		tokens[i] = token;
-		i++;
-		token = strtok(NULL, PATH_SEPARATOR);
+		status = cmd->builtin->func(tokens, line_number, program_name);
+		if (builtin_flush(tokens[0], line_number, program_name) == -1)
+			status = 1;
+		probe_end(PHASE_DISPATCH, start);
 	}
+	if (rl != NULL)
+		redir_restore(rl);
+	return (status);
+}
 
-	tokens[i] = NULL;
-	if (i == 0)
+/**
+ * dispatch_command - Run a tokenized command line
+ * @tokens: Array of strings representing the command and its arguments
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: This function is the single place where both modes hand a
+ * command over for execution, its words already expanded. The name is
+ * looked up in the command table, a single hash probe that finds aliases,
+ * functions and builtins: aliases come first, expanded by alias_dispatch,
+ * but only for a literal name, whose site run_command or an alias gives
+ * through alias_pending, then special builtins, then functions, which are
+ * run by func_call, then the other builtins, all of them by
+ * dispatch_shell. Only the remaining commands are searched in PATH and run
+ * as external programs by execute_command, which applies the redirections
+ * in the child. The probes measured while the command runs are
+ * attributed to its name. A command of another line than the last one
+ * moves stat_epoch on, so the checks of test only share their stat calls
+ * within a line, even when they are in the body of a function called from
+ * several lines.
+ *
+ * Return: The exit status of the command.
+ */
+int dispatch_command(char **tokens, int line_number, char *program_name)
+{
+	static int last_line;
+	alias_site_t *site = alias_pending;
+	command_t *cmd;
+	alias_t *a = NULL;
+	const char *saved_name = probe_name;
+	uint64_t start = probe_start();
+	int status;
+
+	alias_pending = NULL;
+	if (line_number != last_line)
+	{
+		last_line = line_number;
+		stat_epoch++;
+	}
+	probe_name = tokens[0];
+	cmd = cmd_lookup(tokens[0], 0);
+	if (site != NULL)
+		a = alias_find(site, cmd);
+	if (a != NULL && !a->busy)
+	{
+		probe_end(PHASE_DISPATCH, start);
+		status = alias_dispatch(a, tokens, site->lit, line_number,
+					program_name);
+	}
+	else if (cmd != NULL && (cmd->builtin != NULL ||
+			    (cmd->function != NULL && !cmd->special)))
+		status = dispatch_shell(cmd, tokens, line_number, program_name,
+					start);
+	else
 	{
-		free(tokens);
-		tokens = NULL;
+		probe_end(PHASE_DISPATCH, start);
+		status = execute_command(tokens, line_number, program_name);
 	}
-	return (tokens);
+	probe_name = saved_name;
+	return (status);
 }
@@ -15,13 +15,1501 @@
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sched.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <limits.h>
+#include <pwd.h>
+#include <dirent.h>
+#include <sys/sendfile.h>
+#include <dlfcn.h>
+#include "loadables/hsh_builtin.h"
+
+/* Structures */
+
+/**
+ * struct builtin_s - Maps a builtin name to the function implementing it
+ * @name: The command name typed by the user
+ * @func: The function to call; it returns the exit status of the command
+ */
+typedef struct builtin_s
+{
+	char *name;
+	int (*func)(char **tokens, int line_number, char *program_name);
+} builtin_t;
+
+/**
+ * struct spawn_attr_s - Scheduling settings applied to spawned commands
+ * @cpus: CPUs the command may run on, used when @has_cpus is set
+ * @has_cpus: Whether @cpus is applied with sched_setaffinity
+ * @nice: Increment passed to nice(), used when @has_nice is set
+ * @has_nice: Whether @nice is applied
+ * @policy: Scheduling policy, or -1 to keep the inherited one
+ * @priority: Static priority for SCHED_FIFO and SCHED_RR
+ *
+ * Description: spawn_command copies the current settings before forking and
+ * applies them in the child between fork and execve, so the shell itself
+ * keeps its own affinity and priority.
+ */
+typedef struct spawn_attr_s
+{
+	cpu_set_t cpus;
+	int has_cpus;
+	int nice;
+	int has_nice;
+	int policy;
+	int priority;
+} spawn_attr_t;
+
+/**
+ * enum phase_e - Stages of command execution measured by the probes
+ * @PHASE_TOKENIZE: Splitting the input line into tokens
+ * @PHASE_DISPATCH: Finding the command in the builtin table, and running
+ * it when it is a builtin
+ * @PHASE_LOOKUP: Searching the PATH directories for the command
+ * @PHASE_SPAWN: Forking the child, measured in the parent
+ * @PHASE_WAIT: Waiting for the child to terminate
+ * @PHASE_COUNT: Number of phases
+ */
+enum phase_e
+{
+	PHASE_TOKENIZE,
+	PHASE_DISPATCH,
+	PHASE_LOOKUP,
+	PHASE_SPAWN,
+	PHASE_WAIT,
+	PHASE_COUNT
+};
+
+/**
+ * struct cmd_timing_s - Measurements collected by the 'time' builtin
+ * @phase_ns: Time spent in each phase, indexed by enum phase_e
+ * @usage: Resource usage of the children reaped while timing, summed
+ * @children: Number of children reaped while timing
+ */
+typedef struct cmd_timing_s
+{
+	uint64_t phase_ns[PHASE_COUNT];
+	struct rusage usage;
+	int children;
+} cmd_timing_t;
+
+#define HIST_BUCKETS 976
+
+/**
+ * struct histogram_s - Log-linear latency histogram of one phase
+ * @count: Number of samples
+ * @sum: Sum of all samples, in nanoseconds
+ * @min: Smallest sample
+ * @max: Largest sample
+ * @buckets: Sample counts, see stats_record for the bucket layout
+ */
+typedef struct histogram_s
+{
+	uint64_t count;
+	uint64_t sum;
+	uint64_t min;
+	uint64_t max;
+	uint32_t buckets[HIST_BUCKETS];
+} histogram_t;
+
+/**
+ * struct stats_entry_s - Latency statistics of one command name
+ * @name: The command name
+ * @hist: One histogram per phase, indexed by enum phase_e
+ */
+typedef struct stats_entry_s
+{
+	char *name;
+	histogram_t hist[PHASE_COUNT];
+} stats_entry_t;
+
+/**
+ * struct stats_table_s - Hash table of the statistics of every command
+ * @slots: Open-addressing slots, NULL when empty
+ * @size: Number of slots, always a power of two
+ * @count: Number of entries in use
+ * @path: File the report is written to, or NULL for the standard error
+ */
+typedef struct stats_table_s
+{
+	stats_entry_t **slots;
+	size_t size;
+	size_t count;
+	char *path;
+} stats_table_t;
+
+#define HSHC_MAGIC 0x43485348U
+#define HSHC_VERSION 10
+
+/**
+ * enum opcode_e - Instructions of a compiled program
+ * @OP_END: End of the program
+ * @OP_CMD: Run a simple command. It is followed by the line number of the
+ * command, the number of words W, the number of redirections R, the string
+ * pool offset of each word, and R pairs of redirection spec, see REDIR_IN,
+ * and offset of the redirection's word, or of the body of a here-document
+ * @OP_JMP_OK: Jump to the operand if the last status is 0
+ * @OP_JMP_FAIL: Jump to the operand if the last status is not 0
+ * @OP_NOT: Negate the last status, for '!'
+ * @OP_SYNTAX: Report a syntax error. It is followed by the line number and
+ * the string pool offset of the message
+ * @OP_JMP: Jump to the operand
+ * @OP_TRUE: Set the last status to 0
+ * @OP_LOOP: Enter a while or until loop. It is followed by the address of
+ * the loop's OP_POP and the address its condition starts at
+ * @OP_FOR: Enter a for loop. It is followed by the address of the loop's
+ * OP_POP, the offset of the variable name, the number of words and the
+ * offset of each word
+ * @OP_FOR_NEXT: Assign the next word to the variable of the innermost for
+ * loop, or leave the loop when there is none left
+ * @OP_NEXT: Save the last status in the innermost loop and jump back to
+ * its condition, or to its OP_FOR_NEXT
+ * @OP_POP: Leave the innermost loop, whose status becomes the last status
+ * @OP_CASE: Match a word against the patterns of a case command. It is
+ * followed by the line number, the offset of the word and the address of
+ * the OP_CASE_TABLE holding the patterns
+ * @OP_CASE_TABLE: Patterns of a case command, never executed. It is
+ * followed by the number of patterns N, the size S of the hash table, N
+ * pairs of pattern offset and address of the code to run on a match, and
+ * the S slots of the hash table, which hold 1 plus the index of a literal
+ * pattern, or 0
+ * @OP_FUNC: Define a function. It is followed by the offset of the name and
+ * the address of the end of the body, which follows the instruction
+ * @OP_FOR_ARGS: Enter a for loop over the positional parameters. It is
+ * followed by the address of the loop's OP_POP and the offset of the
+ * variable name
+ * @OP_REDIR: Apply the redirections of a compound command, which follows
+ * the instruction. It is followed by the line number, the address after
+ * the command's OP_REDIR_END, where a failed redirection jumps to, the
+ * number of redirections R and R pairs like those of OP_CMD
+ * @OP_REDIR_END: Undo the redirections of the innermost OP_REDIR
+ */
+enum opcode_e
+{
+	OP_END,
+	OP_CMD,
+	OP_JMP_OK,
+	OP_JMP_FAIL,
+	OP_NOT,
+	OP_SYNTAX,
+	OP_JMP,
+	OP_TRUE,
+	OP_LOOP,
+	OP_FOR,
+	OP_FOR_NEXT,
+	OP_NEXT,
+	OP_POP,
+	OP_CASE,
+	OP_CASE_TABLE,
+	OP_FUNC,
+	OP_FOR_ARGS,
+	OP_REDIR,
+	OP_REDIR_END
+};
+
+/* Kinds of instruction operands, see op_operand */
+#define OPND_NUMBER 0
+#define OPND_STRING 1
+#define OPND_ADDRESS 2
+
+/**
+ * struct program_s - A script or input line compiled to bytecode
+ * @code: Instruction words, see enum opcode_e
+ * @code_len: Number of instruction words in use
+ * @code_cap: Number of instruction words allocated
+ * @strings: String pool holding every word, NUL terminated and preceded
+ * by its WORD_ flags
+ * @str_len: Number of bytes of the string pool in use
+ * @str_cap: Number of bytes of the string pool allocated
+ * @map: The cache file @code and @strings point into, or NULL when they
+ * were allocated by the compiler
+ * @map_len: Size of the mapping
+ * @binds: For the body of a function, the aliases the names of its
+ * commands stood for when it was defined, by index of the command
+ * @nbinds: Number of entries of @binds
+ * @bound: Non-zero if the aliases of the commands are those of @binds,
+ * zero if they are those defined when the commands run
+ *
+ * Description: Words are referenced by their offset in @strings, so the
+ * program holds no pointers and can be written to the cache as it is.
+ */
+typedef struct program_s
+{
+	uint32_t *code;
+	size_t code_len;
+	size_t code_cap;
+	char *strings;
+	size_t str_len;
+	size_t str_cap;
+	void *map;
+	size_t map_len;
+	struct alias_bind_s *binds;
+	size_t nbinds;
+	int bound;
+} program_t;
+
+/**
+ * struct alias_bind_s - The alias a command of a function stands for
+ * @pc: Index of the OP_CMD instruction in the body
+ * @alias: The alias, with a reference of its own
+ */
+typedef struct alias_bind_s
+{
+	size_t pc;
+	struct alias_s *alias;
+} alias_bind_t;
+
+/**
+ * struct hshc_header_s - Header of a compiled-script cache file
+ * @magic: HSHC_MAGIC
+ * @version: HSHC_VERSION of the shell that wrote the file
+ * @code_len: Number of instruction words
+ * @str_len: Size of the string pool
+ * @size: Size of the script when it was compiled
+ * @mtime_sec: Modification time of the script, seconds
+ * @mtime_nsec: Modification time of the script, nanoseconds
+ * @path_len: Length of the absolute path of the script, with its NUL
+ * @build: Fingerprint of the bytecode the parser of the shell that wrote
+ * the file emits, see cache_build_id
+ *
+ * Description: The header is followed by the path, padded to a multiple of
+ * four bytes, the instruction words and the string pool.
+ */
+typedef struct hshc_header_s
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t code_len;
+	uint32_t str_len;
+	uint64_t size;
+	uint64_t mtime_sec;
+	uint64_t mtime_nsec;
+	uint64_t path_len;
+	uint64_t build;
+} hshc_header_t;
+
+/* Markers written into words by the lexer in place of quotes */
+#define CTL_ESC '\001'
+#define CTL_DQ '\002'
+#define CTL_SQ '\003'
+
+/* Flags of word tokens, also stored before every word of a program */
+#define WORD_QUOTED 1
+#define WORD_DOLLAR 2
+#define WORD_GLOB 4
+#define WORD_TILDE 8
+#define WORD_ASSIGN 16
+
+/**
+ * enum token_e - Types of the tokens produced by the lexer
+ * @TOK_WORD: A word, quoting already turned into markers
+ * @TOK_IO_NUMBER: Digits directly followed by '<' or '>'
+ * @TOK_NEWLINE: A newline
+ * @TOK_EOF: End of the input
+ * @TOK_ERROR: Unterminated quote or substitution
+ * @TOK_SEMI: ';'
+ * @TOK_AMP: '&'
+ * @TOK_PIPE: '|'
+ * @TOK_AND_IF: '&&'
+ * @TOK_OR_IF: '||'
+ * @TOK_DSEMI: ';;'
+ * @TOK_LPAREN: '('
+ * @TOK_RPAREN: ')'
+ * @TOK_LESS: '<'
+ * @TOK_GREAT: '>'
+ * @TOK_DGREAT: '>>'
+ * @TOK_DLESS: '<<'
+ * @TOK_DLESSDASH: '<<-'
+ * @TOK_TLESS: '<<<'
+ * @TOK_LESSAND: '<&'
+ * @TOK_GREATAND: '>&'
+ * @TOK_LESSGREAT: '<>'
+ * @TOK_CLOBBER: '>|'
+ */
+enum token_e
+{
+	TOK_WORD,
+	TOK_IO_NUMBER,
+	TOK_NEWLINE,
+	TOK_EOF,
+	TOK_ERROR,
+	TOK_SEMI,
+	TOK_AMP,
+	TOK_PIPE,
+	TOK_AND_IF,
+	TOK_OR_IF,
+	TOK_DSEMI,
+	TOK_LPAREN,
+	TOK_RPAREN,
+	TOK_LESS,
+	TOK_GREAT,
+	TOK_DGREAT,
+	TOK_DLESS,
+	TOK_DLESSDASH,
+	TOK_TLESS,
+	TOK_LESSAND,
+	TOK_GREATAND,
+	TOK_LESSGREAT,
+	TOK_CLOBBER
+};
+
+/**
+ * struct token_s - A token, as a span of the input buffer
+ * @type: One of enum token_e
+ * @start: First byte of the token
+ * @len: Length of the token; words are rewritten in place, so this is the
+ * length after quotes were turned into markers
+ * @line: Line the token starts on
+ * @flags: WORD_ flags of a word
+ */
+typedef struct token_s
+{
+	int type;
+	char *start;
+	size_t len;
+	int line;
+	int flags;
+} token_t;
+
+/**
+ * struct lexer_s - State of the lexer
+ * @pos: Next byte to read
+ * @out: Next byte to write while rewriting a word in place
+ * @end: End of the input
+ * @line: Current line number
+ * @at_eof: Non-zero when no more input can follow the buffer
+ * @incomplete: Set when the input ended inside a construct
+ * @flags: WORD_ flags of the word being read
+ */
+typedef struct lexer_s
+{
+	char *pos;
+	char *out;
+	char *end;
+	int line;
+	int at_eof;
+	int incomplete;
+	int flags;
+} lexer_t;
+
+#define PARSE_OK 0
+#define PARSE_ERROR 1
+#define PARSE_INCOMPLETE 2
+
+/* Number of here-documents whose body can be pending at a newline */
+#define HEREDOC_MAX 16
+
+/**
+ * struct heredoc_s - A here-document whose body has yet to be read
+ * @slot: Index of the OP_CMD operand that receives the body
+ * @delim: The delimiter, unquoted, in the input buffer
+ * @delim_len: Length of @delim
+ * @quoted: Non-zero if the delimiter was quoted, so the body is literal
+ * @strip: Non-zero for '<<-', which removes the leading tabs of each line
+ */
+typedef struct heredoc_s
+{
+	size_t slot;
+	const char *delim;
+	size_t delim_len;
+	int quoted;
+	int strip;
+} heredoc_t;
+
+/**
+ * struct parser_s - State of the parser
+ * @lx: The lexer
+ * @tok: The current token
+ * @prog: The program the code is emitted to
+ * @status: PARSE_OK, PARSE_ERROR or PARSE_INCOMPLETE
+ * @msg: The syntax error message, when @status is PARSE_ERROR
+ * @heredocs: The here-documents whose body follows the next newline
+ * @nheredoc: Their number
+ */
+typedef struct parser_s
+{
+	lexer_t lx;
+	token_t tok;
+	program_t *prog;
+	int status;
+	char msg[128];
+	heredoc_t heredocs[HEREDOC_MAX];
+	size_t nheredoc;
+} parser_t;
+
+/**
+ * struct input_s - Line reader used by the interactive and stdin modes
+ * @stream: The stream commands are read from
+ * @prompt: The prompt, or NULL when not interactive
+ * @line: Buffer of getline
+ * @line_size: Size of @line
+ * @raw: The lines of the command being read
+ * @raw_len: Length of @raw
+ * @raw_cap: Size of @raw and @work
+ * @work: Copy of @raw the lexer rewrites in place
+ * @line_number: Number of the next line to read
+ */
+typedef struct input_s
+{
+	FILE *stream;
+	char *prompt;
+	char *line;
+	size_t line_size;
+	char *raw;
+	size_t raw_len;
+	size_t raw_cap;
+	char *work;
+	int line_number;
+} input_t;
+
+/**
+ * struct arena_chunk_s - A block of memory of the expansion arena
+ * @next: The next chunk, used once this one is full
+ * @size: The number of bytes following the header
+ * @base: Position of its first byte in the arena, see arena_pos
+ */
+typedef struct arena_chunk_s
+{
+	struct arena_chunk_s *next;
+	size_t size;
+	size_t base;
+} arena_chunk_t;
+
+/**
+ * struct arena_s - Stack allocator holding the results of expansions
+ * @head: The first chunk
+ * @cur: The chunk being allocated from, or NULL before the first
+ * allocation
+ * @used: The number of bytes of @cur in use
+ */
+typedef struct arena_s
+{
+	arena_chunk_t *head;
+	arena_chunk_t *cur;
+	size_t used;
+} arena_t;
+
+/**
+ * struct arena_mark_s - A position in the expansion arena
+ * @chunk: The chunk in use when the mark was taken
+ * @used: The number of bytes of @chunk in use then
+ */
+typedef struct arena_mark_s
+{
+	arena_chunk_t *chunk;
+	size_t used;
+} arena_mark_t;
+
+/**
+ * struct loop_frame_s - A loop being executed by run_program
+ * @break_pc: Address of the loop's OP_POP, where 'break' jumps to
+ * @continue_pc: Address of the condition, or of the OP_FOR_NEXT, where
+ * 'continue' and the end of the body jump to
+ * @for_op: The OP_FOR or OP_FOR_ARGS instruction of a for loop, NULL for
+ * while and until
+ * @args: The positional parameters an OP_FOR_ARGS loop iterates over, as
+ * they were when the loop started, or the expanded words of an OP_FOR loop
+ * with words to expand; NULL when the loop uses the words of its OP_FOR
+ * @nargs: The number of @args
+ * @index: Index of the next word a for loop assigns
+ * @status: Status of the last command of the body, which is the status of
+ * the whole loop
+ * @mark: Top of the expansion arena when the loop started, where the words
+ * of an OP_FOR loop that needed expanding are kept until it ends
+ */
+typedef struct loop_frame_s
+{
+	size_t break_pc;
+	size_t continue_pc;
+	const uint32_t *for_op;
+	char **args;
+	uint32_t nargs;
+	uint32_t index;
+	int status;
+	arena_mark_t mark;
+} loop_frame_t;
+
+#define VM_FRAMES 16
+
+/**
+ * struct vm_s - State of run_program
+ * @prog: The program being run
+ * @program_name: Name of the shell program, for error messages
+ * @frames: Stack of the loops being executed, innermost last
+ * @depth: Number of loops on the stack
+ * @cap: Number of frames @frames can hold
+ * @inline_frames: Initial storage of @frames, so only loops nested deeper
+ * than VM_FRAMES allocate
+ * @redirs: The redirections of the compound commands being executed,
+ * innermost first
+ */
+typedef struct vm_s
+{
+	const program_t *prog;
+	char *program_name;
+	loop_frame_t *frames;
+	size_t depth;
+	size_t cap;
+	loop_frame_t inline_frames[VM_FRAMES];
+	struct vm_redir_s *redirs;
+} vm_t;
+
+#define LOOP_BREAK 1
+#define LOOP_CONTINUE 2
+#define LOOP_RETURN 3
+
+/**
+ * struct function_s - A shell function
+ * @prog: The compiled body, copied out of the program that defined it
+ * @refs: References to the function: one from the command table while it
+ * is defined, and one for each call that is running
+ */
+typedef struct function_s
+{
+	program_t prog;
+	int refs;
+} function_t;
+
+/* Number of sourced files whose compiled programs are kept */
+#define SOURCE_CACHE 16
+
+/**
+ * struct source_s - A file compiled for '.', kept for the next time it is
+ * sourced
+ * @fn: The program, run like the body of a function, or NULL for an empty
+ * entry of the cache
+ * @dev: Device of the file
+ * @ino: Its inode
+ * @mtime: Its modification time when it was compiled
+ * @size: Its size then
+ */
+typedef struct source_s
+{
+	function_t *fn;
+	dev_t dev;
+	ino_t ino;
+	struct timespec mtime;
+	off_t size;
+} source_t;
+
+/**
+ * struct alias_s - An alias
+ * @value: Its text, as given to alias
+ * @prog: The text compiled when the alias was defined
+ * @tail: For an alias that is not simple, the text compiled followed by
+ * an empty placeholder word, which the arguments of the alias replace
+ * @tail_pc: Index of the command of @tail holding the placeholder, or
+ * (size_t)-1 when a comment ends the text and swallows the arguments
+ * @simple: Non-zero if @prog is a single command made of words only,
+ * which are expanded in place of the name of the alias
+ * @blank: Non-zero if @value ends with a blank, so the word after the
+ * alias is checked for an alias too
+ * @busy: Non-zero while the alias is being expanded, so a value that
+ * starts with the name of its own alias runs the command of that name
+ * @refs: References to the alias: one from the command table while it is
+ * defined, one for each expansion that is running and one for each
+ * subshell that saved it
+ */
+typedef struct alias_s
+{
+	char *value;
+	program_t prog;
+	program_t tail;
+	size_t tail_pc;
+	int simple;
+	int blank;
+	int busy;
+	int refs;
+} alias_t;
+
+/**
+ * struct alias_site_s - Where the name of a command comes from, for the
+ * lookup of its alias
+ * @prog: The program of the command, or NULL for the aliases defined now
+ * @pc: Index of the command in @prog
+ * @lit: The number of fields at the start of the command that were
+ * literal words, without quotes or expansions, which aliases can replace
+ */
+typedef struct alias_site_s
+{
+	const program_t *prog;
+	size_t pc;
+	int lit;
+} alias_site_t;
+
+/**
+ * struct alias_args_s - The arguments of an alias that is not simple,
+ * waiting for the command of its value they are added to
+ * @prog: The value, compiled with a placeholder for them, see alias_t
+ * @pc: Index of the command holding the placeholder
+ * @args: The arguments
+ * @lit: How many of them were literal words
+ * @prev: The arguments of the alias being run around this one, or NULL
+ */
+typedef struct alias_args_s
+{
+	const program_t *prog;
+	size_t pc;
+	char **args;
+	int lit;
+	struct alias_args_s *prev;
+} alias_args_t;
+
+/**
+ * struct loadable_s - A builtin loaded from a shared object by enable
+ * @entry: Its entry in the builtin table, which calls builtin_loadable
+ * @def: The builtin, as the shared object exports it
+ * @handle: The handle dlopen gave for the shared object
+ * @shadowed: The builtin of the same name it replaced, or NULL
+ * @refs: References to it: one from the command table while it is
+ * enabled, one for each call that is running and one for each subshell
+ * that saved it
+ */
+typedef struct loadable_s
+{
+	builtin_t entry;
+	const hsh_builtin_t *def;
+	void *handle;
+	const builtin_t *shadowed;
+	int refs;
+} loadable_t;
+
+/**
+ * struct command_s - Entry of the command table
+ * @name: The command name
+ * @builtin: The builtin of that name, or NULL
+ * @loadable: The loaded builtin @builtin is the entry of, or NULL
+ * @function: The function of that name, or NULL
+ * @alias: The alias of that name, or NULL
+ * @special: Non-zero for the POSIX special builtins, which are found
+ * before functions
+ */
+typedef struct command_s
+{
+	char *name;
+	const builtin_t *builtin;
+	loadable_t *loadable;
+	function_t *function;
+	alias_t *alias;
+	int special;
+} command_t;
+
+/**
+ * struct cmd_save_s - An entry of the command table as it was before a
+ * subshell run without forking changed it, which gets it back when it
+ * ends
+ * @cmd: The entry of the command table
+ * @builtin: The builtin it held, or NULL
+ * @loadable: The loaded builtin it held, or NULL, with a reference of its
+ * own
+ * @fn: The function it held, or NULL, with a reference of its own
+ * @alias: The alias it held, or NULL, with a reference of its own
+ * @next: The entry saved before, or NULL
+ */
+typedef struct cmd_save_s
+{
+	command_t *cmd;
+	const builtin_t *builtin;
+	struct loadable_s *loadable;
+	function_t *fn;
+	struct alias_s *alias;
+	struct cmd_save_s *next;
+} cmd_save_t;
+
+/**
+ * struct command_table_s - Hash table of the builtins and functions
+ * @slots: Open-addressing slots, NULL when empty
+ * @size: Number of slots, always a power of two
+ * @count: Number of entries in use
+ */
+typedef struct command_table_s
+{
+	command_t **slots;
+	size_t size;
+	size_t count;
+} command_table_t;
+
+/**
+ * struct param_frame_s - The positional parameters of a function call
+ * @argv: The parameters, $1 first; they point into the argument vector of
+ * the call, which outlives the frame
+ * @argc: The number of parameters
+ * @prev: The frame of the caller
+ */
+typedef struct param_frame_s
+{
+	char **argv;
+	int argc;
+	struct param_frame_s *prev;
+} param_frame_t;
+
+/* Offset of the elements an array does not have */
+#define ARRAY_UNSET ((size_t)-1)
+/* Highest index of an array, which keeps its offset table in memory */
+#define ARRAY_INDEX_MAX 16777215L
+
+/**
+ * struct array_s - The elements of an array variable
+ * @text: The elements, each terminated by NUL, one after the other
+ * @used: The number of bytes of @text in use
+ * @cap: The size of @text
+ * @offs: For each index, the offset of its element in @text, or
+ * ARRAY_UNSET; offsets stay valid when @text moves as it grows
+ * @n: The number of entries of @offs, one more than the highest index
+ * @ncap: The number of entries @offs can hold
+ * @count: The number of elements set
+ * @garbage: The bytes of @text left by elements overwritten
+ * @shared: Set while "${a[@]}" may have handed out pointers into @text
+ * @shared_at: Position of the arena when it did, see array_own
+ */
+typedef struct array_s
+{
+	char *text;
+	size_t used;
+	size_t cap;
+	size_t *offs;
+	size_t n;
+	size_t ncap;
+	size_t count;
+	size_t garbage;
+	int shared;
+	size_t shared_at;
+} array_t;
+
+/**
+ * struct array_retired_s - Text of an array kept for the pointers to it
+ * @text: The text
+ * @pos: It is freed once the arena is rewound below this position
+ * @next: The next retired text
+ */
+typedef struct array_retired_s
+{
+	char *text;
+	size_t pos;
+	struct array_retired_s *next;
+} array_retired_t;
+
+/* Flags of shell variables */
+#define VAR_EXPORT 1
+#define VAR_UNSET 2
+
+/**
+ * struct var_s - A shell variable
+ * @str: "NAME=value", the form execve expects, so exported variables are
+ * passed to commands without being copied
+ * @name_len: Length of the name
+ * @cap: Size of the buffer of @str
+ * @flags: VAR_EXPORT and VAR_UNSET
+ * @journal: Serial of the last subshell journal the variable was saved in
+ * @array: The elements of an array variable, NULL for any other; an array
+ * is VAR_UNSET as a plain variable, so it is never exported
+ */
+typedef struct var_s
+{
+	char *str;
+	size_t name_len;
+	size_t cap;
+	int flags;
+	unsigned int journal;
+	array_t *array;
+} var_t;
+
+/**
+ * struct var_table_s - Hash table of the shell variables
+ * @slots: Open-addressing slots, NULL when empty
+ * @size: Number of slots, always a power of two
+ * @count: Number of variables, set or not
+ * @env: NULL-terminated array of the exported variables
+ * @env_cap: Number of pointers @env can hold
+ * @env_dirty: Set when @env must be rebuilt by var_environ
+ */
+typedef struct var_table_s
+{
+	var_t **slots;
+	size_t size;
+	size_t count;
+	char **env;
+	size_t env_cap;
+	int env_dirty;
+} var_table_t;
+
+/**
+ * struct var_save_s - A variable assigned for the duration of a command
+ * @var: The variable
+ * @value: Copy of its previous value, or NULL if it was not set
+ * @flags: Its previous flags
+ * @journal: Its previous journal serial, when saved by var_journal_note
+ * @array: Copy of its previous elements, when saved by var_journal_note
+ */
+typedef struct var_save_s
+{
+	var_t *var;
+	char *value;
+	int flags;
+	unsigned int journal;
+	array_t *array;
+} var_save_t;
+
+/**
+ * struct var_journal_s - The variables changed in a subshell run without
+ * forking
+ * @saved: Their previous values, in the order they were first changed;
+ * the copies are allocated with malloc, since commands run in the
+ * subshell rewind the arena
+ * @n: The number of variables saved
+ * @cap: The number of entries @saved can hold
+ * @serial: Number identifying the journal, stored in the variables it
+ * saved so each of them is saved only once
+ * @prev: The journal of the enclosing subshell, or NULL
+ */
+typedef struct var_journal_s
+{
+	var_save_t *saved;
+	size_t n;
+	size_t cap;
+	unsigned int serial;
+	struct var_journal_s *prev;
+} var_journal_t;
+
+/**
+ * struct subshell_s - The state of the shell saved around a subshell that
+ * is run without forking
+ * @journal: The variables the subshell changes
+ * @params: The positional parameters
+ * @frame: Copy of their frame, which 'shift' changes in place
+ * @spawn_attr: The scheduling settings of spawned commands
+ * @last_status: The status before the subshell ran
+ * @cwd_saved: Non-zero once a cd in the subshell saved the directory
+ * @cwd_fd: Descriptor of the directory the subshell started in, or -1 if
+ * it could not be opened
+ * @cwd: The logical path of that directory, or NULL if it is unknown
+ * @cmds: The entries of the command table the subshell changed, the last
+ * one first
+ * @prev: The enclosing subshell, or NULL
+ */
+typedef struct subshell_s
+{
+	var_journal_t journal;
+	param_frame_t *params;
+	param_frame_t frame;
+	spawn_attr_t spawn_attr;
+	int last_status;
+	int cwd_saved;
+	int cwd_fd;
+	char *cwd;
+	struct cmd_save_s *cmds;
+	struct subshell_s *prev;
+} subshell_t;
+
+/* Capture files kept open for reuse, one per level of nesting */
+#define SUBST_FILES 8
+/* Most compiled command substitutions the cache keeps */
+#define SUBST_CACHE_MAX 1024
+
+/**
+ * struct subst_prog_s - A compiled command substitution
+ * @text: Copy of the command, as it was written
+ * @len: Its length
+ * @line: The line number it was compiled with
+ * @prog: The compiled command
+ * @refs: The number of runs of it in progress, which keep it in the cache
+ */
+typedef struct subst_prog_s
+{
+	char *text;
+	size_t len;
+	int line;
+	program_t prog;
+	int refs;
+} subst_prog_t;
+
+/**
+ * struct subst_cache_s - Hash table of the compiled command substitutions
+ * @slots: Open-addressing slots, NULL when empty
+ * @size: Number of slots, always a power of two
+ * @count: Number of substitutions
+ */
+typedef struct subst_cache_s
+{
+	subst_prog_t **slots;
+	size_t size;
+	size_t count;
+} subst_cache_t;
+
+/*
+ * Kinds of redirections. The spec of a redirection in OP_CMD is its kind
+ * ORed with the descriptor it redirects shifted left by 8 bits; while the
+ * command is being parsed, REDIR_MARK tells it from the words.
+ */
+#define REDIR_IN 0
+#define REDIR_OUT 1
+#define REDIR_APPEND 2
+#define REDIR_RDWR 3
+#define REDIR_DUP 4
+#define REDIR_HEREDOC 5
+#define REDIR_HERESTRING 6
+#define REDIR_MARK 0x80000000U
+
+/* Number of descriptors the cache of '>>' files keeps open */
+#define APPEND_CACHE 16
+/* Number of sealed files the cache of literal here-documents keeps open */
+#define HEREDOC_CACHE 16
+
+/**
+ * struct redir_s - A redirection of a command, ready to be applied
+ * @fd: The descriptor redirected
+ * @src: The descriptor @fd becomes a copy of, or -1 to close @fd
+ * @opened: Set when @src was opened for the command and is closed after it
+ * @saved: Copy of the previous @fd while the redirection is applied in the
+ * shell, or -1 if @fd was closed
+ */
+typedef struct redir_s
+{
+	int fd;
+	int src;
+	int opened;
+	int saved;
+} redir_t;
+
+/**
+ * struct redir_list_s - The redirections of a command
+ * @v: The redirections, in the order they are applied, in the arena
+ * @n: Their number
+ * @line: The line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ */
+typedef struct redir_list_s
+{
+	redir_t *v;
+	size_t n;
+	int line;
+	char *program_name;
+} redir_list_t;
+
+/**
+ * struct vm_redir_s - The redirections of a compound command being executed
+ * @rl: The redirections, applied in the shell
+ * @mark: Top of the expansion arena before the OP_REDIR, where this entry
+ * and its redirections are kept
+ * @depth: Number of loops on the stack of the vm_t at the OP_REDIR
+ * @prev: The entry of the enclosing compound command, or NULL
+ */
+typedef struct vm_redir_s
+{
+	redir_list_t rl;
+	arena_mark_t mark;
+	size_t depth;
+	struct vm_redir_s *prev;
+} vm_redir_t;
+
+/**
+ * struct append_fd_s - A descriptor kept open by the cache of '>>' files
+ * @path: The path it was opened with, or NULL for an empty entry
+ * @fd: The descriptor, opened with O_APPEND
+ * @dev: The device of the file
+ * @ino: The inode of the file, which a stat of @path must still find
+ * @mode: The mode of the file, which must not have changed either
+ * @uid: Its owner
+ * @gid: Its group
+ */
+typedef struct append_fd_s
+{
+	char *path;
+	int fd;
+	dev_t dev;
+	ino_t ino;
+	mode_t mode;
+	uid_t uid;
+	gid_t gid;
+} append_fd_t;
+
+/**
+ * struct heredoc_file_s - A file kept open by the cache of here-documents
+ * @text: The body it holds, or NULL for an empty entry
+ * @fd: The file, sealed so its content can no longer change
+ */
+typedef struct heredoc_file_s
+{
+	char *text;
+	int fd;
+} heredoc_file_t;
+
+#define FIELDS_INLINE 64
+
+/**
+ * struct fields_s - The fields a command's words expand to
+ * @v: The fields, followed by NULL, so they can be used as an argument
+ * vector
+ * @n: The number of fields
+ * @cap: The number of pointers @v can hold
+ * @inline_v: Initial storage of @v, so only commands of more than
+ * FIELDS_INLINE words allocate it
+ */
+typedef struct fields_s
+{
+	char **v;
+	size_t n;
+	size_t cap;
+	char *inline_v[FIELDS_INLINE];
+} fields_t;
+
+/**
+ * struct alias_cmd_s - A command built from the values of simple aliases
+ * @out: Its fields
+ * @site: Where its name comes from, with the number of its literal fields
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ */
+typedef struct alias_cmd_s
+{
+	fields_t out;
+	alias_site_t site;
+	int line_number;
+	char *program_name;
+} alias_cmd_t;
+
+/* Kinds of results of an expansion, see expand_t */
+#define EXP_FIELDS 0
+#define EXP_STRING 1
+#define EXP_PATTERN 2
+#define EXP_ASSIGN 3
+
+/* Kinds of text added to an expansion by exp_put */
+#define PUT_LITERAL 0
+#define PUT_QUOTED 1
+#define PUT_EXPANDED 2
+
+#define EXPAND_INLINE 256
+
+/**
+ * struct expand_s - State of the expansion of a word
+ * @mode: EXP_FIELDS to split the result into fields, EXP_STRING for a
+ * single string, EXP_PATTERN for a pattern with its quoted characters
+ * escaped, or EXP_ASSIGN for the value of an assignment
+ * @out: Where the fields are added, in EXP_FIELDS mode
+ * @buf: The field being built
+ * @len: Its length
+ * @cap: The size of @buf
+ * @started: Set when the field being built exists even if it is empty,
+ * because quotes or text went into it
+ * @skip: Set after a field was ended by IFS white space, which a
+ * following IFS character that is not white space belongs to
+ * @suppress: Set by a "$@" without parameters, so the quotes around it do
+ * not make an empty field
+ * @glob: Set when the field being built has an unquoted '*', '?' or '[',
+ * so it is a pattern for pathname expansion
+ * @escaped: Set when a backslash was added to the field being built, to
+ * quote a character of the pattern
+ * @error: Set when an expansion failed
+ * @line: The line number, for error messages
+ * @program_name: Name of the shell program, for error messages
+ * @inline_buf: Initial storage of @buf
+ */
+typedef struct expand_s
+{
+	int mode;
+	fields_t *out;
+	char *buf;
+	size_t len;
+	size_t cap;
+	int started;
+	int skip;
+	int suppress;
+	int glob;
+	int escaped;
+	int error;
+	int line;
+	char *program_name;
+	char inline_buf[EXPAND_INLINE];
+} expand_t;
+
+/* Number of directory listings the cache of pathname expansion keeps */
+#define GLOB_DIR_CACHE 64
+
+/**
+ * struct glob_dir_s - The listing of a directory, for pathname expansion
+ * @path: The directory, or NULL for an empty entry of the cache
+ * @dev: Its device
+ * @ino: Its inode
+ * @mtime: Its modification time when it was read
+ * @read_at: When it was read, in seconds
+ * @pool: The names, each one after a byte holding its d_type
+ * @names: The names, sorted, pointing into @pool
+ * @n: Their number
+ * @busy: Number of expansions walking the listing, which cannot be
+ * replaced in the cache until they are done
+ * @cached: Non-zero if the listing belongs to the cache, 0 if it is freed
+ * once used
+ */
+typedef struct glob_dir_s
+{
+	char *path;
+	dev_t dev;
+	ino_t ino;
+	struct timespec mtime;
+	time_t read_at;
+	char *pool;
+	char **names;
+	size_t n;
+	int busy;
+	int cached;
+} glob_dir_t;
+
+/* Kinds of compiled components of a pattern, see glob_pat_t */
+#define GLOB_ALL 0
+#define GLOB_PREFIX 1
+#define GLOB_SUFFIX 2
+#define GLOB_GENERIC 3
+
+/**
+ * struct glob_pat_s - A component of a pattern, compiled for matching
+ * @kind: GLOB_ALL for '*', GLOB_PREFIX for text followed by '*',
+ * GLOB_SUFFIX for '*' followed by text, or GLOB_GENERIC for any other
+ * pattern, which glob_match interprets
+ * @text: The component
+ * @lit: The text of a GLOB_PREFIX or GLOB_SUFFIX component
+ * @lit_len: Its length
+ * @dot: Non-zero if the component starts with a '.', so it may match the
+ * names starting with one
+ */
+typedef struct glob_pat_s
+{
+	int kind;
+	const char *text;
+	const char *lit;
+	size_t lit_len;
+	int dot;
+} glob_pat_t;
+
+/**
+ * struct glob_walk_s - State of a pathname expansion
+ * @comps: The components of the pattern
+ * @n: Their number
+ * @path: The path built so far
+ * @len: Its length
+ * @cap: The size of @path
+ * @out: The list the paths found are added to
+ * @found: The number of paths found
+ */
+typedef struct glob_walk_s
+{
+	char **comps;
+	size_t n;
+	char *path;
+	size_t len;
+	size_t cap;
+	fields_t *out;
+	size_t found;
+} glob_walk_t;
+
+/* Operations of the nodes of an arithmetic expression, see arith_node_t */
+#define ARITH_NUM 0
+#define ARITH_VAR 1
+#define ARITH_NEG 2
+#define ARITH_NOT 3
+#define ARITH_BNOT 4
+#define ARITH_ASSIGN 5
+#define ARITH_COND 6
+#define ARITH_OR 7
+#define ARITH_AND 8
+#define ARITH_BOR 9
+#define ARITH_XOR 10
+#define ARITH_BAND 11
+#define ARITH_EQ 12
+#define ARITH_NE 13
+#define ARITH_LT 14
+#define ARITH_LE 15
+#define ARITH_GT 16
+#define ARITH_GE 17
+#define ARITH_SHL 18
+#define ARITH_SHR 19
+#define ARITH_ADD 20
+#define ARITH_SUB 21
+#define ARITH_MUL 22
+#define ARITH_DIV 23
+#define ARITH_MOD 24
+
+/* Most expressions the arithmetic cache keeps */
+#define ARITH_CACHE_MAX 4096
+
+/**
+ * struct arith_node_s - A node of an arithmetic expression tree
+ * @op: One of the ARITH_ operations
+ * @sub: For ARITH_ASSIGN, the operation combined with the assignment, as
+ * in "x += 1", or ARITH_NUM for a plain '='
+ * @num: The value of an ARITH_NUM node
+ * @name: Offset of the variable name of an ARITH_VAR or ARITH_ASSIGN node
+ * in the text of the expression
+ * @len: Length of the name
+ * @a: Index of the first operand
+ * @b: Index of the second operand
+ * @c: Index of the third operand, the else branch of ARITH_COND
+ */
+typedef struct arith_node_s
+{
+	int op;
+	int sub;
+	int64_t num;
+	uint32_t name;
+	uint32_t len;
+	uint32_t a;
+	uint32_t b;
+	uint32_t c;
+} arith_node_t;
+
+/**
+ * struct arith_s - A parsed arithmetic expression
+ * @text: Copy of the text of the expression, which names point into
+ * @nodes: The nodes of the tree, operands before the nodes using them
+ * @count: The number of nodes
+ * @cap: The number of nodes @nodes can hold
+ * @root: Index of the root node
+ */
+typedef struct arith_s
+{
+	char *text;
+	arith_node_t *nodes;
+	uint32_t count;
+	uint32_t cap;
+	uint32_t root;
+} arith_t;
+
+/**
+ * struct arith_parser_s - State of the parser of arithmetic expressions
+ * @expr: The expression being built
+ * @p: The next character to read
+ * @end: End of the text
+ * @error: The message of the first syntax error, or NULL
+ */
+typedef struct arith_parser_s
+{
+	arith_t *expr;
+	const char *p;
+	const char *end;
+	const char *error;
+} arith_parser_t;
+
+/**
+ * struct arith_cache_s - Hash table of the parsed arithmetic expressions
+ * @slots: Open-addressing slots, NULL when empty
+ * @size: Number of slots, always a power of two
+ * @count: Number of expressions
+ */
+typedef struct arith_cache_s
+{
+	arith_t **slots;
+	size_t size;
+	size_t count;
+} arith_cache_t;
+
+/**
+ * struct printf_s - State of the printf builtin
+ * @argv: The arguments left for the conversions
+ * @width: Field width of the current conversion
+ * @prec: Its precision, or -1 if it has none
+ * @status: 0, or 1 once an argument was not a valid number
+ * @stop: Set by a '\c' in the argument of a %b, which ends the output
+ * @line: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ */
+typedef struct printf_s
+{
+	char **argv;
+	int width;
+	int prec;
+	int status;
+	int stop;
+	int line;
+	char *program_name;
+} printf_t;
+
+/* Ways the cat builtin copies a file inside the kernel, see cat_kernel */
+#define CAT_RANGE 0
+#define CAT_SENDFILE 1
+#define CAT_SPLICE 2
+
+/* Most bytes cat asks the kernel to copy in one call */
+#define CAT_CHUNK (1 << 30)
+
+/* Size of the buffer cat copies through when the kernel cannot copy */
+#define CAT_BUFFER 131072
+
+/* Descriptors whose kind the read builtin remembers, see read_record */
+#define READ_FDS 10
+#define READ_UNKNOWN 0
+#define READ_SEEK 1
+#define READ_BYTES 2
+
+/* Bytes read first from a file for a line, doubled while it goes on */
+#define READ_CHUNK 128
+#define READ_CHUNK_MAX 65536
+
+/**
+ * struct read_buf_s - A line read by the read builtin
+ * @text: Its bytes, without the delimiter
+ * @esc: For each byte, 1 if a backslash quoted it, 0 otherwise
+ * @len: The number of bytes
+ * @cap: The size of @text and @esc
+ */
+typedef struct read_buf_s
+{
+	char *text;
+	char *esc;
+	size_t len;
+	size_t cap;
+} read_buf_t;
+
+/* Kinds of the nodes of a test expression, see test_node_t */
+#define TEST_OR 0
+#define TEST_AND 1
+#define TEST_NOT 2
+#define TEST_FALSE 3
+#define TEST_STR 4
+#define TEST_UNARY 5
+#define TEST_BINARY 6
+
+/* Tokens of a test expression, as test_lex sees them */
+#define TT_EOI 0
+#define TT_OPERAND 1
+#define TT_UNARY 2
+#define TT_BINARY 3
+#define TT_AND 4
+#define TT_OR 5
+#define TT_NOT 6
+#define TT_LPAREN 7
+#define TT_RPAREN 8
+
+/* Binary operators of test, the op of a TEST_BINARY node */
+#define TB_EQ 0
+#define TB_NE 1
+#define TB_LT 2
+#define TB_GT 3
+#define TB_IEQ 4
+#define TB_INE 5
+#define TB_ILT 6
+#define TB_ILE 7
+#define TB_IGT 8
+#define TB_IGE 9
+#define TB_NT 10
+#define TB_OT 11
+#define TB_EF 12
+
+/* Number of entries of the stat cache of test */
+#define TEST_STAT_CACHE 8
+
+/**
+ * struct test_node_s - A node of a compiled test expression
+ * @kind: One of the TEST_ kinds
+ * @op: The letter of a TEST_UNARY operator, or the TB_ operator of a
+ * TEST_BINARY node
+ * @a: The operand of a TEST_STR or TEST_UNARY node, the first operand of
+ * a TEST_BINARY node
+ * @b: The second operand of a TEST_BINARY node
+ * @x: @a converted for the operators that take numbers
+ * @y: @b converted for the operators that take numbers
+ * @l: Index of the operand of a TEST_NOT node, the first operand of a
+ * TEST_AND or TEST_OR node
+ * @r: Index of the second operand of a TEST_AND or TEST_OR node
+ */
+typedef struct test_node_s
+{
+	int kind;
+	int op;
+	const char *a;
+	const char *b;
+	long x;
+	long y;
+	int l;
+	int r;
+} test_node_t;
+
+/**
+ * struct test_s - State of the compiler of test expressions
+ * @argv: The arguments, terminated by NULL
+ * @argc: Their number
+ * @pos: Index of the argument being compiled
+ * @nodes: The nodes compiled, operands before the nodes using them
+ * @n: Their number
+ * @err: The format of the message of the first error, or NULL; it takes
+ * @err_arg as its only argument
+ * @err_arg: The argument the error is about
+ */
+typedef struct test_s
+{
+	char **argv;
+	int argc;
+	int pos;
+	test_node_t *nodes;
+	int n;
+	const char *err;
+	const char *err_arg;
+} test_t;
+
+/**
+ * struct test_stat_s - An entry of the stat cache of test
+ * @path: The file, or NULL if the entry is empty
+ * @follow: Non-zero for stat, zero for lstat
+ * @epoch: Value of stat_epoch when it was made
+ * @err: 0 if the call succeeded, its errno otherwise
+ * @st: What the call returned
+ */
+typedef struct test_stat_s
+{
+	char *path;
+	int follow;
+	unsigned long epoch;
+	int err;
+	struct stat st;
+} test_stat_t;
+
+/* Global Variables */
+extern int last_status;
+extern int exit_requested;
+extern int interactive;
+extern int noexec;
+extern spawn_attr_t spawn_attr;
+extern int probes_active;
+extern cmd_timing_t *timing;
+extern const char *probe_name;
+extern int probe_line;
+extern pid_t probe_pid;
+extern int trace_enabled;
+extern int stats_enabled;
+extern stats_table_t stats_table;
+extern var_table_t var_table;
+extern int loop_request;
+extern unsigned int loop_levels;
+extern command_table_t command_table;
+extern param_frame_t *params;
+extern int func_depth;
+extern var_journal_t *var_journal;
+extern int subst_status;
+extern redir_list_t *redir_pending;
+extern alias_site_t *alias_pending;
+extern alias_args_t *alias_args;
+extern unsigned long stat_epoch;
+extern subshell_t *subshell_current;
+extern char *shell_name;
+extern pid_t shell_pid;
 
 /* Function Declarations */
-char **tokenize(char *input);
-void execute_command(char **tokens, int line_number, char *program_name);
+int dispatch_command(char **tokens, int line_number, char *program_name);
+int execute_command(char **tokens, int line_number, char *program_name);
+pid_t spawn_command(char *path, char **tokens, int line_number,
+		    char *program_name);
+int wait_command(pid_t child_pid);
+int decode_status(int status);
 char *search_path(char **tokens);
 int execute_exit(char *argument, int line_number, char *program_name);
-void execute_echo_path(void);
 ssize_t _write(const char *str);
 int _strcmp(const char *s1, const char *s2);
 const char *_strchr(const char *s, char c);
@@ -43,14 +1531,294 @@ int _strncmp(const char *s1, const char *s2, size_t n);
 int _validate_setenv_input(const char *name, const char *value);
 int _setenv(const char *name, const char *value);
 char *_strcpy(char *dest, char *src);
-int _replace_env_variable(const char *name, char *new_env);
-void _append_env_variable(char **new_environ, char *new_env);
-size_t _get_environ_size(void);
-void _shift_env_pointers(char **env, size_t index);
 int _unsetenv(const char *name);
 void execute_env(void);
 void interactive_mode(char *prompt, char *program_name);
 void noninteractive_mode(char *program_name);
+void builtins_register(void);
+command_t *cmd_lookup(const char *name, int create);
+int is_special_builtin(const char *name);
+void cmd_save(command_t *cmd);
+void cmd_restore(subshell_t *s);
+void alias_release(alias_t *a);
+void loadable_release(loadable_t *l);
+loadable_t *loadable_open(const char *path, const char *name,
+			  int line_number, char *program_name);
+int alias_dispatch(alias_t *a, char **tokens, int lit, int line_number,
+		   char *program_name);
+int alias_literal(const program_t *prog, size_t pc, int first);
+void alias_compile(alias_t *a, const char *value);
+alias_t *alias_find(const alias_site_t *site, command_t *cmd);
+void alias_bind(program_t *dst, const program_t *src, size_t start);
+int alias_tail(const program_t *prog, size_t pc, fields_t *args,
+	       int first);
+void func_define(const char *name, const program_t *prog, size_t start,
+		 size_t end);
+void func_release(function_t *fn);
+int func_call(function_t *fn, char **tokens, char *program_name);
+void prog_extract(program_t *dst, const program_t *src, size_t start,
+		  size_t end);
+int op_operand(const uint32_t *op, size_t i);
+void parse_function(parser_t *p, uint32_t name);
+int builtin_return(char **tokens, int line_number, char *program_name);
+int builtin_shift(char **tokens, int line_number, char *program_name);
+int builtin_env(char **tokens, int line_number, char *program_name);
+int builtin_setenv(char **tokens, int line_number, char *program_name);
+int builtin_unsetenv(char **tokens, int line_number, char *program_name);
+int builtin_timeout(char **tokens, int line_number, char *program_name);
+uint64_t now_ns(void);
+int parse_duration(const char *str, uint64_t *ns);
+void ns_to_timespec(uint64_t ns, struct timespec *ts);
+int signal_from_name(const char *name);
+const char *signal_name(int sig);
+int builtin_pin(char **tokens, int line_number, char *program_name);
+int parse_cpu_list(const char *list, cpu_set_t *cpus);
+void spread_cpus(spawn_attr_t *attr);
+int builtin_sched(char **tokens, int line_number, char *program_name);
+void apply_spawn_attr(const spawn_attr_t *attr);
+uint64_t probe_start(void);
+void probe_end(int phase, uint64_t start);
+void account_child(const struct rusage *usage);
+void add_self_usage(cmd_timing_t *t, const struct rusage *before);
+void stats_init(void);
+void stats_record(int phase, const char *name, uint64_t ns);
+void stats_poll(void);
+void stats_dump(void);
+void stats_free(void);
+int stats_grow(void);
+unsigned long hash_string(const char *str);
+size_t json_escape(char *dst, size_t size, const char *src);
+int trace_open(const char *path);
+void trace_span(const char *name, uint64_t start, uint64_t end, pid_t tid);
+void trace_close(void);
+void probe_line_end(uint64_t start);
+int builtin_time(char **tokens, int line_number, char *program_name);
+int builtin_exit(char **tokens, int line_number, char *program_name);
+void prog_emit(program_t *prog, uint32_t word);
+uint32_t prog_add_word(program_t *prog, const char *str, size_t len,
+		       int flags);
+void compile_script(program_t *prog, char *buf, size_t len);
+const char *prog_word(const program_t *prog, size_t pc, int i);
+size_t op_length(const uint32_t *code);
+const char *prog_first_name(const program_t *prog);
+void lex_init(lexer_t *lx, char *buf, size_t len, int line, int at_eof);
+int lex_next(lexer_t *lx, token_t *tok);
+int lex_squote(lexer_t *lx);
+int lex_backslash(lexer_t *lx);
+int lex_dquote(lexer_t *lx);
+int lex_dollar(lexer_t *lx);
+int lex_backquote(lexer_t *lx);
+int parse_program(program_t *prog, char *buf, size_t len, int line,
+		  int at_eof);
+void parse_next(parser_t *p);
+void parse_list(parser_t *p);
+void parse_compound_list(parser_t *p);
+int parse_keyword(parser_t *p, const char *word);
+int parse_at_end(parser_t *p);
+void parse_expect(parser_t *p, const char *word);
+void parse_patch(program_t *prog, uint32_t chain, uint32_t target);
+void parse_brace(parser_t *p);
+void parse_if(parser_t *p);
+void parse_while(parser_t *p);
+void parse_for(parser_t *p);
+void parse_for_words(parser_t *p, size_t loop);
+void parse_case(parser_t *p);
+uint32_t parse_pattern(program_t *prog, char *word, size_t len, int flags);
+size_t emit_case_table(program_t *prog, const uint32_t *items, uint32_t n);
+void parse_and_or(parser_t *p);
+void parse_pipeline(parser_t *p);
+void parse_command(parser_t *p);
+void parse_simple_command(parser_t *p);
+uint32_t parse_word(parser_t *p, uint32_t argc, uint32_t *assigns);
+void parse_unexpected(parser_t *p);
+size_t word_unquote(char *word, size_t len);
+void input_init(input_t *in, FILE *stream, char *prompt);
+int read_program(input_t *in, program_t *prog);
+void input_free(input_t *in);
+int run_program(const program_t *prog, char *program_name);
+void prog_free(program_t *prog);
+void vm_push(vm_t *vm, size_t break_pc, size_t continue_pc,
+	     const uint32_t *for_op);
+size_t vm_for_next(vm_t *vm, size_t pc);
+size_t vm_loop_request(vm_t *vm, size_t next);
+size_t vm_step_loop(vm_t *vm, size_t pc);
+size_t vm_case(vm_t *vm, size_t pc);
+size_t vm_redir(vm_t *vm, size_t pc);
+void vm_redir_pop(vm_t *vm);
+int glob_match(const char *pattern, const char *str);
+int glob_cmp(const void *a, const void *b);
+glob_dir_t *glob_dir_open(const char *path);
+void glob_dir_close(glob_dir_t *d);
+int glob_has_magic(const char *pattern, size_t len);
+size_t glob_expand(const char *pattern, fields_t *out);
+void glob_dir_match(glob_walk_t *w, size_t i);
+void glob_push(glob_walk_t *w, const char *str, size_t len);
+void glob_walk(glob_walk_t *w, size_t i, int literal);
+char *glob_unescape(const char *str, size_t len);
+int builtin_break(char **tokens, int line_number, char *program_name);
+int builtin_flush(const char *name, int line_number, char *program_name);
+int builtin_continue(char **tokens, int line_number, char *program_name);
+unsigned long hash_bytes(const char *str, size_t len);
+var_t *var_lookup(const char *name, size_t len, int create);
+void var_assign(var_t *v, const char *value, int flags);
+int var_set(const char *name, const char *value, int flags);
+char *var_get(const char *name);
+int var_unset(const char *name);
+int vars_grow(void);
+void vars_init(void);
+char **var_environ(void);
+int valid_name(const char *name, size_t len);
+int prog_verify(const program_t *prog);
+int cache_load(const char *path, const struct stat *st, program_t *prog);
+void cache_store(const char *path, const struct stat *st,
+		 const program_t *prog);
+int load_script(const char *path, program_t *prog, char *program_name);
+int shell_options(int argc, char **argv);
+int script_mode(char *path, char *program_name);
+void *arena_alloc(size_t size);
+char *arena_strndup(const char *str, size_t len);
+arena_mark_t arena_mark(void);
+void arena_release(arena_mark_t mark);
+void fields_init(fields_t *f);
+void fields_add(fields_t *f, char *field);
+void fields_free(fields_t *f);
+void exp_init(expand_t *ex, int mode, fields_t *out, int line,
+	      char *program_name);
+char *exp_finish(expand_t *ex);
+const char *ifs_chars(void);
+void exp_put(expand_t *ex, const char *str, size_t len, int how);
+void exp_field(expand_t *ex);
+void exp_bad(expand_t *ex);
+const char *exp_skip(const char *p, const char *end);
+void exp_text(expand_t *ex, const char *p, const char *end, int dq,
+	      int raw);
+char *exp_sub(expand_t *ex, int mode, const char *p, const char *end,
+	      int dq);
+const char *exp_dollar(expand_t *ex, const char *p, const char *end,
+		       int dq);
+const char *exp_lookup(const char *name, size_t len);
+void exp_value(expand_t *ex, const char *name, size_t len, int dq);
+void exp_args(expand_t *ex, char **argv, int n, char c, int dq);
+const char *exp_brace(expand_t *ex, const char *p, const char *end,
+		      int dq);
+const char *exp_escape(expand_t *ex, const char *p, int dq);
+char *exp_join(char sep);
+char *exp_cond(expand_t *ex, const char *name, size_t len, const char *op,
+	       const char *end, int dq);
+void exp_brace_op(expand_t *ex, const char *name, size_t len,
+		  const char *op, const char *end, int dq);
+char *exp_trim(const char *value, const char *pattern, int suffix,
+	       int longest);
+char *exp_substr(expand_t *ex, const char *name, size_t len,
+		 const char *p, const char *end, int dq);
+int expand_word(const char *word, fields_t *out, int line,
+		char *program_name);
+char *expand_string(const char *word, int mode, int line,
+		    char *program_name);
+int expand_command(const program_t *prog, size_t pc, fields_t *out,
+		   char *program_name);
+size_t var_assign_words(const program_t *prog, size_t pc, size_t n,
+			var_save_t *saved, char *program_name);
+void var_restore(var_save_t *saved, size_t n);
+const char *arith_skip(arith_parser_t *ap);
+uint32_t arith_node(arith_parser_t *ap, int op, uint32_t a, uint32_t b);
+uint32_t arith_primary(arith_parser_t *ap);
+const char *arith_name_end(const char *p, const char *end);
+uint32_t arith_number(arith_parser_t *ap, const char *p);
+int arith_assign_op(arith_parser_t *ap, int *len);
+uint32_t arith_binary(arith_parser_t *ap, int min_prec);
+uint32_t arith_expr(arith_parser_t *ap);
+int parse_int64(const char *str, size_t len, int64_t *value);
+int arith_eval(expand_t *ex, const arith_t *e, uint32_t i, int64_t *out);
+arith_t *arith_parse(expand_t *ex, const char *text, size_t len);
+void arith_error(expand_t *ex, const char *msg, const char *text);
+void arith_free(arith_t *e);
+arith_t *arith_find(expand_t *ex, const char *text, size_t len);
+const char *exp_arith(expand_t *ex, const char *p, const char *end,
+		      int dq);
+void var_journal_begin(var_journal_t *j);
+void var_journal_note(var_t *v);
+void var_journal_end(var_journal_t *j);
+int subst_begin(int *saved);
+char *subst_end(int fd, int saved, size_t *len);
+char *subst_run(const char *text, size_t len, int line, char *program_name,
+		size_t *out_len);
+void subshell_enter(subshell_t *s);
+int subshell_leave(subshell_t *s);
+const char *cwd_get(void);
+int cwd_change(const char *dir, int physical);
+void cwd_restore(subshell_t *s);
+int subst_exec(const program_t *prog, char *program_name);
+subst_prog_t *subst_compile(const char *text, size_t len, int line);
+void exp_command(expand_t *ex, const char *p, const char *end, int dq);
+const char *exp_backquote(expand_t *ex, const char *p, const char *end,
+			  int dq);
+int parse_is_redirect(parser_t *p);
+void parse_redirect(parser_t *p);
+void parse_compound_redirects(parser_t *p, size_t start);
+void parse_move_redirects(parser_t *p, size_t start, uint32_t argc,
+			  uint32_t nredir);
+void parse_heredocs(parser_t *p);
+int redir_prepare(const program_t *prog, size_t pc, redir_list_t *rl,
+		  char *program_name);
+void redir_release(redir_list_t *rl);
+void redir_error(const redir_list_t *rl, int kind, const char *path);
+int redir_apply(redir_list_t *rl);
+void redir_restore(redir_list_t *rl);
+void redir_child(redir_list_t *rl);
+int append_open(const char *path, int *cached);
+int heredoc_open(const char *text, int literal, int *cached);
+size_t esc_char(const char *s, int *c, int echo);
+char *esc_string(const char *s, size_t *len, int *stop);
+int builtin_echo(char **tokens, int line_number, char *program_name);
+long printf_long(printf_t *pf, int sign);
+void printf_conv(printf_t *pf, const char *flags, char conv);
+int builtin_printf(char **tokens, int line_number, char *program_name);
+int builtin_true(char **tokens, int line_number, char *program_name);
+int builtin_false(char **tokens, int line_number, char *program_name);
+int test_optype(const char *s, int *op);
+int test_lex(test_t *t, int i);
+int test_node(test_t *t, int kind, int l, int r);
+int test_number(test_t *t, const char *s, long *n);
+int test_error(test_t *t, const char *fmt, const char *arg);
+int test_binary(test_t *t);
+int test_or(test_t *t);
+int test_eval(const test_t *t, int i);
+int test_binop(const test_node_t *node);
+int test_stat(const char *path, int follow, struct stat *st);
+int builtin_test(char **tokens, int line_number, char *program_name);
+int builtin_cat(char **tokens, int line_number, char *program_name);
+void read_grow(read_buf_t *b, size_t n);
+void read_forget(int fd);
+int read_record(int fd, int delim, read_buf_t *b);
+void read_unescape(read_buf_t *b);
+void read_assign(read_buf_t *b, char **names);
+int builtin_read(char **tokens, int line_number, char *program_name);
+size_t arena_pos(void);
+array_t *array_new(void);
+void array_free(array_t *a);
+void array_set(array_t *a, long index, const char *value, size_t len);
+char *array_get(const array_t *a, long index);
+void array_retire(char *text, size_t pos);
+void array_compact(array_t *a, size_t extra);
+void array_clear(array_t *a);
+void array_own(array_t *a);
+array_t *array_copy(const array_t *a);
+char **array_list(array_t *a, int share);
+array_t *var_array(var_t *v);
+int exp_index(expand_t *ex, const char *name, const char *end,
+	      const array_t *a, long *index);
+void exp_array(expand_t *ex, const char *p, const char *stop,
+	       const char *end, int dq);
+int builtin_mapfile(char **tokens, int line_number, char *program_name);
+int builtin_sleep(char **tokens, int line_number, char *program_name);
+int builtin_kill(char **tokens, int line_number, char *program_name);
+int builtin_cd(char **tokens, int line_number, char *program_name);
+int builtin_pwd(char **tokens, int line_number, char *program_name);
+int builtin_source(char **tokens, int line_number, char *program_name);
+int builtin_alias(char **tokens, int line_number, char *program_name);
+int builtin_unalias(char **tokens, int line_number, char *program_name);
+int builtin_enable(char **tokens, int line_number, char *program_name);
 
 
 #endif /* MAIN_H */
@@ -0,0 +1,138 @@
+#include "main.h"
+
+/**
+ * mapfile_options - Parse the options of the mapfile builtin
+ * @tokens: The command and its arguments
+ * @trim: Set to 1 for '-t'
+ * @delim: Set to the character given with '-d', the first of its
+ * argument, or NUL for an empty one
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Return: The name of the array, MAPFILE by default, or NULL after
+ * reporting an error.
+ */
+static char *mapfile_options(char **tokens, int *trim, int *delim,
+			     int line_number, char *program_name)
+{
+	int i;
+
+	for (i = 1; tokens[i] != NULL && tokens[i][0] == '-' &&
+	     tokens[i][1] != '\0'; i++)
+	{
+		if (_strcmp(tokens[i], "--") == 0)
+		{
+			i++;
+			break;
+		}
+		if (_strcmp(tokens[i], "-t") == 0)
+			*trim = 1;
+		else if (tokens[i][1] == 'd' && tokens[i][2] != '\0')
+			*delim = (unsigned char)tokens[i][2];
+		else if (tokens[i][1] == 'd' && tokens[i][2] == '\0' &&
+			 tokens[i + 1] != NULL)
+			*delim = (unsigned char)tokens[++i][0];
+		else
+		{
+			fprintf(stderr, "%s: %d: mapfile: Illegal option "
+				"%.2s\n", program_name, line_number, tokens[i]);
+			return (NULL);
+		}
+	}
+	if (tokens[i] == NULL)
+		return ("MAPFILE");
+	if (valid_name(tokens[i], strlen(tokens[i])))
+		return (tokens[i]);
+	fprintf(stderr, "%s: %d: mapfile: %s: bad variable name\n",
+		program_name, line_number, tokens[i]);
+	return (NULL);
+}
+
+/**
+ * mapfile_slurp - Read all of the standard input
+ * @len: Set to the number of bytes read
+ *
+ * Description: A regular file is read in one call, into a buffer of its
+ * size; anything else in calls that double in size.
+ *
+ * Return: The bytes, to free, or NULL on error.
+ */
+static char *mapfile_slurp(size_t *len)
+{
+	size_t cap = CAT_BUFFER;
+	struct stat st;
+	char *buf = NULL, *grown;
+	ssize_t n = 1;
+
+	if (fstat(STDIN_FILENO, &st) == 0 && S_ISREG(st.st_mode) &&
+	    st.st_size >= (off_t)cap)
+		cap = (size_t)st.st_size + 1;
+	for (*len = 0; n != 0; *len += n > 0 ? (size_t)n : 0)
+	{
+		if (buf == NULL || *len == cap)
+		{
+			cap = buf == NULL ? cap : cap * 2;
+			grown = realloc(buf, cap);
+			if (grown == NULL)
+			{
+				perror("Memory allocation error");
+				exit(EXIT_FAILURE);
+			}
+			buf = grown;
+		}
+		n = read(STDIN_FILENO, buf + *len, cap - *len);
+		if (n == -1 && errno != EINTR)
+		{
+			free(buf);
+			return (NULL);
+		}
+	}
+	return (buf);
+}
+
+/**
+ * builtin_mapfile - Read the lines of the standard input into an array
+ * @tokens: The command, the options '-t' and '-d delim', and the name of
+ * the array
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The input is read whole with as few calls as its size
+ * allows, then cut into elements, so a file of many lines is loaded in
+ * one pass rather than with a read per line, or per byte. '-t' removes
+ * the delimiter from the elements.
+ *
+ * Return: 0 on success, 1 if the input could not be read, 2 on a usage
+ * error.
+ */
+int builtin_mapfile(char **tokens, int line_number, char *program_name)
+{
+	int trim = 0, delim = '\n';
+	char *name = mapfile_options(tokens, &trim, &delim, line_number,
+				     program_name), *buf, *p, *end, *eol;
+	size_t len;
+	array_t *a;
+	long i;
+
+	if (name == NULL)
+		return (2);
+	buf = mapfile_slurp(&len);
+	if (buf == NULL)
+	{
+		fprintf(stderr, "%s: %d: mapfile: read error: %s\n",
+			program_name, line_number, strerror(errno));
+		return (1);
+	}
+	a = var_array(var_lookup(name, strlen(name), 1));
+	array_clear(a);
+	for (p = buf, end = buf + len, i = 0; p < end && i <= ARRAY_INDEX_MAX;
+	     p = eol + 1, i++)
+	{
+		eol = memchr(p, delim, (size_t)(end - p));
+		if (eol == NULL)
+			eol = end;
+		array_set(a, i, p, (size_t)(eol - p) + (!trim && eol < end));
+	}
+	free(buf);
+	return (0);
+}
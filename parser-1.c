@@ -0,0 +1,149 @@
+#include "main.h"
+
+/**
+ * parse_command - Parse a command
+ * @p: The parser
+ *
+ * Description: Reserved words are only recognized where a command name is
+ * expected and when they are not quoted, so 'echo if' and '"if"' are
+ * simple commands. Redirections after a compound command apply to all of
+ * it.
+ *
+ * Return: None.
+ */
+void parse_command(parser_t *p)
+{
+	size_t start = p->prog->code_len;
+
+	if (parse_keyword(p, "if"))
+		parse_if(p);
+	else if (parse_keyword(p, "while") || parse_keyword(p, "until"))
+		parse_while(p);
+	else if (parse_keyword(p, "for"))
+		parse_for(p);
+	else if (parse_keyword(p, "case"))
+		parse_case(p);
+	else if (parse_keyword(p, "{"))
+		parse_brace(p);
+	else if ((p->tok.type != TOK_WORD && !parse_is_redirect(p)) ||
+		 parse_at_end(p))
+		parse_unexpected(p);
+	else
+	{
+		parse_simple_command(p);
+		return;
+	}
+	if (p->status == PARSE_OK && parse_is_redirect(p))
+		parse_compound_redirects(p, start);
+}
+
+/**
+ * parse_simple_command - Parse a simple command and compile it to OP_CMD
+ * @p: The parser, positioned on the command name
+ *
+ * Description: The words are added to the string pool by parse_word.
+ * Redirections may come anywhere among the words and
+ * are compiled after them. The command ends at the first token that is
+ * neither a word nor a redirection, which the caller checks. A name
+ * followed by '(' starts a function definition instead.
+ *
+ * Return: None.
+ */
+void parse_simple_command(parser_t *p)
+{
+	program_t *prog = p->prog;
+	size_t argc_at;
+	uint32_t argc = 0, assigns = 0, nredir = 0, word;
+
+	prog_emit(prog, OP_CMD);
+	prog_emit(prog, (uint32_t)p->tok.line);
+	argc_at = prog->code_len;
+	prog_emit(prog, 0);
+	prog_emit(prog, 0);
+	while (p->status == PARSE_OK &&
+	       (p->tok.type == TOK_WORD || parse_is_redirect(p)))
+	{
+		if (p->tok.type != TOK_WORD)
+		{
+			parse_redirect(p);
+			nredir++;
+			continue;
+		}
+		word = parse_word(p, argc, &assigns);
+		prog_emit(prog, word);
+		argc++;
+		parse_next(p);
+		if (argc == 1 && nredir == 0 && p->tok.type == TOK_LPAREN)
+		{
+			prog->code_len = argc_at - 2;
+			parse_function(p, word);
+			return;
+		}
+	}
+	prog->code[argc_at] = argc;
+	prog->code[argc_at + 1] = nredir;
+	if (nredir > 0 && p->status == PARSE_OK)
+		parse_move_redirects(p, argc_at + 2, argc, nredir);
+}
+
+/**
+ * parse_unexpected - Report the current token as unexpected
+ * @p: The parser
+ *
+ * Description: When the token is the end of the input, or the lexer ran
+ * out of input inside a quote, and more input may follow, the command is
+ * incomplete rather than wrong and the status is set to PARSE_INCOMPLETE.
+ * Otherwise the message is formatted like the ones of /bin/sh.
+ *
+ * Return: None.
+ */
+void parse_unexpected(parser_t *p)
+{
+	static const char * const names[] = {
+		NULL, NULL, "newline", "end of file", NULL, ";", "&", "|", "&&",
+		"||", ";;", "(", ")", "<", ">", ">>", "<<", "<<-", "<<<", "<&",
+		">&", "<>", ">|"
+	};
+	token_t *tok = &p->tok;
+
+	if (p->status != PARSE_OK)
+		return;
+	if (p->lx.incomplete || (tok->type == TOK_EOF && !p->lx.at_eof))
+	{
+		p->status = PARSE_INCOMPLETE;
+		return;
+	}
+	p->status = PARSE_ERROR;
+	if (tok->type == TOK_ERROR)
+		snprintf(p->msg, sizeof(p->msg), "Unterminated quoted string");
+	else if (tok->type == TOK_NEWLINE || tok->type == TOK_EOF)
+		snprintf(p->msg, sizeof(p->msg), "%s unexpected",
+			 names[tok->type]);
+	else if (tok->type == TOK_WORD || tok->type == TOK_IO_NUMBER)
+		snprintf(p->msg, sizeof(p->msg), "\"%.*s\" unexpected",
+			 (int)word_unquote(tok->start, tok->len), tok->start);
+	else
+		snprintf(p->msg, sizeof(p->msg), "\"%s\" unexpected",
+			 names[tok->type]);
+}
+
+/**
+ * word_unquote - Remove the quote markers of a word, in place
+ * @word: The word, as rewritten by the lexer
+ * @len: The length of the word
+ *
+ * Return: The length of the word without its markers.
+ */
+size_t word_unquote(char *word, size_t len)
+{
+	size_t i, j = 0;
+
+	for (i = 0; i < len; i++)
+	{
+		if (word[i] == CTL_ESC && i + 1 < len)
+			word[j++] = word[++i];
+		else if (word[i] != CTL_DQ && word[i] != CTL_SQ)
+			word[j++] = word[i];
+	}
+	return (j);
+}
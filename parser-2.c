@@ -0,0 +1,134 @@
+#include "main.h"
+
+/**
+ * parse_keyword - Check if the current token is a given reserved word
+ * @p: The parser
+ * @word: The reserved word
+ *
+ * Description: A reserved word is only recognized when it is written
+ * without any quoting.
+ *
+ * Return: 1 if the token is @word, 0 otherwise.
+ */
+int parse_keyword(parser_t *p, const char *word)
+{
+	size_t len = strlen(word);
+
+	return (p->tok.type == TOK_WORD && p->tok.flags == 0 &&
+		p->tok.len == len && _strncmp(p->tok.start, word, len) == 0);
+}
+
+/**
+ * parse_at_end - Check if the current token ends a compound list
+ * @p: The parser
+ *
+ * Return: 1 for the reserved words that close or continue a compound
+ * command, ')', ';;' and the end of the input, 0 otherwise.
+ */
+int parse_at_end(parser_t *p)
+{
+	static const char * const words[] = {
+		"then", "else", "elif", "fi", "do", "done", "esac", "}", NULL
+	};
+	int i;
+
+	if (p->tok.type == TOK_EOF || p->tok.type == TOK_RPAREN ||
+	    p->tok.type == TOK_DSEMI)
+		return (1);
+	for (i = 0; p->tok.type == TOK_WORD && words[i] != NULL; i++)
+	{
+		if (parse_keyword(p, words[i]))
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * parse_expect - Consume a reserved word the grammar requires
+ * @p: The parser
+ * @word: The reserved word
+ *
+ * Description: Any other token is a syntax error, reported like /bin/sh
+ * does with the word that was expected, or an incomplete command when the
+ * input ended and more may follow.
+ *
+ * Return: None.
+ */
+void parse_expect(parser_t *p, const char *word)
+{
+	size_t len;
+
+	if (p->status != PARSE_OK)
+		return;
+	if (parse_keyword(p, word))
+	{
+		parse_next(p);
+		return;
+	}
+	parse_unexpected(p);
+	if (p->status == PARSE_ERROR && p->tok.type != TOK_ERROR)
+	{
+		len = strlen(p->msg);
+		snprintf(p->msg + len, sizeof(p->msg) - len,
+			 " (expecting \"%s\")", word);
+	}
+}
+
+/**
+ * parse_compound_list - Parse the list inside a compound command
+ * @p: The parser
+ *
+ * Description: Unlike the list of a complete command, the list may span
+ * several lines: and-or lists are separated by ';' or newlines, and the
+ * list ends at the reserved word, ')' or ';;' that follows it. An empty
+ * list is a syntax error; at the end of the input it is left to the caller
+ * to report, with the reserved word it expected.
+ *
+ * Return: None.
+ */
+void parse_compound_list(parser_t *p)
+{
+	while (p->tok.type == TOK_NEWLINE)
+		parse_next(p);
+	if (parse_at_end(p))
+	{
+		if (p->tok.type != TOK_EOF)
+			parse_unexpected(p);
+		return;
+	}
+	while (p->status == PARSE_OK)
+	{
+		parse_and_or(p);
+		if (p->tok.type != TOK_SEMI && p->tok.type != TOK_NEWLINE)
+			break;
+		parse_next(p);
+		while (p->tok.type == TOK_NEWLINE)
+			parse_next(p);
+		if (parse_at_end(p))
+			break;
+	}
+}
+
+/**
+ * parse_patch - Resolve a chain of forward jumps
+ * @prog: The program
+ * @chain: Index of the operand of the last jump of the chain, or 0
+ * @target: The address the jumps go to
+ *
+ * Description: Until their target is known, the jumps to the end of an if
+ * or case command are linked through their operands, each holding the
+ * index of the previous one, so no list has to be allocated.
+ *
+ * Return: None.
+ */
+void parse_patch(program_t *prog, uint32_t chain, uint32_t target)
+{
+	uint32_t next;
+
+	while (chain != 0)
+	{
+		next = prog->code[chain];
+		prog->code[chain] = target;
+		chain = next;
+	}
+}
@@ -0,0 +1,187 @@
+#include "main.h"
+
+/**
+ * parse_brace - Parse a '{ list; }' group
+ * @p: The parser, positioned on the '{'
+ *
+ * Description: The group runs in the shell itself, so it compiles to the
+ * code of its list and nothing else.
+ *
+ * Return: None.
+ */
+void parse_brace(parser_t *p)
+{
+	parse_next(p);
+	parse_compound_list(p);
+	parse_expect(p, "}");
+}
+
+/**
+ * parse_if - Parse an if command
+ * @p: The parser, positioned on the 'if'
+ *
+ * Description: Each condition is followed by a jump over its branch when it
+ * fails, and each branch by a jump to the end of the command. Without an
+ * else branch, OP_TRUE gives the command a status of 0 when no condition
+ * held, as POSIX requires.
+ *
+ * Return: None.
+ */
+void parse_if(parser_t *p)
+{
+	program_t *prog = p->prog;
+	uint32_t chain = 0;
+	size_t fail;
+
+	parse_next(p);
+	while (p->status == PARSE_OK)
+	{
+		parse_compound_list(p);
+		parse_expect(p, "then");
+		prog_emit(prog, OP_JMP_FAIL);
+		fail = prog->code_len;
+		prog_emit(prog, 0);
+		parse_compound_list(p);
+		prog_emit(prog, OP_JMP);
+		prog_emit(prog, chain);
+		chain = (uint32_t)prog->code_len - 1;
+		prog->code[fail] = (uint32_t)prog->code_len;
+		if (!parse_keyword(p, "elif"))
+			break;
+		parse_next(p);
+	}
+	if (parse_keyword(p, "else"))
+	{
+		parse_next(p);
+		parse_compound_list(p);
+	}
+	else
+		prog_emit(prog, OP_TRUE);
+	parse_expect(p, "fi");
+	parse_patch(prog, chain, (uint32_t)prog->code_len);
+}
+
+/**
+ * parse_while - Parse a while or until loop
+ * @p: The parser, positioned on the 'while' or 'until'
+ *
+ * Description: The loop compiles to
+ *	OP_LOOP done cond; cond: <condition>; OP_JMP_FAIL done; <body>;
+ *	OP_NEXT; done: OP_POP
+ * with OP_JMP_OK for until. The condition and body are compiled once and
+ * run as they are on every iteration.
+ *
+ * Return: None.
+ */
+void parse_while(parser_t *p)
+{
+	program_t *prog = p->prog;
+	int until = parse_keyword(p, "until");
+	size_t loop = prog->code_len, leave;
+
+	prog_emit(prog, OP_LOOP);
+	prog_emit(prog, 0);
+	prog_emit(prog, (uint32_t)loop + 3);
+	parse_next(p);
+	parse_compound_list(p);
+	parse_expect(p, "do");
+	prog_emit(prog, until ? OP_JMP_OK : OP_JMP_FAIL);
+	leave = prog->code_len;
+	prog_emit(prog, 0);
+	parse_compound_list(p);
+	parse_expect(p, "done");
+	prog_emit(prog, OP_NEXT);
+	prog->code[loop + 1] = (uint32_t)prog->code_len;
+	prog->code[leave] = (uint32_t)prog->code_len;
+	prog_emit(prog, OP_POP);
+}
+
+/**
+ * parse_for - Parse a for loop
+ * @p: The parser, positioned on the 'for'
+ *
+ * Description: The loop compiles to
+ *	OP_FOR done name n words...; OP_FOR_NEXT; <body>; OP_NEXT;
+ *	done: OP_POP
+ * with the words already unquoted in the string pool, except those that
+ * need expanding when the loop starts. Without 'in', the
+ * loop starts with OP_FOR_ARGS and iterates over the positional parameters.
+ *
+ * Return: None.
+ */
+void parse_for(parser_t *p)
+{
+	program_t *prog = p->prog;
+	size_t loop = prog->code_len;
+
+	parse_next(p);
+	if (p->tok.type != TOK_WORD)
+		parse_unexpected(p);
+	else if (p->tok.flags != 0 || !valid_name(p->tok.start, p->tok.len))
+	{
+		p->status = PARSE_ERROR;
+		snprintf(p->msg, sizeof(p->msg), "Bad for loop variable");
+	}
+	if (p->status != PARSE_OK)
+		return;
+	prog_emit(prog, OP_FOR_ARGS);
+	prog_emit(prog, 0);
+	prog_emit(prog, prog_add_word(prog, p->tok.start, p->tok.len, 0));
+	parse_next(p);
+	while (p->tok.type == TOK_NEWLINE)
+		parse_next(p);
+	if (parse_keyword(p, "in"))
+		parse_for_words(p, loop);
+	if (p->status == PARSE_OK && p->tok.type == TOK_SEMI)
+		parse_next(p);
+	while (p->tok.type == TOK_NEWLINE)
+		parse_next(p);
+	parse_expect(p, "do");
+	prog_emit(prog, OP_FOR_NEXT);
+	parse_compound_list(p);
+	parse_expect(p, "done");
+	prog_emit(prog, OP_NEXT);
+	prog->code[loop + 1] = (uint32_t)prog->code_len;
+	prog_emit(prog, OP_POP);
+}
+
+/**
+ * parse_function - Parse a function definition
+ * @p: The parser, positioned on the '(' after the name
+ * @name: Offset of the name in the string pool
+ *
+ * Description: The body is compiled in place after an OP_FUNC instruction
+ * that jumps over it, so defining the function does not run it. The name
+ * must be a valid, unquoted name that is not a special builtin.
+ *
+ * Return: None.
+ */
+void parse_function(parser_t *p, uint32_t name)
+{
+	program_t *prog = p->prog;
+	const char *str = prog->strings + name;
+	size_t op;
+
+	if (str[-1] != 0 || !valid_name(str, strlen(str)) ||
+	    is_special_builtin(str))
+	{
+		p->status = PARSE_ERROR;
+		snprintf(p->msg, sizeof(p->msg), "Bad function name");
+		return;
+	}
+	parse_next(p);
+	if (p->tok.type != TOK_RPAREN)
+	{
+		parse_expect(p, ")");
+		return;
+	}
+	parse_next(p);
+	while (p->tok.type == TOK_NEWLINE)
+		parse_next(p);
+	op = prog->code_len;
+	prog_emit(prog, OP_FUNC);
+	prog_emit(prog, name);
+	prog_emit(prog, 0);
+	parse_command(p);
+	prog->code[op + 2] = (uint32_t)prog->code_len;
+}
@@ -0,0 +1,194 @@
+#include "main.h"
+
+/**
+ * case_item_add - Record a pattern of a case command
+ * @items: The array of (pattern offset, address) pairs
+ * @n: The number of pairs in the array
+ * @cap: The number of pairs the array can hold
+ * @pattern: The offset of the pattern
+ * @target: The address of the code run when the pattern matches
+ *
+ * Return: None.
+ */
+static void case_item_add(uint32_t **items, uint32_t n, uint32_t *cap,
+			  uint32_t pattern, uint32_t target)
+{
+	uint32_t *grown;
+
+	if (n == *cap)
+	{
+		*cap = *cap ? *cap * 2 : 8;
+		grown = realloc(*items, *cap * 2 * sizeof(**items));
+		if (grown == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		*items = grown;
+	}
+	(*items)[2 * n] = pattern;
+	(*items)[2 * n + 1] = target;
+}
+
+/**
+ * case_word - Parse the word of a case command, up to the 'in'
+ * @p: The parser, positioned on the 'case'
+ *
+ * Description: The OP_CASE is emitted with the address of its table left
+ * at 0, for parse_case to fill in once the table is written.
+ *
+ * Return: None.
+ */
+static void case_word(parser_t *p)
+{
+	program_t *prog = p->prog;
+	size_t len;
+
+	prog_emit(prog, OP_CASE);
+	prog_emit(prog, (uint32_t)p->tok.line);
+	parse_next(p);
+	if (p->tok.type != TOK_WORD)
+		parse_unexpected(p);
+	if (p->status != PARSE_OK)
+		return;
+	len = p->tok.len;
+	if (!(p->tok.flags & (WORD_DOLLAR | WORD_TILDE)))
+		len = word_unquote(p->tok.start, len);
+	prog_emit(prog, prog_add_word(prog, p->tok.start, len, p->tok.flags));
+	prog_emit(prog, 0);
+	parse_next(p);
+	while (p->tok.type == TOK_NEWLINE)
+		parse_next(p);
+	parse_expect(p, "in");
+	while (p->tok.type == TOK_NEWLINE)
+		parse_next(p);
+}
+
+/**
+ * case_patterns - Parse the patterns of a case item, up to the ')'
+ * @p: The parser, positioned on the '(' or the first pattern
+ * @items: The array of (pattern offset, address) pairs
+ * @n: The number of pairs in the array
+ * @cap: The number of pairs the array can hold
+ *
+ * Description: Each pattern is recorded with the address of the code that
+ * follows, which is where the body of the item is about to be compiled.
+ *
+ * Return: None.
+ */
+static void case_patterns(parser_t *p, uint32_t **items, uint32_t *n,
+			  uint32_t *cap)
+{
+	uint32_t target = (uint32_t)p->prog->code_len, first = *n;
+
+	if (p->tok.type == TOK_LPAREN)
+		parse_next(p);
+	while (p->tok.type == TOK_WORD)
+	{
+		case_item_add(items, (*n)++, cap, parse_pattern(p->prog,
+			      p->tok.start, p->tok.len, p->tok.flags), target);
+		parse_next(p);
+		if (p->tok.type != TOK_PIPE)
+			break;
+		parse_next(p);
+	}
+	if (p->tok.type != TOK_RPAREN || *n == first)
+		parse_unexpected(p);
+}
+
+/**
+ * parse_case - Parse a case command
+ * @p: The parser, positioned on the 'case'
+ *
+ * Description: The command compiles to
+ *	OP_CASE line word table; <body 1>; OP_JMP end; ... <body n>;
+ *	OP_JMP end; table: OP_CASE_TABLE ...; end:
+ * The patterns are collected while the bodies are compiled and written
+ * once into the table that ends the command, see emit_case_table.
+ *
+ * Return: None.
+ */
+void parse_case(parser_t *p)
+{
+	program_t *prog = p->prog;
+	uint32_t *items = NULL, n = 0, cap = 0, chain = 0;
+	size_t op = prog->code_len;
+
+	case_word(p);
+	while (p->status == PARSE_OK && !parse_keyword(p, "esac"))
+	{
+		case_patterns(p, &items, &n, &cap);
+		if (p->status != PARSE_OK)
+			break;
+		parse_next(p);
+		while (p->tok.type == TOK_NEWLINE)
+			parse_next(p);
+		if (p->tok.type != TOK_DSEMI && !parse_keyword(p, "esac"))
+			parse_compound_list(p);
+		prog_emit(prog, OP_JMP);
+		prog_emit(prog, chain);
+		chain = (uint32_t)prog->code_len - 1;
+		if (p->status != PARSE_OK || p->tok.type != TOK_DSEMI)
+			break;
+		parse_next(p);
+		while (p->tok.type == TOK_NEWLINE)
+			parse_next(p);
+	}
+	parse_expect(p, "esac");
+	if (p->status == PARSE_OK)
+	{
+		prog->code[op + 3] = (uint32_t)emit_case_table(prog, items, n);
+		parse_patch(prog, chain, (uint32_t)prog->code_len);
+	}
+	free(items);
+}
+
+/**
+ * emit_case_table - Emit the OP_CASE_TABLE of a case command
+ * @prog: The program being compiled
+ * @items: The (pattern offset, address) pairs, in the order written
+ * @n: The number of pairs
+ *
+ * Description: The literal patterns are entered in an open-addressing hash
+ * table at least twice as large as the number of patterns, so vm_case
+ * finds the one matching a word with a single hash instead of comparing
+ * the word with every pattern in turn. Only the glob patterns written
+ * before that one still have to be tried, in order.
+ *
+ * Return: The address of the table.
+ */
+size_t emit_case_table(program_t *prog, const uint32_t *items, uint32_t n)
+{
+	size_t table = prog->code_len, slots;
+	uint32_t hsize = 2, i, mask, slot, *code;
+	const char *pattern, *other;
+
+	while (hsize < 2 * n + 1)
+		hsize *= 2;
+	prog_emit(prog, OP_CASE_TABLE);
+	prog_emit(prog, n);
+	prog_emit(prog, hsize);
+	for (i = 0; i < 2 * n; i++)
+		prog_emit(prog, items[i]);
+	slots = prog->code_len;
+	for (i = 0; i < hsize; i++)
+		prog_emit(prog, 0);
+	code = prog->code + slots;
+	mask = hsize - 1;
+	for (i = 0; i < n; i++)
+	{
+		pattern = prog->strings + items[2 * i];
+		if (pattern[-1] & (WORD_GLOB | WORD_DOLLAR | WORD_TILDE))
+			continue;
+		slot = (uint32_t)(hash_string(pattern) & mask);
+		for (; code[slot] != 0; slot = (slot + 1) & mask)
+		{
+			other = prog->strings + items[2 * (code[slot] - 1)];
+			if (_strcmp(other, pattern) == 0)
+				break;
+		}
+		if (code[slot] == 0)
+			code[slot] = i + 1;
+	}
+	return (table);
+}
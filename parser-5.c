@@ -0,0 +1,194 @@
+#include "main.h"
+
+/**
+ * parse_is_redirect - Check if the current token starts a redirection
+ * @p: The parser
+ *
+ * Return: 1 for a descriptor number or a redirection operator, 0
+ * otherwise.
+ */
+int parse_is_redirect(parser_t *p)
+{
+	switch (p->tok.type)
+	{
+	case TOK_IO_NUMBER:
+	case TOK_LESS:
+	case TOK_GREAT:
+	case TOK_DGREAT:
+	case TOK_DLESS:
+	case TOK_DLESSDASH:
+	case TOK_TLESS:
+	case TOK_LESSAND:
+	case TOK_GREATAND:
+	case TOK_LESSGREAT:
+	case TOK_CLOBBER:
+		return (1);
+	}
+	return (0);
+}
+
+/**
+ * parse_file_word - Read the word of a redirection to a file or descriptor
+ * @p: The parser, positioned on the word
+ * @kind: The kind of the redirection
+ * @word: Where the string pool offset of the word is stored
+ *
+ * Description: The word is unquoted here unless it has something to
+ * expand. A '<&' or '>&' whose word is neither a number nor '-' is a
+ * syntax error, like in /bin/sh.
+ *
+ * Return: 0 on success, -1 on a syntax error.
+ */
+static int parse_file_word(parser_t *p, int kind, uint32_t *word)
+{
+	char *w = p->tok.start;
+	size_t len = p->tok.len, i = 0;
+
+	if (!(p->tok.flags & (WORD_DOLLAR | WORD_TILDE)))
+		len = word_unquote(w, len);
+	if (kind == REDIR_DUP && !(p->tok.flags & WORD_DOLLAR) &&
+	    !(len == 1 && *w == '-'))
+	{
+		while (i < len && i < 5 && isdigit((unsigned char)w[i]))
+			i++;
+		if (len == 0 || i != len)
+		{
+			p->status = PARSE_ERROR;
+			snprintf(p->msg, sizeof(p->msg), "Bad fd number");
+			return (-1);
+		}
+	}
+	*word = prog_add_word(p->prog, w, len, p->tok.flags);
+	return (0);
+}
+
+/**
+ * parse_here - Read the delimiter of a here-document
+ * @p: The parser, positioned on the word
+ * @type: TOK_DLESS or TOK_DLESSDASH
+ * @word: Where the string pool offset of the word is stored
+ *
+ * Description: The delimiter is emitted in place of the body until
+ * parse_heredocs reads the body after the next newline and stores it in
+ * the operand instead. Quoting any part of the delimiter leaves the body
+ * unexpanded.
+ *
+ * Return: 0 on success, -1 if too many here-documents are pending.
+ */
+static int parse_here(parser_t *p, int type, uint32_t *word)
+{
+	heredoc_t *h = &p->heredocs[p->nheredoc];
+	size_t len = word_unquote(p->tok.start, p->tok.len);
+
+	if (p->nheredoc == HEREDOC_MAX)
+	{
+		p->status = PARSE_ERROR;
+		snprintf(p->msg, sizeof(p->msg), "Too many here-documents");
+		return (-1);
+	}
+	h->slot = p->prog->code_len + 1;
+	h->delim = p->tok.start;
+	h->delim_len = len;
+	h->quoted = (p->tok.flags & WORD_QUOTED) != 0;
+	h->strip = type == TOK_DLESSDASH;
+	p->nheredoc++;
+	*word = prog_add_word(p->prog, p->tok.start, len, 0);
+	return (0);
+}
+
+/**
+ * parse_redirect - Parse a redirection of a simple command
+ * @p: The parser, positioned on the descriptor number or the operator
+ *
+ * Description: The spec of the redirection, marked with REDIR_MARK, and
+ * its word are emitted where they appear among the words of the command;
+ * parse_move_redirects puts them after the words once the command ends.
+ * The word of a here-string is read like the name of a file.
+ *
+ * Return: None.
+ */
+void parse_redirect(parser_t *p)
+{
+	static const int kinds[] = {REDIR_IN, REDIR_OUT, REDIR_APPEND,
+		REDIR_HEREDOC, REDIR_HEREDOC, REDIR_HERESTRING, REDIR_DUP,
+		REDIR_DUP, REDIR_RDWR, REDIR_OUT};
+	int fd = -1, kind, type, ret;
+	uint32_t word;
+
+	if (p->tok.type == TOK_IO_NUMBER)
+	{
+		fd = 99999;
+		if (p->tok.len <= 5)
+			fd = _atoi(p->tok.start, (int)p->tok.len);
+		parse_next(p);
+	}
+	type = p->tok.type;
+	if (type < TOK_LESS || type > TOK_CLOBBER)
+	{
+		parse_unexpected(p);
+		return;
+	}
+	kind = kinds[type - TOK_LESS];
+	if (fd == -1)
+		fd = kind == REDIR_OUT || kind == REDIR_APPEND ||
+			type == TOK_GREATAND ? 1 : 0;
+	parse_next(p);
+	if (p->tok.type != TOK_WORD)
+	{
+		parse_unexpected(p);
+		return;
+	}
+	ret = kind == REDIR_HEREDOC ? parse_here(p, type, &word) :
+		parse_file_word(p, kind, &word);
+	if (ret == -1)
+		return;
+	prog_emit(p->prog, REDIR_MARK | (uint32_t)fd << 8 | (uint32_t)kind);
+	prog_emit(p->prog, word);
+	parse_next(p);
+}
+
+/**
+ * parse_move_redirects - Put the redirections of a command after its words
+ * @p: The parser
+ * @start: Index of the first word or redirection of the OP_CMD
+ * @argc: The number of words
+ * @nredir: The number of redirections
+ *
+ * Description: The words keep their order, and so do the redirections,
+ * which are applied from left to right. The words are moved down in place
+ * and the redirections go through a small copy. The operands waiting for
+ * the body of a here-document are followed to their new place.
+ *
+ * Return: None.
+ */
+void parse_move_redirects(parser_t *p, size_t start, uint32_t argc,
+			  uint32_t nredir)
+{
+	uint32_t *code = p->prog->code, *redirs;
+	size_t end = start + argc + 2 * (size_t)nredir, i, w = start, r = 0;
+	size_t h, base = start + argc;
+
+	redirs = malloc(2 * (size_t)nredir * sizeof(*redirs));
+	if (redirs == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = start; i < end; i++)
+	{
+		if (code[i] & REDIR_MARK)
+		{
+			for (h = 0; h < p->nheredoc; h++)
+			{
+				if (p->heredocs[h].slot == i + 1)
+					p->heredocs[h].slot = base + r + 1;
+			}
+			redirs[r++] = code[i] & ~REDIR_MARK;
+			redirs[r++] = code[++i];
+		}
+		else
+			code[w++] = code[i];
+	}
+	memcpy(code + w, redirs, r * sizeof(*redirs));
+	free(redirs);
+}
@@ -0,0 +1,151 @@
+#include "main.h"
+
+/**
+ * heredoc_line - Copy a line of a here-document whose delimiter is unquoted
+ * @out: Where the line is written
+ * @line: The start of the line
+ * @end: Its end, after the newline if there is one
+ * @flags: The WORD_ flags of the body, WORD_DOLLAR added if needed
+ *
+ * Description: The line is rewritten like a word inside double quotes,
+ * except that a '"' stays an ordinary character: a backslash quotes only
+ * '$', '`' and '\' and is removed with a newline that follows it, and the
+ * substitutions are copied for expand_string to expand.
+ *
+ * Return: The number of bytes written.
+ */
+static size_t heredoc_line(char *out, char *line, char *end, int *flags)
+{
+	lexer_t lx;
+
+	lex_init(&lx, line, (size_t)(end - line), 0, 1);
+	lx.out = out;
+	while (lx.pos < lx.end)
+	{
+		if (*lx.pos == '\\' && lx.pos + 1 < lx.end &&
+		    lx.pos[1] == '\n')
+			lx.pos += 2;
+		else if (*lx.pos == '\\' && lx.pos + 1 < lx.end &&
+			 _strchr("$`\\", lx.pos[1]) != NULL)
+		{
+			*lx.out++ = CTL_ESC;
+			*lx.out++ = lx.pos[1];
+			lx.pos += 2;
+		}
+		else if (*lx.pos == '$')
+			lex_dollar(&lx);
+		else if (*lx.pos == '`')
+			lex_backquote(&lx);
+		else
+			*lx.out++ = *lx.pos++;
+	}
+	*flags |= lx.flags;
+	return ((size_t)(lx.out - out));
+}
+
+/**
+ * heredoc_body - Store the body of a here-document in the string pool
+ * @p: The parser
+ * @h: The here-document
+ * @buf: The body, rewritten after the byte reserved at its start
+ * @len: The length of the body, without the reserved byte
+ * @flags: The WORD_ flags of the body
+ *
+ * Description: A body with substitutions is kept between CTL_DQ markers,
+ * so that expand_string expands it as if it were in double quotes. Any
+ * other body is unquoted once and for all, so it is used as it is.
+ *
+ * Return: None.
+ */
+static void heredoc_body(parser_t *p, heredoc_t *h, char *buf, size_t len,
+			 int flags)
+{
+	if (flags & WORD_DOLLAR)
+	{
+		buf[0] = CTL_DQ;
+		buf[len + 1] = CTL_DQ;
+		p->prog->code[h->slot] = prog_add_word(p->prog, buf, len + 2,
+						       flags);
+		return;
+	}
+	if (!h->quoted)
+		len = word_unquote(buf + 1, len);
+	p->prog->code[h->slot] = prog_add_word(p->prog, buf + 1, len, 0);
+}
+
+/**
+ * heredoc_read - Read the body of a here-document
+ * @p: The parser, whose lexer is at the start of the body
+ * @h: The here-document
+ *
+ * Description: The body is made of the lines up to the one that is the
+ * delimiter, after the leading tabs of each line are removed for '<<-'.
+ * At the end of the input the body ends too, as in /bin/sh.
+ *
+ * Return: 0 on success, -1 if the input ended before the delimiter and
+ * more input may follow.
+ */
+static int heredoc_read(parser_t *p, heredoc_t *h)
+{
+	lexer_t *lx = &p->lx;
+	char *buf = malloc((size_t)(lx->end - lx->pos) + 2), *line, *eol;
+	size_t len = 0, n;
+	int flags = 0, found = 0;
+
+	if (buf == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	while (lx->pos < lx->end)
+	{
+		eol = memchr(lx->pos, '\n', (size_t)(lx->end - lx->pos));
+		if (eol == NULL && !lx->at_eof)
+			break;
+		eol = eol == NULL ? lx->end : eol + 1;
+		for (line = lx->pos; h->strip && *line == '\t'; line++)
+			;
+		lx->pos = eol;
+		lx->line++;
+		n = (size_t)(eol - line) - (eol[-1] == '\n');
+		found = n == h->delim_len &&
+			_strncmp(line, h->delim, h->delim_len) == 0;
+		if (found)
+			break;
+		if (h->quoted)
+			memcpy(buf + 1 + len, line, (size_t)(eol - line));
+		len += h->quoted ? (size_t)(eol - line) :
+			heredoc_line(buf + 1 + len, line, eol, &flags);
+	}
+	if (!found && !lx->at_eof)
+	{
+		free(buf);
+		return (-1);
+	}
+	heredoc_body(p, h, buf, len, flags);
+	free(buf);
+	return (0);
+}
+
+/**
+ * parse_heredocs - Read the bodies of the pending here-documents
+ * @p: The parser, whose lexer is after a newline or at the end of the input
+ *
+ * Description: The bodies follow the newline in the order of their
+ * redirections. Each one is stored in the operand left for it by
+ * parse_redirect. Running out of input before a delimiter makes the
+ * command incomplete, so more input is read and the command lexed again.
+ *
+ * Return: None.
+ */
+void parse_heredocs(parser_t *p)
+{
+	size_t i;
+
+	for (i = 0; i < p->nheredoc && p->status == PARSE_OK; i++)
+	{
+		if (heredoc_read(p, &p->heredocs[i]) == -1)
+			p->status = PARSE_INCOMPLETE;
+	}
+	p->nheredoc = 0;
+}
@@ -0,0 +1,89 @@
+#include "main.h"
+
+/**
+ * relocate_body - Follow a compound command moved down in the code array
+ * @p: The parser
+ * @start: Index the command started at
+ * @end: Index it ended at, before it moved
+ * @shift: The number of words it moved by
+ *
+ * Description: The addresses the command jumps to all lie within it, or at
+ * its end, which is now the OP_REDIR_END. The operands waiting for the body
+ * of a here-document move with the command, and those of the redirections
+ * go to their place in the OP_REDIR.
+ *
+ * Return: None.
+ */
+static void relocate_body(parser_t *p, size_t start, size_t end,
+			  size_t shift)
+{
+	uint32_t *code = p->prog->code;
+	size_t pc, i, len, h, *slot;
+
+	for (pc = start + shift; pc < end + shift; pc += len)
+	{
+		len = op_length(code + pc);
+		for (i = 1; i < len; i++)
+			if (op_operand(code + pc, i) == OPND_ADDRESS &&
+			    code[pc + i] >= start)
+				code[pc + i] += (uint32_t)shift;
+	}
+	for (h = 0; h < p->nheredoc; h++)
+	{
+		slot = &p->heredocs[h].slot;
+		if (*slot > end)
+			*slot = *slot - end + start + 4;
+		else if (*slot >= start)
+			*slot += shift;
+	}
+}
+
+/**
+ * parse_compound_redirects - Parse the redirections of a compound command
+ * @p: The parser, positioned on the first redirection
+ * @start: Index of the first instruction of the command
+ *
+ * Description: The redirections are only seen once the command has been
+ * compiled, so they are parsed after it like those of a simple command,
+ * and the command is then moved down to make room for an OP_REDIR in
+ * front of it. An OP_REDIR_END after it undoes the redirections.
+ *
+ * Return: None.
+ */
+void parse_compound_redirects(parser_t *p, size_t start)
+{
+	program_t *prog = p->prog;
+	size_t end = prog->code_len, n = 0, hdr, i;
+	int line = p->tok.line;
+	uint32_t *redirs;
+
+	while (p->status == PARSE_OK && parse_is_redirect(p))
+	{
+		parse_redirect(p);
+		n++;
+	}
+	if (p->status != PARSE_OK)
+		return;
+	hdr = 4 + 2 * n;
+	redirs = malloc(2 * n * sizeof(*redirs));
+	if (redirs == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < 2 * n; i++)
+		redirs[i] = prog->code[end + i] & ~REDIR_MARK;
+	for (i = 0; i < 5; i++)
+		prog_emit(prog, OP_END);
+	memmove(prog->code + start + hdr, prog->code + start,
+		(end - start) * sizeof(*prog->code));
+	relocate_body(p, start, end, hdr);
+	prog->code[start] = OP_REDIR;
+	prog->code[start + 1] = (uint32_t)line;
+	prog->code[start + 2] = (uint32_t)(end + hdr + 1);
+	prog->code[start + 3] = (uint32_t)n;
+	memcpy(prog->code + start + 4, redirs, 2 * n * sizeof(*redirs));
+	prog->code[end + hdr] = OP_REDIR_END;
+	prog->code_len = end + hdr + 1;
+	free(redirs);
+}
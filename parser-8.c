@@ -0,0 +1,172 @@
+#include "main.h"
+
+/**
+ * is_assignment - Check if a word is an assignment
+ * @word: The word, as rewritten by the lexer
+ * @len: The length of the word
+ *
+ * Return: 1 if the word starts with an unquoted valid name, optionally
+ * followed by a subscript in brackets, and then '=', 0 otherwise.
+ */
+static int is_assignment(const char *word, size_t len)
+{
+	size_t i, name;
+
+	for (i = 0; i < len && word[i] != '=' && word[i] != '['; i++)
+	{
+		if (word[i] != '_' && !isalnum((unsigned char)word[i]))
+			return (0);
+	}
+	name = i;
+	if (i < len && word[i] == '[')
+	{
+		while (i < len && word[i] != ']' && word[i] != '=')
+			i++;
+		if (i == name + 1 || i + 1 >= len || word[i] != ']' ||
+		    word[++i] != '=')
+			return (0);
+	}
+	return (i < len && valid_name(word, name));
+}
+
+/**
+ * pattern_escape - Write a glob pattern with its quoted characters escaped
+ * @word: The pattern, as rewritten by the lexer
+ * @len: The length of the pattern
+ * @buf: Where the pattern is written, at least 2 * @len bytes
+ *
+ * Description: The quote markers are dropped, and the characters they
+ * quoted that glob_match would otherwise take specially are preceded by
+ * a backslash, like those quoted with a backslash.
+ *
+ * Return: The length of the pattern written.
+ */
+static size_t pattern_escape(const char *word, size_t len, char *buf)
+{
+	size_t i, j = 0;
+	int quoted = 0;
+
+	for (i = 0; i < len; i++)
+	{
+		if (word[i] == CTL_SQ || word[i] == CTL_DQ)
+			quoted = !quoted;
+		else if (word[i] == CTL_ESC ||
+			 (quoted && _strchr("*?[\\", word[i]) != NULL))
+		{
+			buf[j++] = '\\';
+			buf[j++] = word[i] == CTL_ESC ? word[++i] : word[i];
+		}
+		else
+			buf[j++] = word[i];
+	}
+	return (j);
+}
+
+/**
+ * parse_pattern - Add a case pattern to the string pool
+ * @prog: The program being compiled
+ * @word: The pattern, as rewritten by the lexer
+ * @len: The length of the pattern
+ * @flags: The WORD_ flags of the pattern
+ *
+ * Description: A pattern with a parameter to expand is stored as the lexer
+ * rewrote it, for vm_case to expand. A pattern without unquoted '*', '?'
+ * or '[' can only match itself, so it is stored unquoted and marked as a
+ * literal. Any other pattern is stored marked with WORD_GLOB, its quoted
+ * characters escaped with a backslash so that glob_match takes them
+ * literally.
+ *
+ * Return: The offset of the pattern in the string pool.
+ */
+uint32_t parse_pattern(program_t *prog, char *word, size_t len, int flags)
+{
+	size_t i;
+	int quoted = 0, glob = 0;
+	char *buf;
+	uint32_t offset;
+
+	if (flags & (WORD_DOLLAR | WORD_TILDE))
+		return (prog_add_word(prog, word, len,
+				      flags & (WORD_DOLLAR | WORD_TILDE)));
+	for (i = 0; i < len; i++)
+	{
+		if (word[i] == CTL_ESC)
+			i++;
+		else if (word[i] == CTL_SQ || word[i] == CTL_DQ)
+			quoted = !quoted;
+		else if (!quoted && _strchr("*?[", word[i]) != NULL)
+			glob = 1;
+	}
+	if (!glob)
+		return (prog_add_word(prog, word, word_unquote(word, len), 0));
+	buf = malloc(2 * len + 1);
+	if (buf == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	offset = prog_add_word(prog, buf, pattern_escape(word, len, buf),
+			       WORD_GLOB);
+	free(buf);
+	return (offset);
+}
+
+/**
+ * parse_word - Add a word of a simple command to the string pool
+ * @p: The parser, positioned on the word
+ * @argc: The number of words of the command before this one
+ * @assigns: The number of assignments among them, incremented if this
+ * word is one too
+ *
+ * Description: Quote removal is done here, once, so running the command
+ * only has to point its arguments into the string pool. Only the words
+ * with a parameter or a tilde prefix to expand keep their quote markers,
+ * for expand_command. The assignments that start the command are marked
+ * with WORD_ASSIGN.
+ *
+ * Return: The offset of the word in the string pool.
+ */
+uint32_t parse_word(parser_t *p, uint32_t argc, uint32_t *assigns)
+{
+	int flags = p->tok.flags;
+	size_t len = p->tok.len;
+
+	if (argc == *assigns && is_assignment(p->tok.start, len))
+	{
+		flags |= WORD_ASSIGN;
+		(*assigns)++;
+	}
+	if (!(flags & (WORD_DOLLAR | WORD_TILDE | WORD_GLOB)))
+		len = word_unquote(p->tok.start, len);
+	return (prog_add_word(p->prog, p->tok.start, len, flags));
+}
+
+/**
+ * parse_for_words - Parse the words of a for loop, after its 'in'
+ * @p: The parser, positioned on the 'in'
+ * @loop: Index of the loop's OP_FOR_ARGS, which becomes an OP_FOR
+ *
+ * Description: The words are unquoted in the string pool, except those
+ * that need expanding when the loop starts, and counted in the OP_FOR.
+ *
+ * Return: None.
+ */
+void parse_for_words(parser_t *p, size_t loop)
+{
+	program_t *prog = p->prog;
+	size_t len;
+
+	prog->code[loop] = OP_FOR;
+	prog_emit(prog, 0);
+	for (parse_next(p); p->tok.type == TOK_WORD; parse_next(p))
+	{
+		len = p->tok.len;
+		if (!(p->tok.flags & (WORD_DOLLAR | WORD_TILDE | WORD_GLOB)))
+			len = word_unquote(p->tok.start, len);
+		prog_emit(prog, prog_add_word(prog, p->tok.start, len,
+					      p->tok.flags));
+		prog->code[loop + 3]++;
+	}
+	if (p->tok.type != TOK_SEMI && p->tok.type != TOK_NEWLINE)
+		parse_unexpected(p);
+}
@@ -0,0 +1,150 @@
+#include "main.h"
+
+/**
+ * parse_next - Advance the parser to the next token
+ * @p: The parser
+ *
+ * Description: The bodies of the here-documents redirected on a line are
+ * read as soon as the newline that ends it is.
+ *
+ * Return: None.
+ */
+void parse_next(parser_t *p)
+{
+	lex_next(&p->lx, &p->tok);
+	if (p->nheredoc > 0 &&
+	    (p->tok.type == TOK_NEWLINE || p->tok.type == TOK_EOF))
+		parse_heredocs(p);
+}
+
+/**
+ * parse_program - Compile shell input to bytecode
+ * @prog: The program to append the code to
+ * @buf: The input; it is rewritten in place by the lexer
+ * @len: The length of the input
+ * @line: The line number of the first line of the input
+ * @at_eof: Non-zero if no input can follow @buf
+ *
+ * Description: The input is lexed and parsed in a single pass, the parser
+ * emitting code as soon as it has recognized each construct. On a syntax
+ * error, the code of the complete command containing the error is dropped
+ * and replaced by an OP_SYNTAX instruction, so the commands before it still
+ * run and the error is reported when execution reaches it, like /bin/sh
+ * does. The program is always terminated with OP_END.
+ *
+ * Return: PARSE_INCOMPLETE if the input ends inside a command and more
+ * input may follow, PARSE_OK otherwise.
+ */
+int parse_program(program_t *prog, char *buf, size_t len, int line,
+		  int at_eof)
+{
+	parser_t p;
+	size_t code_mark = prog->code_len, str_mark = prog->str_len;
+
+	lex_init(&p.lx, buf, len, line, at_eof);
+	p.prog = prog;
+	p.status = PARSE_OK;
+	p.nheredoc = 0;
+	parse_next(&p);
+	while (p.status == PARSE_OK)
+	{
+		while (p.tok.type == TOK_NEWLINE)
+			parse_next(&p);
+		if (p.tok.type == TOK_EOF)
+			break;
+		code_mark = prog->code_len;
+		str_mark = prog->str_len;
+		parse_list(&p);
+		if (p.tok.type != TOK_NEWLINE && p.tok.type != TOK_EOF)
+			parse_unexpected(&p);
+	}
+	if (p.status == PARSE_ERROR)
+	{
+		prog->code_len = code_mark;
+		prog->str_len = str_mark;
+		prog_emit(prog, OP_SYNTAX);
+		prog_emit(prog, (uint32_t)p.lx.line);
+		prog_emit(prog, prog_add_word(prog, p.msg, strlen(p.msg), 0));
+	}
+	prog_emit(prog, OP_END);
+	return (p.status == PARSE_INCOMPLETE ? PARSE_INCOMPLETE : PARSE_OK);
+}
+
+/**
+ * parse_list - Parse and-or lists separated by ';'
+ * @p: The parser
+ *
+ * Description: This is the list of a complete command, which ends at a
+ * newline or at the end of the input; a trailing ';' is allowed. Lists
+ * inside compound commands are parsed by parse_compound_list. Asynchronous
+ * lists are not supported yet, so '&' is a syntax error.
+ *
+ * Return: None.
+ */
+void parse_list(parser_t *p)
+{
+	parse_and_or(p);
+	while (p->status == PARSE_OK && p->tok.type == TOK_SEMI)
+	{
+		parse_next(p);
+		if (p->tok.type == TOK_NEWLINE || p->tok.type == TOK_EOF)
+			break;
+		parse_and_or(p);
+	}
+}
+
+/**
+ * parse_and_or - Parse pipelines joined by '&&' and '||'
+ * @p: The parser
+ *
+ * Description: Each operator compiles to a conditional jump over the
+ * pipeline that follows it, taken on the status left by the code before
+ * it. Since a skipped pipeline leaves that status unchanged, the jump of
+ * the next operator sees the same status, which gives '&&' and '||' their
+ * equal, left-associative precedence. A newline may follow an operator.
+ *
+ * Return: None.
+ */
+void parse_and_or(parser_t *p)
+{
+	size_t jump;
+
+	parse_pipeline(p);
+	while (p->status == PARSE_OK &&
+	       (p->tok.type == TOK_AND_IF || p->tok.type == TOK_OR_IF))
+	{
+		prog_emit(p->prog, p->tok.type == TOK_AND_IF ? OP_JMP_FAIL :
+			  OP_JMP_OK);
+		jump = p->prog->code_len;
+		prog_emit(p->prog, 0);
+		parse_next(p);
+		while (p->tok.type == TOK_NEWLINE)
+			parse_next(p);
+		parse_pipeline(p);
+		p->prog->code[jump] = (uint32_t)p->prog->code_len;
+	}
+}
+
+/**
+ * parse_pipeline - Parse a command, optionally preceded by '!'
+ * @p: The parser
+ *
+ * Description: Pipes are not supported yet, so '|' is a syntax error.
+ *
+ * Return: None.
+ */
+void parse_pipeline(parser_t *p)
+{
+	int negate = 0;
+
+	if (parse_keyword(p, "!"))
+	{
+		negate = 1;
+		parse_next(p);
+	}
+	parse_command(p);
+	if (p->status == PARSE_OK && p->tok.type == TOK_PIPE)
+		parse_unexpected(p);
+	if (negate)
+		prog_emit(p->prog, OP_NOT);
+}
@@ -4,8 +4,8 @@
  * execute_env - Execute the 'env' command
  *
  * Description: This function prints the current environment to the standard
- * output. It iterates through the `environ` variable, which is an array of
- * strings representing the environment variables in the format "key=value".
+ * output. It iterates through the array returned by var_environ, which holds
+ * the exported variables as strings in the format "key=value".
  * Each key-value pair is printed on a separate line. The function stops when
  * it encounters a NULL value, indicating the end of the environment variables.
  *
@@ -14,7 +14,7 @@
 
 void execute_env(void)
 {
-	char **env = environ;
+	char **env = var_environ();
 
 	while (*env != NULL)
 	{
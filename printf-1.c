@@ -0,0 +1,131 @@
+#include "main.h"
+
+/**
+ * printf_next - Take the next argument of printf
+ * @pf: The state of printf
+ *
+ * Return: The argument, or an empty string once they are all used.
+ */
+static const char *printf_next(printf_t *pf)
+{
+	if (*pf->argv == NULL)
+		return ("");
+	return (*pf->argv++);
+}
+
+/**
+ * printf_check - Report an argument that is not entirely a number
+ * @pf: The state of printf, whose status becomes 1 on error
+ * @arg: The argument
+ * @end: Where the conversion of @arg stopped
+ *
+ * Description: The messages are those of /bin/sh, and as there, the part
+ * that was converted is still used.
+ *
+ * Return: None.
+ */
+static void printf_check(printf_t *pf, const char *arg, const char *end)
+{
+	const char *msg = NULL;
+
+	if (errno == ERANGE)
+		msg = strerror(ERANGE);
+	else if (end == arg && *arg != '\0')
+		msg = "expected numeric value";
+	else if (*end != '\0')
+		msg = "not completely converted";
+	if (msg == NULL)
+		return;
+	fprintf(stderr, "%s: %d: printf: %s: %s\n", pf->program_name,
+		pf->line, arg, msg);
+	pf->status = 1;
+}
+
+/**
+ * printf_long - Take the next argument of printf as an integer
+ * @pf: The state of printf
+ * @sign: Non-zero for a signed conversion
+ *
+ * Description: An argument starting with a quote stands for the code of
+ * the character after it, as POSIX requires.
+ *
+ * Return: The value.
+ */
+long printf_long(printf_t *pf, int sign)
+{
+	const char *arg = printf_next(pf);
+	char *end;
+	long n;
+
+	if (*arg == '\'' || *arg == '"')
+		return ((unsigned char)arg[1]);
+	errno = 0;
+	if (sign)
+		n = strtol(arg, &end, 0);
+	else
+		n = (long)strtoul(arg, &end, 0);
+	printf_check(pf, arg, end);
+	return (n);
+}
+
+/**
+ * printf_double - Take the next argument of printf as a floating number
+ * @pf: The state of printf
+ *
+ * Return: The value.
+ */
+static double printf_double(printf_t *pf)
+{
+	const char *arg = printf_next(pf);
+	char *end;
+	double d;
+
+	if (*arg == '\'' || *arg == '"')
+		return ((unsigned char)arg[1]);
+	errno = 0;
+	d = strtod(arg, &end);
+	printf_check(pf, arg, end);
+	return (d);
+}
+
+/**
+ * printf_conv - Convert the next argument of printf
+ * @pf: The state of printf, with the width and precision of the conversion
+ * @flags: The flags of the conversion, each one at most once
+ * @conv: The conversion character, one of "diouxXcsbeEfFgGaA"
+ *
+ * Description: The conversion is handed to the printf of the C library,
+ * with the width and precision passed as '*' arguments, so the format it
+ * is given always has the same short size. A negative precision counts as
+ * none. A %b is a %s of the argument with its escape sequences decoded.
+ *
+ * Return: None.
+ */
+void printf_conv(printf_t *pf, const char *flags, char conv)
+{
+	char spec[16], *s;
+	size_t len;
+
+	sprintf(spec, "%%%s*%s%s%c", flags, conv == 'c' ? "" : ".*",
+		_strchr("diouxX", conv) != NULL ? "l" : "",
+		conv == 'b' ? 's' : conv);
+	if (conv == 'd' || conv == 'i')
+		printf(spec, pf->width, pf->prec, printf_long(pf, 1));
+	else if (_strchr("ouxX", conv) != NULL)
+		printf(spec, pf->width, pf->prec,
+		       (unsigned long)printf_long(pf, 0));
+	else if (conv == 'c')
+		printf(spec, pf->width, (unsigned char)*printf_next(pf));
+	else if (conv == 's')
+		printf(spec, pf->width, pf->prec, printf_next(pf));
+	else if (conv == 'b')
+	{
+		s = esc_string(printf_next(pf), &len, &pf->stop);
+		if (pf->width == 0 && pf->prec < 0)
+			fwrite(s, 1, len, stdout);
+		else
+			printf(spec, pf->width, pf->prec, s);
+	}
+	else
+		printf(spec, pf->width, pf->prec, printf_double(pf));
+}
@@ -0,0 +1,143 @@
+#include "main.h"
+
+/**
+ * printf_number - Read the digits of a width or precision, or its '*'
+ * @pf: The state of printf, for the argument of a '*'
+ * @fmt: The format
+ * @i: Index in @fmt, moved after the number
+ *
+ * Return: The number.
+ */
+static int printf_number(printf_t *pf, const char *fmt, size_t *i)
+{
+	long n = 0;
+
+	if (fmt[*i] == '*')
+	{
+		(*i)++;
+		n = printf_long(pf, 1);
+		return (n > INT_MAX || n < INT_MIN ? 0 : (int)n);
+	}
+	for (; isdigit((unsigned char)fmt[*i]); (*i)++)
+		n = n < INT_MAX / 10 ? n * 10 + fmt[*i] - '0' : n;
+	return ((int)n);
+}
+
+/**
+ * printf_spec - Run a conversion of the format of printf
+ * @pf: The state of printf
+ * @fmt: The format, at the character after the '%'
+ *
+ * Return: The number of characters of @fmt the conversion uses, or -1 if
+ * it is not a valid one.
+ */
+static int printf_spec(printf_t *pf, const char *fmt)
+{
+	char flags[6];
+	size_t i, n = 0;
+
+	for (i = 0; fmt[i] != '\0' && _strchr("-+ #0", fmt[i]) != NULL; i++)
+	{
+		flags[n] = '\0';
+		if (_strchr(flags, fmt[i]) == NULL)
+			flags[n++] = fmt[i];
+	}
+	flags[n] = '\0';
+	pf->width = printf_number(pf, fmt, &i);
+	pf->prec = -1;
+	if (fmt[i] == '.')
+	{
+		i++;
+		pf->prec = printf_number(pf, fmt, &i);
+	}
+	if (fmt[i] == '\0' || _strchr("diouxXcsbeEfFgGaA", fmt[i]) == NULL)
+	{
+		fprintf(stderr, "%s: %d: printf: %%%.*s: invalid directive\n",
+			pf->program_name, pf->line,
+			(int)(i + (fmt[i] != '\0')), fmt);
+		return (-1);
+	}
+	printf_conv(pf, flags, fmt[i]);
+	return ((int)i + 1);
+}
+
+/**
+ * printf_format - Write the format of printf once
+ * @pf: The state of printf
+ * @fmt: The format
+ *
+ * Return: 0 on success, -1 if a conversion is not valid.
+ */
+static int printf_format(printf_t *pf, const char *fmt)
+{
+	int n, c;
+
+	while (*fmt != '\0' && !pf->stop)
+	{
+		if (*fmt == '\\')
+		{
+			fmt += esc_char(fmt + 1, &c, 0) + 1;
+			putchar(c);
+		}
+		else if (fmt[0] == '%' && fmt[1] == '%')
+		{
+			putchar('%');
+			fmt += 2;
+		}
+		else if (*fmt == '%')
+		{
+			n = printf_spec(pf, fmt + 1);
+			if (n == -1)
+				return (-1);
+			fmt += n + 1;
+		}
+		else
+			putchar(*fmt++);
+	}
+	return (0);
+}
+
+/**
+ * builtin_printf - Write arguments under the control of a format
+ * @tokens: The command, the format and the arguments
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The format is written again as long as its conversions
+ * take arguments and some are left, as POSIX requires. The text goes to
+ * the buffer of the standard output, like that of echo.
+ *
+ * Return: 0 on success, 1 if an argument was not a valid number, 2 on a
+ * usage error or an invalid conversion.
+ */
+int builtin_printf(char **tokens, int line_number, char *program_name)
+{
+	char **args = tokens + 1, **start;
+	printf_t pf;
+
+	if (*args != NULL && _strcmp(*args, "--") == 0)
+		args++;
+	else if (*args != NULL && (*args)[0] == '-' && (*args)[1] != '\0')
+	{
+		fprintf(stderr, "%s: %d: printf: Illegal option %.2s\n",
+			program_name, line_number, *args);
+		return (2);
+	}
+	if (*args == NULL)
+	{
+		fprintf(stderr, "%s: %d: printf: usage: %s\n", program_name,
+			line_number, "printf format [arg ...]");
+		return (2);
+	}
+	pf.argv = args + 1;
+	pf.status = 0;
+	pf.stop = 0;
+	pf.line = line_number;
+	pf.program_name = program_name;
+	do {
+		start = pf.argv;
+		if (printf_format(&pf, *args) == -1)
+			return (2);
+	} while (!pf.stop && *pf.argv != NULL && pf.argv != start);
+	return (pf.status);
+}
@@ -0,0 +1,116 @@
+#include "main.h"
+
+/**
+ * esc_char - Decode the escape sequence after a backslash
+ * @s: The characters after the backslash
+ * @c: Set to the character the sequence stands for, or to -1 for the
+ * '\c' that ends the output of echo
+ * @echo: Non-zero for the arguments of echo and of a %b conversion, where
+ * '\c' is known and '\0' takes up to three more octal digits
+ *
+ * Description: The sequences are those of /bin/sh: '\\', '\a', '\b', '\f',
+ * '\n', '\r', '\t', '\v' and up to three octal digits. Any other stands
+ * for the backslash itself, and the character after it is left alone.
+ *
+ * Return: The number of characters of @s the sequence uses.
+ */
+size_t esc_char(const char *s, int *c, int echo)
+{
+	static const char from[] = "\\abfnrtv", to[] = "\\\a\b\f\n\r\t\v";
+	const char *p = *s != '\0' ? _strchr(from, *s) : NULL;
+	size_t n = 0, max = 3;
+
+	if (echo && *s == 'c')
+	{
+		*c = -1;
+		return (1);
+	}
+	if (p != NULL)
+	{
+		*c = to[p - from];
+		return (1);
+	}
+	if (*s < '0' || *s > '7')
+	{
+		*c = '\\';
+		return (0);
+	}
+	if (echo && *s == '0')
+		n++;
+	for (*c = 0; max > 0 && s[n] >= '0' && s[n] <= '7'; max--)
+		*c = (*c * 8 + s[n++] - '0') & 0xff;
+	return (n);
+}
+
+/**
+ * esc_string - Decode the escape sequences of an argument of echo or %b
+ * @s: The argument
+ * @len: Set to the length of the result, which may hold NUL bytes
+ * @stop: Set to 1 if a '\c' ended the argument, left alone otherwise
+ *
+ * Return: The decoded argument, in the arena.
+ */
+char *esc_string(const char *s, size_t *len, int *stop)
+{
+	char *out = arena_alloc(strlen(s) + 1);
+	size_t n = 0;
+	int c;
+
+	while (*s != '\0')
+	{
+		if (*s != '\\')
+		{
+			out[n++] = *s++;
+			continue;
+		}
+		s += esc_char(s + 1, &c, 1) + 1;
+		if (c == -1)
+		{
+			*stop = 1;
+			break;
+		}
+		out[n++] = (char)c;
+	}
+	out[n] = '\0';
+	*len = n;
+	return (out);
+}
+
+/**
+ * builtin_echo - Write the arguments to the standard output
+ * @tokens: The command, an optional '-n' and the arguments
+ * @line_number: Line number of the command in the input (unused)
+ * @program_name: Name of the shell program (unused)
+ *
+ * Description: As in /bin/sh, only a first argument '-n' is an option,
+ * which leaves out the final newline, and escape sequences are always
+ * decoded, a '\c' ending the output. The text goes to the buffer of the
+ * standard output, which the shell flushes before any process or
+ * redirection would see it.
+ *
+ * Return: Always 0.
+ */
+int builtin_echo(char **tokens, int line_number, char *program_name)
+{
+	char **arg = tokens + 1, *s;
+	int newline = 1, stop = 0;
+	size_t len;
+
+	(void)line_number;
+	(void)program_name;
+	if (*arg != NULL && _strcmp(*arg, "-n") == 0)
+	{
+		newline = 0;
+		arg++;
+	}
+	for (; *arg != NULL && !stop; arg++)
+	{
+		s = esc_string(*arg, &len, &stop);
+		fwrite(s, 1, len, stdout);
+		if (arg[1] != NULL && !stop)
+			putchar(' ');
+	}
+	if (newline && !stop)
+		putchar('\n');
+	return (0);
+}
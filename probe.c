@@ -0,0 +1,138 @@
+#include "main.h"
+
+/* Number of consumers currently interested in probe measurements */
+int probes_active;
+/* Measurements of the command being timed by 'time', or NULL */
+cmd_timing_t *timing;
+/* Name of the command the probes are currently attributed to */
+const char *probe_name;
+/* Input line of the command being measured */
+int probe_line;
+/* Child being waited for, used as the thread of 'child' trace spans */
+pid_t probe_pid;
+
+static const char * const trace_names[PHASE_COUNT] = {
+	"parse", "dispatch", "lookup", "fork", "child"
+};
+
+/**
+ * probe_start - Take the start timestamp of a measured phase
+ *
+ * Description: The probes placed around tokenizing, dispatch, PATH lookup,
+ * fork and wait cost a single test of probes_active when nobody is
+ * measuring; the clock is only read when a consumer such as the 'time'
+ * builtin or the HSH_STATS histograms is active.
+ *
+ * Return: The current monotonic time in nanoseconds, or 0 when no probe
+ * consumer is active.
+ */
+uint64_t probe_start(void)
+{
+	if (!probes_active)
+		return (0);
+	return (now_ns());
+}
+
+/**
+ * probe_end - Record the end of a measured phase
+ * @phase: The phase that ended, one of enum phase_e
+ * @start: The value returned by probe_start when the phase began
+ *
+ * Description: The elapsed time is added to the timing of the 'time'
+ * builtin, if one is running, and to the histogram of the current
+ * probe_name when HSH_STATS is enabled. When tracing, the phase is also
+ * written as a span; the time spent waiting is shown on the track of the
+ * child that was waited for, as the child's runtime.
+ *
+ * Return: None.
+ */
+void probe_end(int phase, uint64_t start)
+{
+	uint64_t elapsed;
+
+	if (!probes_active || start == 0)
+		return;
+	elapsed = now_ns() - start;
+	if (timing != NULL)
+		timing->phase_ns[phase] += elapsed;
+	if (stats_enabled && probe_name != NULL)
+		stats_record(phase, probe_name, elapsed);
+	if (trace_enabled)
+		trace_span(trace_names[phase], start, start + elapsed,
+			   phase == PHASE_WAIT ? probe_pid : 0);
+}
+
+/**
+ * add_timeval - Add one struct timeval to another
+ * @sum: The timeval to add to
+ * @tv: The timeval to add
+ *
+ * Return: None.
+ */
+static void add_timeval(struct timeval *sum, const struct timeval *tv)
+{
+	sum->tv_sec += tv->tv_sec;
+	sum->tv_usec += tv->tv_usec;
+	if (sum->tv_usec >= 1000000)
+	{
+		sum->tv_sec++;
+		sum->tv_usec -= 1000000;
+	}
+}
+
+/**
+ * account_child - Add the resource usage of a reaped child to the timing
+ * @usage: The usage reported by wait4 for the child
+ *
+ * Description: Times, page faults and context switches are summed over all
+ * the children reaped while a command is being timed; the maximum resident
+ * set size is the largest of them.
+ *
+ * Return: None.
+ */
+void account_child(const struct rusage *usage)
+{
+	if (timing == NULL)
+		return;
+	add_timeval(&timing->usage.ru_utime, &usage->ru_utime);
+	add_timeval(&timing->usage.ru_stime, &usage->ru_stime);
+	if (usage->ru_maxrss > timing->usage.ru_maxrss)
+		timing->usage.ru_maxrss = usage->ru_maxrss;
+	timing->usage.ru_minflt += usage->ru_minflt;
+	timing->usage.ru_majflt += usage->ru_majflt;
+	timing->usage.ru_nvcsw += usage->ru_nvcsw;
+	timing->usage.ru_nivcsw += usage->ru_nivcsw;
+	timing->children++;
+}
+
+/**
+ * add_self_usage - Add the shell's own CPU time to a timing
+ * @t: The timing of the command
+ * @before: The shell's usage sampled before the command started
+ *
+ * Description: Builtins run inside the shell, so the user and system time
+ * the shell itself spent while the command ran is added to the time of the
+ * reaped children. If no child was reaped, the shell's own peak resident
+ * set size and fault counts are reported instead.
+ *
+ * Return: None.
+ */
+void add_self_usage(cmd_timing_t *t, const struct rusage *before)
+{
+	struct rusage after;
+	struct timeval delta;
+
+	getrusage(RUSAGE_SELF, &after);
+	timersub(&after.ru_utime, &before->ru_utime, &delta);
+	timeradd(&t->usage.ru_utime, &delta, &t->usage.ru_utime);
+	timersub(&after.ru_stime, &before->ru_stime, &delta);
+	timeradd(&t->usage.ru_stime, &delta, &t->usage.ru_stime);
+	if (t->children == 0)
+	{
+		t->usage.ru_maxrss = after.ru_maxrss;
+		t->usage.ru_minflt = after.ru_minflt - before->ru_minflt;
+		t->usage.ru_majflt = after.ru_majflt - before->ru_majflt;
+		t->usage.ru_nvcsw = after.ru_nvcsw - before->ru_nvcsw;
+		t->usage.ru_nivcsw = after.ru_nivcsw - before->ru_nivcsw;
+	}
+}
@@ -0,0 +1,151 @@
+#include "main.h"
+
+/**
+ * prog_word - Get a word of a compiled command
+ * @prog: The program
+ * @pc: Index of the OP_CMD instruction
+ * @i: Index of the word, 0 being the command name
+ *
+ * Return: The word, inside the string pool of the program.
+ */
+const char *prog_word(const program_t *prog, size_t pc, int i)
+{
+	return (prog->strings + prog->code[pc + 4 + i]);
+}
+
+/**
+ * op_length - Get the number of words of an instruction
+ * @code: The instruction
+ *
+ * Return: The length of the instruction with its operands, or 0 for an
+ * unknown opcode.
+ */
+size_t op_length(const uint32_t *code)
+{
+	switch (code[0])
+	{
+	case OP_END:
+	case OP_REDIR_END:
+	case OP_NOT:
+	case OP_TRUE:
+	case OP_FOR_NEXT:
+	case OP_NEXT:
+	case OP_POP:
+		return (1);
+	case OP_JMP_OK:
+	case OP_JMP_FAIL:
+	case OP_JMP:
+		return (2);
+	case OP_SYNTAX:
+	case OP_LOOP:
+	case OP_FUNC:
+	case OP_FOR_ARGS:
+		return (3);
+	case OP_CASE:
+		return (4);
+	case OP_REDIR:
+		return (4 + 2 * (size_t)code[3]);
+	case OP_CMD:
+		return (4 + (size_t)code[2] + 2 * (size_t)code[3]);
+	case OP_FOR:
+		return (4 + (size_t)code[3]);
+	case OP_CASE_TABLE:
+		return (3 + 2 * (size_t)code[1] + (size_t)code[2]);
+	}
+	return (0);
+}
+
+/**
+ * op_operand - Get the kind of an operand of an instruction
+ * @op: The instruction
+ * @i: Index of the operand, 1 being the first one
+ *
+ * Description: Code that has to look inside instructions without running
+ * them, such as prog_verify and prog_extract, uses this to know which
+ * operands are string pool offsets and which are addresses.
+ *
+ * Return: OPND_STRING, OPND_ADDRESS, or OPND_NUMBER for counts, line
+ * numbers and hash slots.
+ */
+int op_operand(const uint32_t *op, size_t i)
+{
+	switch (op[0])
+	{
+	case OP_CMD:
+		if (i < 4 + (size_t)op[2])
+			return (i >= 4 ? OPND_STRING : OPND_NUMBER);
+		return ((i - 4 - op[2]) % 2 ? OPND_STRING : OPND_NUMBER);
+	case OP_JMP:
+	case OP_JMP_OK:
+	case OP_JMP_FAIL:
+	case OP_LOOP:
+		return (OPND_ADDRESS);
+	case OP_SYNTAX:
+		return (i == 2 ? OPND_STRING : OPND_NUMBER);
+	case OP_FOR:
+		if (i == 1)
+			return (OPND_ADDRESS);
+		return (i == 3 ? OPND_NUMBER : OPND_STRING);
+	case OP_CASE:
+		if (i == 3)
+			return (OPND_ADDRESS);
+		return (i == 2 ? OPND_STRING : OPND_NUMBER);
+	case OP_CASE_TABLE:
+		if (i < 3 || i >= 3 + 2 * (size_t)op[1])
+			return (OPND_NUMBER);
+		return (i % 2 ? OPND_STRING : OPND_ADDRESS);
+	case OP_FUNC:
+		return (i == 1 ? OPND_STRING : OPND_ADDRESS);
+	case OP_FOR_ARGS:
+		return (i == 1 ? OPND_ADDRESS : OPND_STRING);
+	case OP_REDIR:
+		if (i < 4)
+			return (i == 2 ? OPND_ADDRESS : OPND_NUMBER);
+		return (i % 2 ? OPND_STRING : OPND_NUMBER);
+	}
+	return (OPND_NUMBER);
+}
+
+/**
+ * prog_first_name - Get the name of the first command of a program
+ * @prog: The program
+ *
+ * Description: The probes attribute the time spent compiling a line to the
+ * command it starts with.
+ *
+ * Return: The command name, or NULL if the program has no command.
+ */
+const char *prog_first_name(const program_t *prog)
+{
+	size_t pc;
+
+	for (pc = 0; prog->code[pc] != OP_END; pc += op_length(prog->code + pc))
+	{
+		if (prog->code[pc] == OP_CMD)
+			return (prog_word(prog, pc, 0));
+	}
+	return (NULL);
+}
+
+/**
+ * prog_free - Release a program
+ * @prog: The program; it is left empty and can be compiled into again
+ *
+ * Return: None.
+ */
+void prog_free(program_t *prog)
+{
+	size_t i;
+
+	for (i = 0; i < prog->nbinds; i++)
+		alias_release(prog->binds[i].alias);
+	free(prog->binds);
+	if (prog->map != NULL)
+		munmap(prog->map, prog->map_len);
+	else
+	{
+		free(prog->code);
+		free(prog->strings);
+	}
+	memset(prog, 0, sizeof(*prog));
+}
@@ -0,0 +1,89 @@
+#include "main.h"
+
+/**
+ * read_unescape - Remove the backslashes of a line read without '-r'
+ * @b: The line, whose @esc marks the characters that were quoted
+ *
+ * Return: None.
+ */
+void read_unescape(read_buf_t *b)
+{
+	size_t i, j = 0;
+
+	for (i = 0; i < b->len; i++, j++)
+	{
+		b->esc[j] = 0;
+		if (b->text[i] == '\\' && i + 1 < b->len)
+		{
+			i++;
+			b->esc[j] = 1;
+		}
+		b->text[j] = b->text[i];
+	}
+	b->len = j;
+}
+
+/**
+ * read_ifs - Classify a character of a line for field splitting
+ * @b: The line
+ * @i: Index of the character
+ * @ifs: The IFS characters
+ *
+ * Return: 1 for IFS white space, 2 for any other IFS character, 0 for a
+ * character that is not in IFS or that a backslash quoted.
+ */
+static int read_ifs(const read_buf_t *b, size_t i, const char *ifs)
+{
+	char c = b->text[i];
+
+	if (b->esc[i] || c == '\0' || _strchr(ifs, c) == NULL)
+		return (0);
+	return (c == ' ' || c == '\t' || c == '\n' ? 1 : 2);
+}
+
+/**
+ * read_assign - Split a line into variables
+ * @b: The line
+ * @names: The names of the variables, terminated by NULL
+ *
+ * Description: The line is split at IFS characters like the fields of
+ * an expansion, except that the last variable takes the rest of the
+ * line, without the IFS white space around it, as in /bin/sh. Variables
+ * left without a field are set to the empty string.
+ *
+ * Return: None.
+ */
+void read_assign(read_buf_t *b, char **names)
+{
+	const char *ifs = ifs_chars();
+	size_t i = 0, start, end;
+	char *value;
+
+	for (;; names++)
+	{
+		while (i < b->len && read_ifs(b, i, ifs) == 1)
+			i++;
+		start = i;
+		end = b->len;
+		if (names[1] == NULL)
+		{
+			while (end > i && read_ifs(b, end - 1, ifs) == 1)
+				end--;
+		}
+		else
+		{
+			while (i < b->len && read_ifs(b, i, ifs) == 0)
+				i++;
+			end = i;
+			while (i < b->len && read_ifs(b, i, ifs) == 1)
+				i++;
+			i += i < b->len && read_ifs(b, i, ifs) == 2;
+		}
+		value = arena_alloc(end - start + 1);
+		memcpy(value, b->text + start, end - start);
+		value[end - start] = '\0';
+		var_set(*names, value, 0);
+		if (names[1] == NULL)
+			return;
+	}
+}
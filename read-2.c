@@ -0,0 +1,116 @@
+#include "main.h"
+
+/**
+ * read_names - Check the variable names given to the read builtin
+ * @tokens: The command and its arguments
+ * @first: Index of the first name
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Return: @first, or -1 after reporting an error.
+ */
+static int read_names(char **tokens, int first, int line_number,
+		      char *program_name)
+{
+	int i;
+
+	if (tokens[first] == NULL)
+	{
+		fprintf(stderr, "%s: %d: read: arg count\n", program_name,
+			line_number);
+		return (-1);
+	}
+	for (i = first; tokens[i] != NULL; i++)
+	{
+		if (!valid_name(tokens[i], strlen(tokens[i])))
+		{
+			fprintf(stderr, "%s: %d: read: %s: bad variable name\n",
+				program_name, line_number, tokens[i]);
+			return (-1);
+		}
+	}
+	return (first);
+}
+
+/**
+ * read_options - Parse the options of the read builtin
+ * @tokens: The command and its arguments
+ * @raw: Set to 1 for '-r'
+ * @delim: Set to the character given with '-d', the first of its
+ * argument, or NUL for an empty one
+ * @line_number: Line number of the command, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: The names of the variables that follow the options are
+ * checked too, before anything is read.
+ *
+ * Return: The index of the first variable name, or -1 after reporting
+ * an error.
+ */
+static int read_options(char **tokens, int *raw, int *delim, int line_number,
+			char *program_name)
+{
+	int i;
+
+	for (i = 1; tokens[i] != NULL && tokens[i][0] == '-' &&
+	     tokens[i][1] != '\0'; i++)
+	{
+		if (_strcmp(tokens[i], "--") == 0)
+			return (i + 1);
+		if (_strcmp(tokens[i], "-r") == 0)
+			*raw = 1;
+		else if (tokens[i][1] == 'd' && tokens[i][2] != '\0')
+			*delim = (unsigned char)tokens[i][2];
+		else if (tokens[i][1] == 'd' && tokens[i][2] == '\0' &&
+			 tokens[i + 1] != NULL)
+			*delim = (unsigned char)tokens[++i][0];
+		else
+		{
+			fprintf(stderr, "%s: %d: read: Illegal option %.2s\n",
+				program_name, line_number, tokens[i]);
+			return (-1);
+		}
+	}
+	return (read_names(tokens, i, line_number, program_name));
+}
+
+/**
+ * builtin_read - Read a line from the standard input into variables
+ * @tokens: The command, the options '-r' and '-d delim', and the names
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: Without '-r', a backslash quotes the next character, and
+ * a backslash before the newline joins the next line to the line. Files
+ * may change while it waits for its input, so stat_epoch is moved on.
+ *
+ * Return: 0 if a whole line was read, 1 at the end of the input, 2 on
+ * error.
+ */
+int builtin_read(char **tokens, int line_number, char *program_name)
+{
+	static read_buf_t b;
+	int raw = 0, delim = '\n', first, r, n;
+
+	first = read_options(tokens, &raw, &delim, line_number,
+			     program_name);
+	if (first == -1)
+		return (2);
+	b.len = 0;
+	do {
+		r = read_record(STDIN_FILENO, delim, &b);
+		n = 0;
+		while (!raw && r == 1 && delim == '\n' && b.len > (size_t)n &&
+		       b.text[b.len - n - 1] == '\\')
+			n++;
+		if (n % 2 == 1)
+			b.len--;
+	} while (n % 2 == 1);
+	stat_epoch++;
+	read_grow(&b, 1);
+	memset(b.esc, 0, b.len);
+	if (!raw)
+		read_unescape(&b);
+	read_assign(&b, tokens + first);
+	return (r == 1 ? 0 : r == 0 ? 1 : 2);
+}
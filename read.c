@@ -0,0 +1,140 @@
+#include "main.h"
+
+/* What read_record knows of the first descriptors */
+static int read_modes[READ_FDS];
+
+/**
+ * read_grow - Make room in a line buffer
+ * @b: The buffer
+ * @n: The number of bytes to add after its contents
+ *
+ * Return: None.
+ */
+void read_grow(read_buf_t *b, size_t n)
+{
+	if (b->len + n <= b->cap)
+		return;
+	while (b->cap < b->len + n)
+		b->cap = b->cap ? b->cap * 2 : 256;
+	b->text = realloc(b->text, b->cap);
+	b->esc = realloc(b->esc, b->cap);
+	if (b->text == NULL || b->esc == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+}
+
+/**
+ * read_forget - Forget what read_record knows of a descriptor
+ * @fd: The descriptor, which a redirection is about to change
+ *
+ * Return: None.
+ */
+void read_forget(int fd)
+{
+	if (fd >= 0 && fd < READ_FDS)
+		read_modes[fd] = READ_UNKNOWN;
+}
+
+/**
+ * read_chunks - Read a line from a regular file
+ * @fd: The descriptor
+ * @delim: The character that ends the line
+ * @b: The buffer the line is added to
+ *
+ * Description: The file is read in chunks that start small and double,
+ * and what follows the delimiter is given back with lseek, as POSIX
+ * requires, so the commands that read the file next start right after
+ * the line. A line costs two system calls instead of one per byte.
+ *
+ * Return: 1 if the delimiter was found, 0 at the end of the file, -1 on
+ * error.
+ */
+static int read_chunks(int fd, int delim, read_buf_t *b)
+{
+	size_t chunk = READ_CHUNK;
+	ssize_t n;
+	char *end;
+
+	for (;;)
+	{
+		read_grow(b, chunk);
+		n = read(fd, b->text + b->len, chunk);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (n == 0 ? 0 : -1);
+		end = memchr(b->text + b->len, delim, (size_t)n);
+		if (end != NULL)
+		{
+			lseek(fd, -(off_t)(b->text + b->len + n - end - 1),
+			      SEEK_CUR);
+			b->len = (size_t)(end - b->text);
+			return (1);
+		}
+		b->len += (size_t)n;
+		chunk = chunk < READ_CHUNK_MAX ? chunk * 2 : chunk;
+	}
+}
+
+/**
+ * read_bytes - Read a line one byte at a time
+ * @fd: The descriptor
+ * @delim: The character that ends the line
+ * @b: The buffer the line is added to
+ *
+ * Description: Pipes, terminals and sockets cannot give back what was
+ * read past the line, so nothing is.
+ *
+ * Return: 1 if the delimiter was found, 0 at the end of the input, -1 on
+ * error.
+ */
+static int read_bytes(int fd, int delim, read_buf_t *b)
+{
+	ssize_t n;
+
+	for (;;)
+	{
+		read_grow(b, 1);
+		n = read(fd, b->text + b->len, 1);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (n == 0 ? 0 : -1);
+		if (b->text[b->len] == (char)delim)
+			return (1);
+		b->len++;
+	}
+}
+
+/**
+ * read_record - Read a line for the read builtin
+ * @fd: The descriptor to read
+ * @delim: The character that ends the line
+ * @b: The buffer the line is added to, without the delimiter
+ *
+ * Description: Regular files are read by chunks, anything else by bytes.
+ * The kind of the first descriptors is remembered until a redirection
+ * changes them, so reading a file line by line costs no fstat.
+ *
+ * Return: 1 if the delimiter was found, 0 at the end of the input, -1 on
+ * error.
+ */
+int read_record(int fd, int delim, read_buf_t *b)
+{
+	int mode = fd >= 0 && fd < READ_FDS ? read_modes[fd] : READ_UNKNOWN;
+	struct stat st;
+
+	if (mode == READ_UNKNOWN)
+	{
+		mode = READ_BYTES;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+			mode = READ_SEEK;
+		if (fd >= 0 && fd < READ_FDS)
+			read_modes[fd] = mode;
+	}
+	if (mode == READ_SEEK)
+		return (read_chunks(fd, delim, b));
+	return (read_bytes(fd, delim, b));
+}
@@ -0,0 +1,123 @@
+#include "main.h"
+
+/**
+ * redir_apply - Apply redirections in the shell itself
+ * @rl: The redirections
+ *
+ * Description: This is for builtins and functions, which run in the shell
+ * process. Each redirected descriptor is first copied above 9, so
+ * redir_restore can put it back once the command has run. Buffered output
+ * is flushed first, so it goes where it was written to, and the read
+ * builtin forgets what it knew of the descriptor.
+ *
+ * Return: 0 on success, -1 if a descriptor to copy is not open, in which
+ * case the redirections already applied are left for redir_restore.
+ */
+int redir_apply(redir_list_t *rl)
+{
+	redir_t *d;
+	size_t i;
+
+	fflush(stdout);
+	for (i = 0, d = rl->v; i < rl->n; i++, d++)
+	{
+		if (d->src == d->fd)
+			continue;
+		read_forget(d->fd);
+		d->saved = fcntl(d->fd, F_DUPFD_CLOEXEC, 10);
+		if (d->src == -1)
+			close(d->fd);
+		else if (dup2(d->src, d->fd) == -1)
+		{
+			fprintf(stderr, "%s: %d: %d: %s\n", rl->program_name,
+				rl->line, d->src, strerror(errno));
+			if (d->saved != -1)
+				close(d->saved);
+			d->saved = -2;
+			return (-1);
+		}
+	}
+	return (0);
+}
+
+/**
+ * redir_restore - Undo the redirections applied by redir_apply
+ * @rl: The redirections
+ *
+ * Description: The descriptors are put back in the reverse order, so one
+ * redirected twice ends up as it was before the first redirection.
+ *
+ * Return: None.
+ */
+void redir_restore(redir_list_t *rl)
+{
+	redir_t *d;
+	size_t i = rl->n;
+
+	fflush(stdout);
+	while (i-- > 0)
+	{
+		d = &rl->v[i];
+		if (d->saved == -2)
+			continue;
+		read_forget(d->fd);
+		if (d->saved == -1)
+			close(d->fd);
+		else
+		{
+			dup2(d->saved, d->fd);
+			close(d->saved);
+		}
+		d->saved = -2;
+	}
+}
+
+/**
+ * redir_child - Apply redirections in a child, before it executes a program
+ * @rl: The redirections
+ *
+ * Description: Nothing has to be saved in the child, so each redirection
+ * costs a single dup2 or close. The descriptors the shell opened are
+ * close-on-exec and disappear with the execve.
+ *
+ * Return: None; the child exits with status 2 if a descriptor to copy is
+ * not open.
+ */
+void redir_child(redir_list_t *rl)
+{
+	redir_t *d;
+	size_t i;
+
+	for (i = 0, d = rl->v; i < rl->n; i++, d++)
+	{
+		if (d->src == -1)
+			close(d->fd);
+		else if (d->src != d->fd && dup2(d->src, d->fd) == -1)
+		{
+			fprintf(stderr, "%s: %d: %d: %s\n", rl->program_name,
+				rl->line, d->src, strerror(errno));
+			_exit(2);
+		}
+	}
+}
+
+/**
+ * redir_release - Close the files opened for the redirections of a command
+ * @rl: The redirections
+ *
+ * Description: The descriptors of the cache of '>>' files stay open for
+ * the next command appending to the same file.
+ *
+ * Return: None.
+ */
+void redir_release(redir_list_t *rl)
+{
+	size_t i;
+
+	for (i = 0; i < rl->n; i++)
+	{
+		if (rl->v[i].opened && rl->v[i].src >= 0)
+			close(rl->v[i].src);
+	}
+	rl->n = 0;
+}
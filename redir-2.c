@@ -0,0 +1,85 @@
+#include "main.h"
+
+/* The descriptors of the files '>>' appended to, by hash of their path */
+static append_fd_t append_cache[APPEND_CACHE];
+
+/**
+ * redir_error - Report a file that could not be opened for a redirection
+ * @rl: The redirections, for the line number and the program name
+ * @kind: The kind of the redirection
+ * @path: The file
+ *
+ * Description: The messages are those of /bin/sh, which names a missing
+ * directory rather than a missing file when the file would be created.
+ *
+ * Return: None.
+ */
+void redir_error(const redir_list_t *rl, int kind, const char *path)
+{
+	const char *msg = strerror(errno);
+
+	if ((errno == ENOENT || errno == ENOTDIR) && kind == REDIR_IN)
+		msg = "No such file";
+	else if (errno == ENOENT || errno == ENOTDIR)
+		msg = "Directory nonexistent";
+	fprintf(stderr, "%s: %d: cannot %s %s: %s\n", rl->program_name,
+		rl->line, kind == REDIR_IN ? "open" : "create", path, msg);
+}
+
+/**
+ * append_open - Get a descriptor appending to a file
+ * @path: The file
+ * @cached: Set to 1 if the descriptor belongs to the cache and must not be
+ * closed, 0 if the caller owns it
+ *
+ * Description: Scripts often append line after line to the same log, so
+ * the descriptors of regular files opened for '>>' are kept open, in a
+ * small table indexed by the hash of the path where a new file replaces
+ * the one in its entry. A stat of the path checks that it still names the
+ * same file, which is one system call instead of an open and a close; a
+ * file that was removed, renamed or replaced is opened again, and so is
+ * one whose mode, owner or group changed, so that open checks the new
+ * permissions as it would for /bin/sh. Since the
+ * descriptor has O_APPEND, every write still goes to the current end of
+ * the file, whoever else writes to it.
+ *
+ * Return: The descriptor, or -1 on error.
+ */
+int append_open(const char *path, int *cached)
+{
+	append_fd_t *e = &append_cache[hash_string(path) & (APPEND_CACHE - 1)];
+	struct stat st;
+	int fd;
+
+	if (e->path != NULL && _strcmp(e->path, path) == 0 &&
+	    stat(path, &st) == 0 && st.st_dev == e->dev &&
+	    st.st_ino == e->ino && st.st_mode == e->mode &&
+	    st.st_uid == e->uid && st.st_gid == e->gid)
+	{
+		*cached = 1;
+		return (e->fd);
+	}
+	*cached = 0;
+	fd = open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666);
+	if (fd == -1 || fstat(fd, &st) == -1 || !S_ISREG(st.st_mode))
+		return (fd);
+	if (e->path != NULL)
+	{
+		close(e->fd);
+		free(e->path);
+	}
+	e->path = _strdup(path);
+	if (e->path == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	e->fd = fd;
+	e->dev = st.st_dev;
+	e->ino = st.st_ino;
+	e->mode = st.st_mode;
+	e->uid = st.st_uid;
+	e->gid = st.st_gid;
+	*cached = 1;
+	return (fd);
+}
@@ -0,0 +1,183 @@
+#include "main.h"
+
+/* The redirections of the command being dispatched, for spawn_command */
+redir_list_t *redir_pending;
+
+/**
+ * redir_open - Open the file of a redirection
+ * @kind: REDIR_IN, REDIR_OUT, REDIR_APPEND or REDIR_RDWR
+ * @path: The file
+ * @cached: Set to 1 if the descriptor belongs to the cache of '>>' files
+ * and must not be closed, 0 otherwise
+ *
+ * Description: Every descriptor is opened close-on-exec: only the copy
+ * made onto the redirected descriptor reaches the command.
+ *
+ * Return: The descriptor, or -1 on error.
+ */
+static int redir_open(int kind, const char *path, int *cached)
+{
+	static const int flags[] = {O_RDONLY, O_WRONLY | O_CREAT | O_TRUNC, 0,
+		O_RDWR | O_CREAT};
+
+	*cached = 0;
+	if (kind == REDIR_APPEND)
+		return (append_open(path, cached));
+	if (kind < 0 || kind > REDIR_RDWR)
+	{
+		errno = EINVAL;
+		return (-1);
+	}
+	return (open(path, flags[kind] | O_CLOEXEC, 0666));
+}
+
+/**
+ * redir_dup - Read the word of a '<&' or '>&' redirection
+ * @rl: The redirections, for error messages
+ * @d: The redirection, whose @src is set
+ * @word: The expanded word: a descriptor number, or '-' to close
+ *
+ * Description: A word that is neither is a syntax error, like in /bin/sh,
+ * which makes a shell that is not interactive exit.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int redir_dup(const redir_list_t *rl, redir_t *d, const char *word)
+{
+	size_t len = strlen(word);
+
+	if (len == 1 && *word == '-')
+	{
+		d->src = -1;
+		return (0);
+	}
+	if (len > 0 && len <= 5 && strspn(word, "0123456789") == len)
+	{
+		d->src = _atoi((char *)word, (int)len);
+		return (0);
+	}
+	fprintf(stderr, "%s: %d: Syntax error: Bad fd number\n",
+		rl->program_name, rl->line);
+	if (!interactive)
+		exit_requested = 1;
+	return (-1);
+}
+
+/**
+ * redir_file - Get the descriptor a redirection makes a copy of
+ * @rl: The redirections, for error messages
+ * @d: The redirection, whose @src and @opened are set
+ * @kind: The kind of the redirection
+ * @word: The expanded word: a file, a descriptor, the body of a
+ * here-document or a here-string, which is given a newline
+ * @literal: Non-zero if the word had nothing to expand
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int redir_file(const redir_list_t *rl, redir_t *d, int kind,
+		      const char *word, int literal)
+{
+	int cached = 0;
+	char *text;
+
+	if (kind == REDIR_DUP)
+		return (redir_dup(rl, d, word));
+	if (kind == REDIR_HERESTRING)
+	{
+		text = arena_alloc(strlen(word) + 2);
+		strcpy(text, word);
+		strcat(text, "\n");
+		word = text;
+		kind = REDIR_HEREDOC;
+	}
+	if (kind == REDIR_HEREDOC)
+		d->src = heredoc_open(word, literal, &cached);
+	else
+		d->src = redir_open(kind, word, &cached);
+	if (d->src == -1 && kind == REDIR_HEREDOC)
+		fprintf(stderr, "%s: %d: cannot create here-document: %s\n",
+			rl->program_name, rl->line, strerror(errno));
+	else if (d->src == -1)
+		redir_error(rl, kind, word);
+	d->opened = !cached;
+	return (d->src == -1 ? -1 : 0);
+}
+
+/**
+ * redir_above - Move the file of a redirection above the descriptors redirected
+ * @d: The redirection
+ * @top: The highest descriptor the command redirects
+ *
+ * Description: A descriptor opened at or below @top could be overwritten
+ * by an earlier redirection of the list before it is used.
+ *
+ * Return: None.
+ */
+static void redir_above(redir_t *d, int top)
+{
+	int fd;
+
+	if (d->src == -1 || d->src > top)
+		return;
+	fd = fcntl(d->src, F_DUPFD_CLOEXEC, top + 1);
+	if (d->opened)
+		close(d->src);
+	d->src = fd;
+	d->opened = 1;
+}
+
+/**
+ * redir_prepare - Expand and open the redirections of a command
+ * @prog: The program
+ * @pc: Index of the OP_CMD or OP_REDIR instruction
+ * @rl: The list to fill in, in the arena
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: Files are opened by the shell, before any fork, so errors
+ * are reported the same way for every command and '>>' and here-documents
+ * can use their caches of descriptors. A descriptor opened at or below the
+ * highest number the command redirects is moved above it, so applying the
+ * list in order never overwrites a file it has yet to use. Opening may
+ * create or truncate files, so stat_epoch is moved on for test.
+ *
+ * Return: 0 on success, -1 on error, after which nothing is left open.
+ */
+int redir_prepare(const program_t *prog, size_t pc, redir_list_t *rl,
+		  char *program_name)
+{
+	const uint32_t *op = prog->code + pc;
+	const uint32_t *r = op + 4 + (op[0] == OP_CMD ? op[2] : 0);
+	const char *word;
+	int top = 0, literal, kind;
+	size_t i;
+
+	stat_epoch++;
+	rl->n = op[3];
+	rl->line = (int)op[1];
+	rl->program_name = program_name;
+	rl->v = arena_alloc(rl->n * sizeof(*rl->v));
+	for (i = 0; i < rl->n; i++)
+		top = (int)(r[2 * i] >> 8) > top ? (int)(r[2 * i] >> 8) : top;
+	for (i = 0; i < rl->n; i++)
+	{
+		rl->v[i].fd = (int)(r[2 * i] >> 8);
+		rl->v[i].opened = 0;
+		rl->v[i].saved = -2;
+		word = prog->strings + r[2 * i + 1];
+		literal = !(word[-1] & (WORD_DOLLAR | WORD_TILDE));
+		if (!literal)
+			word = expand_string(word, EXP_STRING, rl->line,
+					     program_name);
+		kind = (int)(r[2 * i] & 0xff);
+		if (word == NULL ||
+		    redir_file(rl, &rl->v[i], kind, word, literal) == -1)
+			break;
+		if (kind != REDIR_DUP)
+			redir_above(&rl->v[i], top);
+	}
+	if (i == rl->n)
+		return (0);
+	rl->n = i;
+	redir_release(rl);
+	return (-1);
+}
@@ -0,0 +1,108 @@
+#!/bin/bash
+
+################################################################################
+# Description for the intranet check (one line, support Markdown syntax)
+# Redirections to files and descriptors, for external commands, builtins and functions
+
+################################################################################
+# The variable 'compare_with_sh' IS OPTIONNAL
+#
+# Uncomment the following line if you don't want the output of the shell
+# to be compared against the output of /bin/sh
+#
+# It can be useful when you want to check a builtin command that sh doesn't
+# implement
+# compare_with_sh=0
+
+################################################################################
+# The variable 'shell_input' HAS TO BE DEFINED
+#
+# The content of this variable will be piped to the student's shell and to sh
+# as follows: "echo $shell_input | ./hsh"
+#
+# It can be empty and multiline
+shell_input="/bin/echo one > /tmp/.hsh_redir
+/bin/echo two >> /tmp/.hsh_redir
+/bin/cat < /tmp/.hsh_redir
+/bin/ls /nonexistent 2>&1
+nosuch 2>/dev/null
+/bin/echo \\\\\$?
+/bin/cat < /nonexistent
+/bin/echo hi >&5
+/bin/echo \\\\\$?
+f() { /bin/echo out; /bin/echo err >&2; }
+f >> /tmp/.hsh_redir 2>&1
+x=\\\\\$(/bin/ls /nonexistent 2>&1)
+/bin/echo \\\\\"[\\\\\$x]\\\\\"
+while read l; do /bin/echo \\\\\"[\\\\\$l]\\\\\"; done < /tmp/.hsh_redir
+for i in 1 2; do /bin/echo \\\\\$i; done > /tmp/.hsh_redir2
+if true; then /bin/echo err >&2; fi 2>/dev/null
+{ /bin/echo x; /bin/cat /tmp/.hsh_redir2; } >> /tmp/.hsh_redir
+while true; do { /bin/echo brk; break; } > /tmp/.hsh_redir2; done
+/bin/cat /tmp/.hsh_redir2
+while read l; do :; done < /nonexistent
+/bin/echo \\\\\$?
+/bin/cat /tmp/.hsh_redir
+/bin/rm /tmp/.hsh_redir /tmp/.hsh_redir2"
+
+################################################################################
+# The variable 'shell_params' IS OPTIONNAL
+#
+# The content of this variable will be passed to as the paramaters array to the
+# shell as follows: "./hsh $shell_params"
+#
+# It can be empty
+# shell_params=""
+
+################################################################################
+# The function 'check_setup' will be called BEFORE the execution of the shell
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function check_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function 'sh_setup' will be called AFTER the execution of the students
+# shell, and BEFORE the execution of the real shell (sh)
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function sh_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function `check_callback` will be called AFTER the execution of the shell
+# It allows you to clear VARIABLES, cleanup files, ...
+#
+# It is also possible to perform additionnal checks.
+# Here is a list of available variables:
+# STATUS -> Path to the file containing the exit status of the shell
+# OUTPUTFILE -> Path to the file containing the stdout of the shell
+# ERROR_OUTPUTFILE -> Path to the file containing the stderr of the shell
+# EXPECTED_STATUS -> Path to the file containing the exit status of sh
+# EXPECTED_OUTPUTFILE -> Path to the file containing the stdout of sh
+# EXPECTED_ERROR_OUTPUTFILE -> Path to the file continaing the stderr of sh
+#
+# Parameters:
+#     $1 -> Status of the comparison with sh
+#             0 -> The output is the same as sh
+#             1 -> The output differs from sh
+#
+# Return value:
+#     0  -> Check succeed
+#     1  -> Check fails
+function check_callback()
+{
+	status=$1
+
+	return $status
+}
@@ -0,0 +1,159 @@
+#include "main.h"
+
+/* Settings applied to every spawned command, see spawn_command */
+spawn_attr_t spawn_attr = {{{0}}, 0, 0, 0, -1, 0};
+
+/**
+ * policy_from_name - Convert a 'sched' option to a scheduling policy
+ * @option: The option, such as "--batch"
+ *
+ * Return: The policy, or -1 if the option does not name one.
+ */
+static int policy_from_name(const char *option)
+{
+	if (_strcmp(option, "--other") == 0)
+		return (SCHED_OTHER);
+	if (_strcmp(option, "--batch") == 0)
+		return (SCHED_BATCH);
+	if (_strcmp(option, "--idle") == 0)
+		return (SCHED_IDLE);
+	if (_strcmp(option, "--fifo") == 0)
+		return (SCHED_FIFO);
+	if (_strcmp(option, "--rr") == 0)
+		return (SCHED_RR);
+	return (-1);
+}
+
+/**
+ * parse_number - Parse an optionally negative decimal number
+ * @str: The string to parse, may be NULL
+ * @value: Where to store the number
+ *
+ * Return: 0 on success, -1 if `str` is not a number.
+ */
+static int parse_number(const char *str, int *value)
+{
+	int sign = 1, digits = 0;
+
+	if (str == NULL)
+		return (-1);
+	if (*str == '-' || *str == '+')
+		sign = (*str++ == '-') ? -1 : 1;
+	for (*value = 0; *str >= '0' && *str <= '9' && digits < 9; str++)
+	{
+		*value = *value * 10 + (*str - '0');
+		digits++;
+	}
+	*value *= sign;
+	return (digits > 0 && *str == '\0' ? 0 : -1);
+}
+
+/**
+ * parse_sched_args - Parse the options of the 'sched' builtin
+ * @tokens: The tokens of the sched command
+ * @attr: The settings to update
+ *
+ * Description: '--nice N' adds N to the niceness of the command. A policy
+ * option selects the scheduling policy; '--fifo' and '--rr' take the static
+ * priority as their argument. Options end at the first token that does not
+ * start with "--", or after a "--" token.
+ *
+ * Return: The index of the command in `tokens`, or -1 on a usage error.
+ */
+static int parse_sched_args(char **tokens, spawn_attr_t *attr)
+{
+	int i = 1, policy;
+
+	for (; tokens[i] != NULL && _strncmp(tokens[i], "--", 2) == 0; i++)
+	{
+		if (tokens[i][2] == '\0')
+			return (i + 1);
+		if (_strcmp(tokens[i], "--nice") == 0)
+		{
+			if (parse_number(tokens[++i], &attr->nice) != 0)
+				return (-1);
+			attr->has_nice = 1;
+			continue;
+		}
+		policy = policy_from_name(tokens[i]);
+		if (policy == -1)
+			return (-1);
+		attr->policy = policy;
+		attr->priority = 0;
+		if ((policy == SCHED_FIFO || policy == SCHED_RR) &&
+		    parse_number(tokens[++i], &attr->priority) != 0)
+			return (-1);
+	}
+	return (i);
+}
+
+/**
+ * builtin_sched - Run a command with a different niceness or policy
+ * @tokens: The command, 'sched [--nice N] [--batch|--idle|--other|
+ * --fifo PRIO|--rr PRIO] cmd...'
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: Like 'pin', this builtin only records the settings in
+ * spawn_attr for the duration of the command; they are applied in the child
+ * by apply_spawn_attr, so no nice or chrt process is involved.
+ *
+ * Return: The exit status of the command, or 2 on a usage error.
+ */
+int builtin_sched(char **tokens, int line_number, char *program_name)
+{
+	spawn_attr_t saved = spawn_attr;
+	int status, cmd;
+
+	cmd = parse_sched_args(tokens, &spawn_attr);
+	if (cmd == -1 || tokens[cmd] == NULL)
+	{
+		fprintf(stderr, "%s: %d: sched: usage: sched [--nice N] %s%s\n",
+			program_name, line_number,
+			"[--batch|--idle|--other|--fifo PRIO|--rr PRIO] ",
+			"command");
+		spawn_attr = saved;
+		return (2);
+	}
+	status = dispatch_command(tokens + cmd, line_number, program_name);
+	spawn_attr = saved;
+	return (status);
+}
+
+/**
+ * apply_spawn_attr - Apply scheduling settings to the calling process
+ * @attr: The settings to apply
+ *
+ * Description: This function is called in the child created by
+ * spawn_command, between fork and execve. A setting that cannot be applied
+ * makes the child exit with an error rather than run the command with the
+ * wrong placement.
+ *
+ * Return: None.
+ */
+void apply_spawn_attr(const spawn_attr_t *attr)
+{
+	struct sched_param param;
+
+	if (attr->has_cpus &&
+	    sched_setaffinity(0, sizeof(attr->cpus), &attr->cpus) != 0)
+	{
+		perror("sched_setaffinity");
+		_exit(EXIT_FAILURE);
+	}
+	if (attr->policy != -1)
+	{
+		param.sched_priority = attr->priority;
+		if (sched_setscheduler(0, attr->policy, &param) != 0)
+		{
+			perror("sched_setscheduler");
+			_exit(EXIT_FAILURE);
+		}
+	}
+	errno = 0;
+	if (attr->has_nice && nice(attr->nice) == -1 && errno != 0)
+	{
+		perror("nice");
+		_exit(EXIT_FAILURE);
+	}
+}
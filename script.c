@@ -0,0 +1,156 @@
+#include "main.h"
+
+/**
+ * read_script - Read the whole contents of an open script
+ * @fd: The script, open for reading
+ * @size: The size of the script
+ *
+ * Return: A buffer holding the script followed by a NUL byte, or NULL if it
+ * could not be read.
+ */
+static char *read_script(int fd, size_t size)
+{
+	char *buf = malloc(size + 1);
+	size_t done = 0;
+	ssize_t ret;
+
+	if (buf == NULL)
+		return (NULL);
+	while (done < size)
+	{
+		ret = read(fd, buf + done, size - done);
+		if (ret == -1 && errno == EINTR)
+			continue;
+		if (ret <= 0)
+			break;
+		done += (size_t)ret;
+	}
+	if (done != size)
+	{
+		free(buf);
+		return (NULL);
+	}
+	buf[size] = '\0';
+	return (buf);
+}
+
+/**
+ * load_script - Get the compiled program of a script
+ * @path: The script, as given on the command line
+ * @prog: An empty program to load or compile into
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: Unless HSH_CACHE is set to 0, the compiled form is first
+ * looked up in the cache with cache_load, so a script that has not changed
+ * since its last run is not read nor parsed at all. Otherwise the script is
+ * read, compiled and stored in the cache for the next run.
+ *
+ * Return: 0 on success, -1 if the script could not be opened or read.
+ */
+int load_script(const char *path, program_t *prog, char *program_name)
+{
+	char *abs = NULL, *buf, *cache = _getenv("HSH_CACHE");
+	int use_cache = cache == NULL || _strcmp(cache, "0") != 0;
+	struct stat st;
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+	if (fd == -1 || fstat(fd, &st) == -1)
+	{
+		fprintf(stderr, "%s: 0: cannot open %s: %s\n", program_name,
+			path, errno == ENOENT ? "No such file" :
+			strerror(errno));
+		if (fd != -1)
+			close(fd);
+		return (-1);
+	}
+	if (use_cache)
+		abs = realpath(path, NULL);
+	if (abs != NULL && cache_load(abs, &st, prog) == 0)
+	{
+		free(abs);
+		close(fd);
+		return (0);
+	}
+	buf = read_script(fd, (size_t)st.st_size);
+	close(fd);
+	if (buf == NULL)
+	{
+		fprintf(stderr, "%s: 0: cannot read %s\n", program_name, path);
+		free(abs);
+		return (-1);
+	}
+	compile_script(prog, buf, (size_t)st.st_size);
+	free(buf);
+	if (abs != NULL && S_ISREG(st.st_mode))
+		cache_store(abs, &st, prog);
+	free(abs);
+	return (0);
+}
+
+/**
+ * script_mode - Execute the commands of a script file
+ * @path: The script
+ * @program_name: Name of the shell program
+ *
+ * Description: Like /bin/sh, the shell reports errors inside the script
+ * under the name of the script, so @path is also used as the program name.
+ * Compiling or loading the script is measured as its tokenize phase.
+ *
+ * Return: The status of the last command, or 2 if the script could not be
+ * opened.
+ */
+int script_mode(char *path, char *program_name)
+{
+	program_t prog;
+	uint64_t start = probe_start();
+
+	memset(&prog, 0, sizeof(prog));
+	if (load_script(path, &prog, program_name) == -1)
+		return (2);
+	probe_name = path;
+	probe_end(PHASE_TOKENIZE, start);
+	probe_name = NULL;
+	run_program(&prog, path);
+	prog_free(&prog);
+	return (last_status);
+}
+
+/**
+ * shell_options - Read the options of the shell
+ * @argc: The number of arguments of the shell
+ * @argv: The arguments
+ *
+ * Description: '--trace=FILE' writes trace events to FILE and '-n' only
+ * checks the syntax of the commands. The options end at the first
+ * argument that is not one, or at a lone '-'.
+ *
+ * Return: The index of the first argument after the options, or -1 after
+ * reporting an error.
+ */
+int shell_options(int argc, char **argv)
+{
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (_strncmp(argv[i], "--trace=", 8) == 0)
+		{
+			if (trace_open(argv[i] + 8) == -1)
+			{
+				perror(argv[i] + 8);
+				return (-1);
+			}
+		}
+		else if (_strcmp(argv[i], "-n") == 0)
+			noexec = 1;
+		else if (argv[i][0] == '-' && argv[i][1] != '\0')
+		{
+			fprintf(stderr, "%s: 0: Illegal option %s\n", argv[0],
+				argv[i]);
+			return (-1);
+		}
+		else
+			break;
+	}
+	return (i);
+}
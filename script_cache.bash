@@ -0,0 +1,119 @@
+#!/bin/bash
+
+################################################################################
+# Description for the intranet check (one line, support Markdown syntax)
+# Run a script file twice and check that the second run, from the compiled-script cache, behaves the same
+
+################################################################################
+# The variable 'compare_with_sh' IS OPTIONNAL
+#
+# Uncomment the following line if you don't want the output of the shell
+# to be compared against the output of /bin/sh
+#
+# It can be useful when you want to check a builtin command that sh doesn't
+# implement
+# compare_with_sh=0
+
+################################################################################
+# The variable 'shell_input' HAS TO BE DEFINED
+#
+# The content of this variable will be piped to the student's shell and to sh
+# as follows: "echo $shell_input | ./hsh"
+#
+# It can be empty and multiline
+shell_input=""
+
+################################################################################
+# The variable 'shell_params' IS OPTIONNAL
+#
+# The content of this variable will be passed to as the paramaters array to the
+# shell as follows: "./hsh $shell_params"
+#
+# It can be empty
+shell_params="$TMP_DIR/hsh_script.sh"
+
+################################################################################
+# The function 'check_setup' will be called BEFORE the execution of the shell
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function check_setup()
+{
+	export XDG_CACHE_HOME=$TMP_DIR/hsh_cache_test
+	$RM -rf $XDG_CACHE_HOME
+	$ECHO '/bin/echo one' > $TMP_DIR/hsh_script.sh
+	$ECHO '' >> $TMP_DIR/hsh_script.sh
+	$ECHO 'qwerty' >> $TMP_DIR/hsh_script.sh
+	$ECHO '/bin/echo two   three' >> $TMP_DIR/hsh_script.sh
+	# Scripts modified during the current second are not cached
+	$TOUCH -d '1 minute ago' $TMP_DIR/hsh_script.sh
+
+	return 0
+}
+
+################################################################################
+# The function 'sh_setup' will be called AFTER the execution of the students
+# shell, and BEFORE the execution of the real shell (sh)
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function sh_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function `check_callback` will be called AFTER the execution of the shell
+# It allows you to clear VARIABLES, cleanup files, ...
+#
+# It is also possible to perform additionnal checks.
+# Here is a list of available variables:
+# STATUS -> Path to the file containing the exit status of the shell
+# OUTPUTFILE -> Path to the file containing the stdout of the shell
+# ERROR_OUTPUTFILE -> Path to the file containing the stderr of the shell
+# EXPECTED_STATUS -> Path to the file containing the exit status of sh
+# EXPECTED_OUTPUTFILE -> Path to the file containing the stdout of sh
+# EXPECTED_ERROR_OUTPUTFILE -> Path to the file continaing the stderr of sh
+#
+# Parameters:
+#     $1 -> Status of the comparison with sh
+#             0 -> The output is the same as sh
+#             1 -> The output differs from sh
+#
+# Return value:
+#     0  -> Check succeed
+#     1  -> Check fails
+function check_callback()
+{
+	let status=$1
+
+	# The first run compiled the script and stored it in the cache, the
+	# second one runs the cached program and must behave the same
+	if ! $CAT $XDG_CACHE_HOME/hsh/*.hshc > /dev/null 2>&1
+	then
+		let status=1
+	fi
+	"$HSHELL" $TMP_DIR/hsh_script.sh > $OUTPUTFILE.cached 2> $ERROR_OUTPUTFILE.cached
+	if ! $DIFF -q $OUTPUTFILE $OUTPUTFILE.cached > /dev/null || ! $DIFF -q $ERROR_OUTPUTFILE $ERROR_OUTPUTFILE.cached > /dev/null
+	then
+		let status=1
+	fi
+	# A script that may still change within its modification time is not
+	# stored
+	$RM -rf $XDG_CACHE_HOME
+	$ECHO '/bin/echo new' > $TMP_DIR/hsh_script.sh
+	$TOUCH -d '1 minute' $TMP_DIR/hsh_script.sh
+	"$HSHELL" $TMP_DIR/hsh_script.sh > /dev/null 2>&1
+	if $CAT $XDG_CACHE_HOME/hsh/*.hshc > /dev/null 2>&1
+	then
+		let status=1
+	fi
+	$RM -rf $XDG_CACHE_HOME $TMP_DIR/hsh_script.sh $OUTPUTFILE.cached $ERROR_OUTPUTFILE.cached
+	unset XDG_CACHE_HOME
+
+	return $status
+}
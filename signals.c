@@ -0,0 +1,106 @@
+#include "main.h"
+
+/**
+ * struct signame_s - Associates a signal name with its number
+ * @name: The signal name without the "SIG" prefix
+ * @number: The signal number
+ */
+typedef struct signame_s
+{
+	const char *name;
+	int number;
+} signame_t;
+
+static const signame_t signames[] = {
+	{"HUP", SIGHUP}, {"INT", SIGINT}, {"QUIT", SIGQUIT}, {"ILL", SIGILL},
+	{"TRAP", SIGTRAP}, {"ABRT", SIGABRT}, {"BUS", SIGBUS}, {"FPE", SIGFPE},
+	{"KILL", SIGKILL}, {"USR1", SIGUSR1}, {"SEGV", SIGSEGV},
+	{"USR2", SIGUSR2}, {"PIPE", SIGPIPE}, {"ALRM", SIGALRM},
+	{"TERM", SIGTERM}, {"CHLD", SIGCHLD}, {"CONT", SIGCONT},
+	{"STOP", SIGSTOP}, {"TSTP", SIGTSTP}, {"TTIN", SIGTTIN},
+	{"TTOU", SIGTTOU}, {"URG", SIGURG}, {"XCPU", SIGXCPU},
+	{"XFSZ", SIGXFSZ}, {"VTALRM", SIGVTALRM}, {"PROF", SIGPROF},
+	{"WINCH", SIGWINCH}, {"IO", SIGIO}, {"PWR", SIGPWR}, {"SYS", SIGSYS},
+	{NULL, 0}
+};
+
+/**
+ * signal_rt - Convert the name of a real-time signal to its number
+ * @name: The name in upper case, without "SIG": "RTMIN", "RTMIN+n",
+ * "RTMAX" or "RTMAX-n"
+ *
+ * Return: The signal number, or -1 if @name is not a real-time signal.
+ */
+static int signal_rt(const char *name)
+{
+	int max = _strncmp(name, "RTMAX", 5) == 0, n = 0, i;
+
+	if (!max && _strncmp(name, "RTMIN", 5) != 0)
+		return (-1);
+	if (name[5] == '\0')
+		return (max ? SIGRTMAX : SIGRTMIN);
+	if (name[5] != (max ? '-' : '+') || name[6] == '\0')
+		return (-1);
+	for (i = 6; name[i] >= '0' && name[i] <= '9' && n < NSIG; i++)
+		n = n * 10 + (name[i] - '0');
+	if (name[i] != '\0' || n > SIGRTMAX - SIGRTMIN)
+		return (-1);
+	return (max ? SIGRTMAX - n : SIGRTMIN + n);
+}
+
+/**
+ * signal_from_name - Convert a signal name or number to a signal number
+ * @name: A name such as "TERM" or "SIGTERM", or a number such as "15"
+ *
+ * Description: Names are matched without regard to case and with or
+ * without the "SIG" prefix, so "term", "TERM" and "SIGTERM" are the same
+ * signal. A decimal number is accepted as is if it is a valid signal number,
+ * and 0 is accepted so that callers can probe for process existence.
+ * The real-time signals are named from either end of their range, as in
+ * "RTMIN+1" or "RTMAX-2".
+ *
+ * Return: The signal number, or -1 if `name` is not a known signal.
+ */
+int signal_from_name(const char *name)
+{
+	char upper[16];
+	int i, number = 0;
+
+	if (name[0] >= '0' && name[0] <= '9')
+	{
+		for (i = 0; name[i] >= '0' && name[i] <= '9' && number < NSIG;
+		     i++)
+			number = number * 10 + (name[i] - '0');
+		return (name[i] == '\0' && number < NSIG ? number : -1);
+	}
+	if (_strncmp(name, "SIG", 3) == 0 || _strncmp(name, "sig", 3) == 0)
+		name += 3;
+	for (i = 0; name[i] != '\0' && i < (int)sizeof(upper) - 1; i++)
+		upper[i] = toupper((unsigned char)name[i]);
+	upper[i] = '\0';
+	for (i = 0; signames[i].name != NULL; i++)
+	{
+		if (_strcmp(signames[i].name, upper) == 0)
+			return (signames[i].number);
+	}
+	return (signal_rt(upper));
+}
+
+/**
+ * signal_name - Get the name of a signal
+ * @sig: The signal number
+ *
+ * Return: The signal name without the "SIG" prefix, or NULL if the signal
+ * has no name in the table.
+ */
+const char *signal_name(int sig)
+{
+	int i;
+
+	for (i = 0; signames[i].name != NULL; i++)
+	{
+		if (signames[i].number == sig)
+			return (signames[i].name);
+	}
+	return (NULL);
+}
@@ -0,0 +1,43 @@
+#include "main.h"
+
+/**
+ * builtin_sleep - Wait for the sum of some durations
+ * @tokens: The command and the durations, numbers of seconds with an
+ * optional fractional part and an optional 's', 'm', 'h' or 'd' suffix
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The shell sleeps itself with clock_nanosleep, to the
+ * nanosecond, so a polling loop does not start a process each time
+ * around. The deadline is absolute on the monotonic clock, so a signal
+ * that interrupts the sleep does not make it drift. Anything else than
+ * durations, such as options, 'infinity' or a missing operand, is left to
+ * the sleep program, which is run instead and reports the errors. Files
+ * may change while the shell sleeps, so stat_epoch is moved on after.
+ *
+ * Return: 0.
+ */
+int builtin_sleep(char **tokens, int line_number, char *program_name)
+{
+	uint64_t total = 0, ns;
+	struct timespec deadline;
+	int i;
+
+	for (i = 1; tokens[i] != NULL; i++)
+	{
+		if (parse_duration(tokens[i], &ns) == -1)
+			return (execute_command(tokens, line_number,
+						program_name));
+		total = total > UINT64_MAX - ns ? UINT64_MAX : total + ns;
+	}
+	if (i == 1)
+		return (execute_command(tokens, line_number, program_name));
+	ns = now_ns();
+	total = total > UINT64_MAX - ns ? UINT64_MAX : ns + total;
+	ns_to_timespec(total, &deadline);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline,
+			       NULL) == EINTR)
+		;
+	stat_epoch++;
+	return (0);
+}
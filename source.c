@@ -0,0 +1,166 @@
+#include "main.h"
+
+/* The programs of the files '.' compiled, by inode */
+static source_t source_cache[SOURCE_CACHE];
+
+/**
+ * source_find - Find the file '.' runs
+ * @name: The operand of '.'
+ * @st: Set to the status of the file
+ *
+ * Description: A name without a slash is searched in the directories of
+ * PATH, where it must be a regular file, but need not be executable; an
+ * empty entry stands for the current directory. Like /bin/sh, the current
+ * directory is not searched otherwise.
+ *
+ * Return: The path of the file, allocated with malloc, or NULL with errno
+ * set if there is none.
+ */
+static char *source_find(const char *name, struct stat *st)
+{
+	const char *p = _strchr(name, '/') != NULL ? NULL : _getenv("PATH");
+	const char *colon;
+	size_t len, nlen = strlen(name);
+	char *path;
+
+	for (; p != NULL; p = *colon != '\0' ? colon + 1 : NULL)
+	{
+		colon = p + strcspn(p, ":");
+		len = (size_t)(colon - p);
+		path = malloc(len + nlen + 2);
+		if (path == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(path, p, len);
+		path[len] = '/';
+		memcpy(path + len + (len > 0), name, nlen + 1);
+		if (stat(path, st) == 0 && S_ISREG(st->st_mode))
+			return (path);
+		free(path);
+	}
+	if (_strchr(name, '/') == NULL || stat(name, st) == -1)
+		return (NULL);
+	path = _strdup(name);
+	if (path == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	return (path);
+}
+
+/**
+ * source_get - Get the compiled program of a sourced file
+ * @path: The file
+ * @st: Its status
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: The programs are cached by device, inode, modification time
+ * and size, so a library sourced again, from a loop or a function, costs
+ * a stat instead of a read and a parse. A file that is not cached yet is
+ * loaded with load_script, which shares the compiled-script cache on disk
+ * with the scripts the shell runs. Like the listings of pathname expansion,
+ * a file modified during the current second is not cached, since it may
+ * change again without its modification time showing it. The program is
+ * referenced like a function, so replacing it in the cache while it runs
+ * does not free it.
+ *
+ * Return: The program, to release with func_release, or NULL if the file
+ * could not be read.
+ */
+static function_t *source_get(const char *path, const struct stat *st,
+			      char *program_name)
+{
+	source_t *e = &source_cache[(st->st_ino ^ st->st_dev) &
+				    (SOURCE_CACHE - 1)];
+	function_t *fn;
+
+	if (e->fn != NULL && e->dev == st->st_dev && e->ino == st->st_ino &&
+	    e->size == st->st_size && e->mtime.tv_sec == st->st_mtim.tv_sec &&
+	    e->mtime.tv_nsec == st->st_mtim.tv_nsec)
+	{
+		e->fn->refs++;
+		return (e->fn);
+	}
+	fn = calloc(1, sizeof(*fn));
+	if (fn == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	if (load_script(path, &fn->prog, program_name) == -1)
+	{
+		free(fn);
+		return (NULL);
+	}
+	fn->refs = 1;
+	if (!S_ISREG(st->st_mode) || st->st_mtim.tv_sec >= time(NULL))
+		return (fn);
+	if (e->fn != NULL)
+		func_release(e->fn);
+	e->fn = fn;
+	e->dev = st->st_dev;
+	e->ino = st->st_ino;
+	e->mtime = st->st_mtim;
+	e->size = st->st_size;
+	fn->refs++;
+	return (fn);
+}
+
+/**
+ * builtin_source - Run the commands of a file in the current shell
+ * @tokens: The command, '.' or 'source', and the file; further arguments
+ * are ignored, as /bin/sh does
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: Errors in the file are reported under its path, as those of
+ * a script are. 'return' ends the file early, as it ends a function. A file
+ * that cannot be found or read makes a shell that is not interactive
+ * exit, and a directory is an empty file.
+ *
+ * Return: The status of the last command of the file, 0 if it ran none, or
+ * 2 on error.
+ */
+int builtin_source(char **tokens, int line_number, char *program_name)
+{
+	struct stat st;
+	function_t *fn = NULL;
+	char *path;
+	int status;
+
+	if (tokens[1] == NULL)
+		return (0);
+	path = source_find(tokens[1], &st);
+	if (path != NULL && S_ISDIR(st.st_mode))
+	{
+		free(path);
+		return (0);
+	}
+	if (path == NULL && _strchr(tokens[1], '/') == NULL)
+		fprintf(stderr, "%s: %d: %s: %s: not found\n", program_name,
+			line_number, tokens[0], tokens[1]);
+	else if (path == NULL)
+		fprintf(stderr, "%s: %d: %s: cannot open %s: %s\n",
+			program_name, line_number, tokens[0], tokens[1],
+			errno == ENOENT ? "No such file" : strerror(errno));
+	else
+		fn = source_get(path, &st, program_name);
+	if (fn == NULL && !interactive)
+		exit_requested = 1;
+	if (fn == NULL)
+	{
+		free(path);
+		return (2);
+	}
+	func_depth++;
+	status = run_program(&fn->prog, path);
+	func_depth--;
+	func_release(fn);
+	free(path);
+	if (loop_request == LOOP_RETURN)
+		loop_request = 0;
+	return (status);
+}
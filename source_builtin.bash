@@ -0,0 +1,105 @@
+#!/bin/bash
+
+################################################################################
+# Description for the intranet check (one line, support Markdown syntax)
+# . runs a file in the current shell, from a cache of compiled files
+
+################################################################################
+# The variable 'compare_with_sh' IS OPTIONNAL
+#
+# Uncomment the following line if you don't want the output of the shell
+# to be compared against the output of /bin/sh
+#
+# It can be useful when you want to check a builtin command that sh doesn't
+# implement
+# compare_with_sh=0
+
+################################################################################
+# The variable 'shell_input' HAS TO BE DEFINED
+#
+# The content of this variable will be piped to the student's shell and to sh
+# as follows: "echo $shell_input | ./hsh"
+#
+# It can be empty and multiline
+shell_input="echo 'count=\\\\\$((count + 1))' > /tmp/.hsh_lib.sh
+echo 'greet() { echo hello \\\\\$1 \\\\\$count; }' >> /tmp/.hsh_lib.sh
+echo 'return 4' >> /tmp/.hsh_lib.sh
+echo 'echo not reached' >> /tmp/.hsh_lib.sh
+count=0
+i=0
+while [ \\\\\$i -lt 3 ]; do . /tmp/.hsh_lib.sh; i=\\\\\$((i + 1)); done
+echo \\\\\$? \\\\\$count
+greet world
+x=\\\\\$(. /tmp/.hsh_lib.sh; greet sub)
+echo \\\\\$x \\\\\$count
+echo 'echo changed' > /tmp/.hsh_lib.sh
+. /tmp/.hsh_lib.sh
+greet again
+.; echo \\\\\$?
+PATH=/tmp:\\\\\$PATH
+. .hsh_lib.sh; echo \\\\\$?
+rm -f /tmp/.hsh_lib.sh
+. /tmp/.hsh_lib.sh
+echo not reached"
+
+################################################################################
+# The variable 'shell_params' IS OPTIONNAL
+#
+# The content of this variable will be passed to as the paramaters array to the
+# shell as follows: "./hsh $shell_params"
+#
+# It can be empty
+# shell_params=""
+
+################################################################################
+# The function 'check_setup' will be called BEFORE the execution of the shell
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function check_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function 'sh_setup' will be called AFTER the execution of the students
+# shell, and BEFORE the execution of the real shell (sh)
+# It allows you to set custom VARIABLES, prepare files, etc
+# If you want to set variables for the shell to use, be sure to export them,
+# since the shell will be launched in a subprocess
+#
+# Return value: Discarded
+function sh_setup()
+{
+	return 0
+}
+
+################################################################################
+# The function `check_callback` will be called AFTER the execution of the shell
+# It allows you to clear VARIABLES, cleanup files, ...
+#
+# It is also possible to perform additionnal checks.
+# Here is a list of available variables:
+# STATUS -> Path to the file containing the exit status of the shell
+# OUTPUTFILE -> Path to the file containing the stdout of the shell
+# ERROR_OUTPUTFILE -> Path to the file containing the stderr of the shell
+# EXPECTED_STATUS -> Path to the file containing the exit status of sh
+# EXPECTED_OUTPUTFILE -> Path to the file containing the stdout of sh
+# EXPECTED_ERROR_OUTPUTFILE -> Path to the file continaing the stderr of sh
+#
+# Parameters:
+#     $1 -> Status of the comparison with sh
+#             0 -> The output is the same as sh
+#             1 -> The output differs from sh
+#
+# Return value:
+#     0  -> Check succeed
+#     1  -> Check fails
+function check_callback()
+{
+	status=$1
+
+	return $status
+}
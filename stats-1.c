@@ -0,0 +1,169 @@
+#include "main.h"
+
+static const char * const phase_names[PHASE_COUNT] = {
+	"tokenize", "dispatch", "search_path", "spawn", "wait"
+};
+
+/**
+ * stats_grow - Double the size of the statistics hash table
+ *
+ * Return: 0 on success, -1 if memory could not be allocated.
+ */
+int stats_grow(void)
+{
+	stats_table_t *t = &stats_table;
+	size_t new_size = t->size ? t->size * 2 : 64, i, j;
+	stats_entry_t **slots = calloc(new_size, sizeof(*slots));
+
+	if (slots == NULL)
+		return (-1);
+	for (i = 0; i < t->size; i++)
+	{
+		if (t->slots[i] == NULL)
+			continue;
+		j = hash_string(t->slots[i]->name) & (new_size - 1);
+		while (slots[j] != NULL)
+			j = (j + 1) & (new_size - 1);
+		slots[j] = t->slots[i];
+	}
+	free(t->slots);
+	t->slots = slots;
+	t->size = new_size;
+	return (0);
+}
+
+/**
+ * hist_percentile - Estimate a percentile from a histogram
+ * @h: The histogram
+ * @per_mille: The percentile, in thousandths (500 is the median)
+ *
+ * Description: The buckets are walked until the requested rank is reached
+ * and the middle of that bucket is returned, clamped to the observed
+ * minimum and maximum.
+ *
+ * Return: The estimated value in nanoseconds.
+ */
+static uint64_t hist_percentile(const histogram_t *h, uint64_t per_mille)
+{
+	uint64_t rank = (h->count * per_mille + 999) / 1000, seen = 0, low;
+	int i, k;
+
+	for (i = 0; i < HIST_BUCKETS; i++)
+	{
+		seen += h->buckets[i];
+		if (seen >= rank && h->buckets[i] != 0)
+			break;
+	}
+	if (i < 32)
+		low = (uint64_t)i;
+	else
+	{
+		k = (i - 32) / 16;
+		low = (uint64_t)(16 + (i - 32) % 16) << (k + 1);
+		low += (1UL << (k + 1)) / 2;
+	}
+	if (low < h->min)
+		return (h->min);
+	return (low > h->max ? h->max : low);
+}
+
+/**
+ * print_entry - Write the histograms of one command as a JSON member
+ * @out: The stream to write to
+ * @entry: The statistics of the command
+ * @first: Non-zero for the first command of the report
+ *
+ * Return: None.
+ */
+static void print_entry(FILE *out, const stats_entry_t *entry, int first)
+{
+	char name[256];
+	const histogram_t *h;
+	int p, printed = 0;
+
+	json_escape(name, sizeof(name), entry->name);
+	fprintf(out, "%s\n    \"%s\": {", first ? "" : ",", name);
+	for (p = 0; p < PHASE_COUNT; p++)
+	{
+		h = &entry->hist[p];
+		if (h->count == 0)
+			continue;
+		fprintf(out, "%s\n      \"%s\": {\"count\": %lu, %s%lu, ",
+			printed++ ? "," : "", phase_names[p], h->count,
+			"\"min\": ", h->min);
+		fprintf(out, "\"mean\": %lu, \"p50\": %lu, \"p90\": %lu, ",
+			h->sum / h->count, hist_percentile(h, 500),
+			hist_percentile(h, 900));
+		fprintf(out, "\"p99\": %lu, \"p999\": %lu, \"max\": %lu}",
+			hist_percentile(h, 990), hist_percentile(h, 999),
+			h->max);
+	}
+	fprintf(out, "\n    }");
+}
+
+/**
+ * stats_dump - Write the latency report as JSON
+ *
+ * Description: The report holds, for every command name seen, the count,
+ * minimum, mean, median, 90th, 99th and 99.9th percentiles and maximum of
+ * each phase, in nanoseconds. It is written to the file named by HSH_STATS,
+ * which is replaced on every dump, or to the standard error.
+ *
+ * Return: None.
+ */
+void stats_dump(void)
+{
+	FILE *out = stderr;
+	size_t i;
+	int first = 1;
+
+	if (stats_table.path != NULL)
+	{
+		out = fopen(stats_table.path, "w");
+		if (out == NULL)
+		{
+			perror(stats_table.path);
+			return;
+		}
+	}
+	fprintf(out, "{\n  \"pid\": %d,\n  \"unit\": \"ns\",\n  %s",
+		(int)getpid(), "\"commands\": {");
+	for (i = 0; i < stats_table.size; i++)
+	{
+		if (stats_table.slots[i] == NULL)
+			continue;
+		print_entry(out, stats_table.slots[i], first);
+		first = 0;
+	}
+	fprintf(out, "\n  }\n}\n");
+	if (out != stderr)
+		fclose(out);
+}
+
+/**
+ * stats_free - Write the final report and release the statistics
+ *
+ * Description: This function is registered with atexit by stats_init, so
+ * the report is written however the shell terminates normally.
+ *
+ * Return: None.
+ */
+void stats_free(void)
+{
+	size_t i;
+
+	stats_dump();
+	for (i = 0; i < stats_table.size; i++)
+	{
+		if (stats_table.slots[i] == NULL)
+			continue;
+		free(stats_table.slots[i]->name);
+		free(stats_table.slots[i]);
+	}
+	free(stats_table.slots);
+	free(stats_table.path);
+	stats_table.slots = NULL;
+	stats_table.size = 0;
+	stats_table.count = 0;
+	stats_table.path = NULL;
+}
@@ -0,0 +1,143 @@
+#include "main.h"
+
+/* Non-zero when HSH_STATS is set and latencies are being recorded */
+int stats_enabled;
+/* Table of per-command histograms, see stats_find */
+stats_table_t stats_table;
+/* Set by the SIGUSR1 handler, checked between commands by stats_poll */
+static volatile sig_atomic_t dump_requested;
+
+/**
+ * request_dump - SIGUSR1 handler asking for a statistics dump
+ * @sig: The signal number (unused)
+ *
+ * Description: Formatting JSON is not async-signal-safe, so the handler
+ * only sets a flag; the dump itself happens in stats_poll once the command
+ * that is running has finished.
+ *
+ * Return: None.
+ */
+static void request_dump(int sig)
+{
+	(void)sig;
+	dump_requested = 1;
+}
+
+/**
+ * stats_init - Enable latency statistics if HSH_STATS is set
+ *
+ * Description: HSH_STATS names the file the JSON report is written to; the
+ * values "1" and "-" select the standard error instead. When it is set the
+ * probes are activated, SIGUSR1 is set up to request a report, and a final
+ * report is written when the shell exits. When it is not set nothing is
+ * allocated and every probe stays a single test of probes_active.
+ *
+ * Return: None.
+ */
+void stats_init(void)
+{
+	char *path = _getenv("HSH_STATS");
+
+	if (path == NULL || path[0] == '\0')
+		return;
+	if (_strcmp(path, "1") == 0 || _strcmp(path, "-") == 0)
+		stats_table.path = NULL;
+	else
+		stats_table.path = _strdup(path);
+	stats_enabled = 1;
+	probes_active++;
+	signal(SIGUSR1, request_dump);
+	atexit(stats_free);
+}
+
+/**
+ * stats_find - Find or create the statistics entry of a command
+ * @name: The command name
+ *
+ * Description: The entries live in an open-addressing hash table indexed by
+ * the FNV-1a hash of the name, with linear probing. The table doubles when
+ * it is more than half full, so a lookup touches one or two slots.
+ *
+ * Return: The entry, or NULL if memory could not be allocated.
+ */
+static stats_entry_t *stats_find(const char *name)
+{
+	stats_table_t *t = &stats_table;
+	size_t i, mask;
+
+	if (t->count * 2 >= t->size && stats_grow() != 0)
+		return (NULL);
+	mask = t->size - 1;
+	for (i = hash_string(name) & mask; t->slots[i] != NULL;
+	     i = (i + 1) & mask)
+	{
+		if (_strcmp(t->slots[i]->name, name) == 0)
+			return (t->slots[i]);
+	}
+	t->slots[i] = calloc(1, sizeof(stats_entry_t));
+	if (t->slots[i] == NULL)
+		return (NULL);
+	t->slots[i]->name = _strdup(name);
+	if (t->slots[i]->name == NULL)
+	{
+		free(t->slots[i]);
+		t->slots[i] = NULL;
+		return (NULL);
+	}
+	t->count++;
+	return (t->slots[i]);
+}
+
+/**
+ * stats_record - Add one latency sample to a command's histogram
+ * @phase: The phase that was measured, one of enum phase_e
+ * @name: The command the sample belongs to
+ * @ns: The measured latency in nanoseconds
+ *
+ * Description: Histograms are log-linear like HDR histograms: values below
+ * 32 ns get a bucket each, and every further power of two is split into 16
+ * buckets, which bounds the error of a reported percentile to about 3%
+ * while keeping a fixed 976 counters per phase. Recording a sample is a
+ * hash lookup and a few arithmetic operations.
+ *
+ * Return: None.
+ */
+void stats_record(int phase, const char *name, uint64_t ns)
+{
+	stats_entry_t *entry = stats_find(name);
+	histogram_t *h;
+	int msb;
+
+	if (entry == NULL)
+		return;
+	h = &entry->hist[phase];
+	if (h->count == 0 || ns < h->min)
+		h->min = ns;
+	if (ns > h->max)
+		h->max = ns;
+	h->count++;
+	h->sum += ns;
+	if (ns < 32)
+	{
+		h->buckets[ns]++;
+		return;
+	}
+	msb = 63 - __builtin_clzl(ns);
+	h->buckets[32 + (msb - 5) * 16 + ((ns >> (msb - 4)) & 15)]++;
+}
+
+/**
+ * stats_poll - Write a report if one was requested with SIGUSR1
+ *
+ * Description: This function is called between commands. It costs a single
+ * flag test when no report was requested.
+ *
+ * Return: None.
+ */
+void stats_poll(void)
+{
+	if (!dump_requested)
+		return;
+	dump_requested = 0;
+	stats_dump();
+}
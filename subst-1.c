@@ -0,0 +1,76 @@
+#include "main.h"
+
+/**
+ * subshell_enter - Start a subshell run without forking
+ * @s: Where the state of the shell is saved
+ *
+ * Description: What a command can change in the shell is saved or
+ * journaled: the variables, the positional parameters, which 'shift'
+ * changes in place, and the scheduling settings of 'pin' and 'sched'.
+ * The current directory is saved by the first cd run in the subshell, and
+ * the functions and aliases it replaces are kept aside.
+ *
+ * Return: None.
+ */
+void subshell_enter(subshell_t *s)
+{
+	var_journal_begin(&s->journal);
+	s->params = params;
+	if (params != NULL)
+		s->frame = *params;
+	s->spawn_attr = spawn_attr;
+	s->last_status = last_status;
+	s->cwd_saved = 0;
+	s->cmds = NULL;
+	s->prev = subshell_current;
+	subshell_current = s;
+}
+
+/**
+ * subshell_leave - End a subshell run without forking
+ * @s: The state saved by subshell_enter
+ *
+ * Description: The shell gets its state back, and an 'exit', 'break' or
+ * 'return' run in the subshell only ends the subshell, as it would in a
+ * child process.
+ *
+ * Return: The status of the subshell.
+ */
+int subshell_leave(subshell_t *s)
+{
+	int status = last_status;
+
+	var_journal_end(&s->journal);
+	params = s->params;
+	if (params != NULL)
+		*params = s->frame;
+	spawn_attr = s->spawn_attr;
+	last_status = s->last_status;
+	exit_requested = 0;
+	loop_request = 0;
+	subshell_current = s->prev;
+	cwd_restore(s);
+	cmd_restore(s);
+	return (status);
+}
+
+/**
+ * subst_exec - Run the program of a command substitution
+ * @prog: The program
+ * @program_name: Name of the shell program
+ *
+ * Description: The program is run in the shell process, as a subshell
+ * whose changes are undone when it ends, so a substitution of builtins and
+ * functions forks nothing, and one of an external command forks only the
+ * command itself, even when it defines functions.
+ *
+ * Return: The status of the program.
+ */
+int subst_exec(const program_t *prog, char *program_name)
+{
+	subshell_t s;
+
+	subshell_enter(&s);
+	run_program(prog, program_name);
+	return (subshell_leave(&s));
+}
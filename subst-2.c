@@ -0,0 +1,62 @@
+#include "main.h"
+
+/**
+ * exp_command - Expand a command substitution
+ * @ex: The expansion
+ * @p: The start of the command
+ * @end: Its end
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: The output of the command, without its trailing newlines,
+ * is added like the value of a parameter, so unquoted it is split into
+ * fields.
+ *
+ * Return: None.
+ */
+void exp_command(expand_t *ex, const char *p, const char *end, int dq)
+{
+	size_t len;
+	char *out = subst_run(p, (size_t)(end - p), ex->line,
+			      ex->program_name, &len);
+
+	if (out != NULL)
+		exp_put(ex, out, len, dq ? PUT_QUOTED : PUT_EXPANDED);
+}
+
+/**
+ * exp_backquote - Expand an old-style `...` command substitution
+ * @ex: The expansion
+ * @p: The opening backquote
+ * @end: End of the text
+ * @dq: Non-zero if the substitution is inside double quotes
+ *
+ * Description: Inside backquotes, a backslash only quotes '$', '`', '\'
+ * and, within double quotes, '"'; those backslashes are removed before the
+ * command is run, and the others are left to it.
+ *
+ * Return: The position after the closing backquote.
+ */
+const char *exp_backquote(expand_t *ex, const char *p, const char *end,
+			  int dq)
+{
+	const char *q;
+	char *cmd;
+	size_t len = 0;
+
+	for (q = p + 1; q < end && *q != '`'; q++)
+	{
+		if (*q == '\\' && q + 1 < end)
+			q++;
+	}
+	cmd = arena_alloc((size_t)(q - p));
+	for (p++; p < q; p++)
+	{
+		if (*p == '\\' && p + 1 < q &&
+		    (_strchr("$`\\", p[1]) != NULL || (dq && p[1] == '"')))
+			p++;
+		cmd[len++] = *p;
+	}
+	cmd[len] = '\0';
+	exp_command(ex, cmd, cmd + len, dq);
+	return (q + (q < end));
+}
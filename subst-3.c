@@ -0,0 +1,111 @@
+#include "main.h"
+
+/* The compiled command substitutions, by text and line */
+static subst_cache_t subst_cache;
+
+/**
+ * subst_hash - Hash the text and line number of a command substitution
+ * @text: The command
+ * @len: Its length
+ * @line: The line number
+ *
+ * Return: The hash.
+ */
+static size_t subst_hash(const char *text, size_t len, int line)
+{
+	return ((size_t)hash_bytes(text, len) ^ (size_t)line * 0x9e3779b1U);
+}
+
+/**
+ * subst_rehash - Move the cache of command substitutions to a new table
+ * @size: The number of slots of the new table, a power of two
+ * @idle: Non-zero to keep the substitutions not running, 0 to free them
+ *
+ * Return: None.
+ */
+static void subst_rehash(size_t size, int idle)
+{
+	subst_cache_t *t = &subst_cache;
+	subst_prog_t **slots = calloc(size, sizeof(*slots)), *sp;
+	size_t i, j;
+
+	if (slots == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < t->size; i++)
+	{
+		sp = t->slots[i];
+		if (sp != NULL && !idle && sp->refs == 0)
+		{
+			prog_free(&sp->prog);
+			free(sp->text);
+			free(sp);
+			t->count--;
+		}
+		else if (sp != NULL)
+		{
+			j = subst_hash(sp->text, sp->len, sp->line) &
+				(size - 1);
+			while (slots[j] != NULL)
+				j = (j + 1) & (size - 1);
+			slots[j] = sp;
+		}
+	}
+	free(t->slots);
+	t->slots = slots;
+	t->size = size;
+}
+
+/**
+ * subst_compile - Get the compiled form of a command substitution
+ * @text: The command, as it was written
+ * @len: Its length
+ * @line: The line number of the substitution
+ *
+ * Description: The text of a substitution is the same each time the line
+ * holding it runs, so one in a loop or a function is compiled once and
+ * only run on the next iterations or calls, like the expressions of
+ * arith_find. The line number is part of the key, for the messages of the
+ * commands. Once the cache holds SUBST_CACHE_MAX substitutions, those that
+ * are not running are dropped, so it cannot grow without bound.
+ *
+ * Return: The substitution, which belongs to the cache.
+ */
+subst_prog_t *subst_compile(const char *text, size_t len, int line)
+{
+	subst_cache_t *t = &subst_cache;
+	subst_prog_t *sp;
+	size_t i;
+
+	for (i = t->size ? subst_hash(text, len, line) & (t->size - 1) : 0;
+	     t->size > 0 && t->slots[i] != NULL; i = (i + 1) & (t->size - 1))
+	{
+		sp = t->slots[i];
+		if (sp->line == line && sp->len == len &&
+		    memcmp(sp->text, text, len) == 0)
+			return (sp);
+	}
+	if (t->count + 1 > SUBST_CACHE_MAX)
+		subst_rehash(t->size, 0);
+	if ((t->count + 1) * 2 > t->size)
+		subst_rehash(t->size ? t->size * 2 : 64, 1);
+	sp = calloc(1, sizeof(*sp));
+	if (sp == NULL || (sp->text = malloc(len + 1)) == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(sp->text, text, len);
+	sp->text[len] = '\0';
+	sp->len = len;
+	sp->line = line;
+	parse_program(&sp->prog, arena_strndup(text, len), len, line, 1);
+	for (i = subst_hash(text, len, line) & (t->size - 1);
+	     t->slots[i] != NULL; i = (i + 1) & (t->size - 1))
+		;
+	t->slots[i] = sp;
+	t->count++;
+	return (sp);
+}
@@ -0,0 +1,132 @@
+#include "main.h"
+
+/* The status of the last command substitution of the current command */
+int subst_status;
+/* The capture files, holding 1 plus their descriptor, 0 when not open */
+static int subst_files[SUBST_FILES];
+/* The number of command substitutions being run */
+static int subst_depth;
+
+/**
+ * subst_begin - Send the standard output to a capture file
+ * @saved: Where the descriptor of the previous standard output is stored,
+ * -1 if it was closed
+ *
+ * Description: The capture file is a memfd, an anonymous file in memory,
+ * so a command writes its output to it with no reader to wait for, and
+ * external commands inherit it as their standard output like builtins use
+ * it. One file per level of nesting is kept open and emptied for reuse,
+ * so a substitution in a loop opens nothing.
+ *
+ * Return: The descriptor of the capture file, or -1 on error.
+ */
+int subst_begin(int *saved)
+{
+	int fd = -1;
+
+	if (subst_depth < SUBST_FILES)
+		fd = subst_files[subst_depth] - 1;
+	if (fd == -1)
+		fd = memfd_create("hsh-subst", MFD_CLOEXEC);
+	if (fd == -1)
+		fd = open(P_tmpdir, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+	if (fd == -1)
+	{
+		perror("memfd_create");
+		return (-1);
+	}
+	if (subst_depth < SUBST_FILES)
+		subst_files[subst_depth] = fd + 1;
+	fflush(stdout);
+	lseek(fd, 0, SEEK_SET);
+	*saved = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 10);
+	dup2(fd, STDOUT_FILENO);
+	subst_depth++;
+	return (fd);
+}
+
+/**
+ * subst_end - Restore the standard output and read what was captured
+ * @fd: The capture file returned by subst_begin
+ * @saved: The previous standard output stored by subst_begin
+ * @len: Where the length of the output is stored
+ *
+ * Description: The output is read with a single read the size of the
+ * file, straight into the arena, and its trailing newlines are removed in
+ * place. The file is then emptied, which gives its memory back.
+ *
+ * Return: The output, in the arena.
+ */
+char *subst_end(int fd, int saved, size_t *len)
+{
+	struct stat st;
+	size_t size = 0, got = 0;
+	ssize_t n;
+	char *buf;
+
+	fflush(stdout);
+	if (saved == -1)
+		close(STDOUT_FILENO);
+	else
+	{
+		dup2(saved, STDOUT_FILENO);
+		close(saved);
+	}
+	subst_depth--;
+	if (fstat(fd, &st) == 0)
+		size = (size_t)st.st_size;
+	buf = arena_alloc(size + 1);
+	while (got < size)
+	{
+		n = pread(fd, buf + got, size - got, (off_t)got);
+		if (n <= 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		got += (size_t)n;
+	}
+	if (ftruncate(fd, 0) == -1 || subst_depth >= SUBST_FILES)
+	{
+		close(fd);
+		if (subst_depth < SUBST_FILES)
+			subst_files[subst_depth] = 0;
+	}
+	while (got > 0 && buf[got - 1] == '\n')
+		got--;
+	buf[got] = '\0';
+	*len = got;
+	return (buf);
+}
+
+/**
+ * subst_run - Run the command of a command substitution
+ * @text: The command, as it was written
+ * @len: Its length
+ * @line: The line number of the substitution
+ * @program_name: Name of the shell program
+ * @out_len: Where the length of the output is stored
+ *
+ * Description: The command is compiled like an input line the first time
+ * it runs, see subst_compile, and run by subst_exec with its standard
+ * output sent to a capture file. Its status is kept in subst_status, which
+ * a command made only of assignments returns.
+ *
+ * Return: The output, in the arena, or NULL if it could not be captured.
+ */
+char *subst_run(const char *text, size_t len, int line, char *program_name,
+		size_t *out_len)
+{
+	subst_prog_t *sp = subst_compile(text, len, line);
+	char *out;
+	int fd, saved, status;
+
+	fd = subst_begin(&saved);
+	if (fd == -1)
+		return (NULL);
+	sp->refs++;
+	status = subst_exec(&sp->prog, program_name);
+	sp->refs--;
+	out = subst_end(fd, saved, out_len);
+	subst_status = status;
+	return (out);
+}
@@ -0,0 +1,133 @@
+#include "main.h"
+
+/**
+ * test_binary - Compile a binary expression of test
+ * @t: The compiler, at the first operand
+ *
+ * Description: The operands of the operators that compare integers are
+ * converted here, once, so a bad number is reported before anything is
+ * evaluated.
+ *
+ * Return: The index of the node, or -1 on error.
+ */
+int test_binary(test_t *t)
+{
+	test_node_t *node;
+	int op, i;
+
+	test_optype(t->argv[t->pos + 1], &op);
+	i = test_node(t, TEST_BINARY, -1, -1);
+	node = &t->nodes[i];
+	node->op = op;
+	node->a = t->argv[t->pos];
+	t->pos += 2;
+	if (t->pos >= t->argc)
+		return (test_error(t, "%s: argument expected",
+				   t->argv[t->pos - 1]));
+	node->b = t->argv[t->pos];
+	if (op >= TB_IEQ && op <= TB_IGE &&
+	    (test_number(t, node->a, &node->x) == -1 ||
+	     test_number(t, node->b, &node->y) == -1))
+		return (-1);
+	return (i);
+}
+
+/**
+ * test_primary - Compile a primary expression of test
+ * @t: The compiler, at the first argument of the expression
+ *
+ * Description: A primary is a parenthesized expression, a unary operator
+ * and its operand, a binary expression or a string, true if not empty.
+ * With no argument left, it is false, as in /bin/sh.
+ *
+ * Return: The index of the node, or -1 on error.
+ */
+static int test_primary(test_t *t)
+{
+	int type = test_lex(t, t->pos), i;
+
+	if (type == TT_EOI)
+		return (test_node(t, TEST_FALSE, -1, -1));
+	if (type == TT_LPAREN)
+	{
+		if (test_lex(t, ++t->pos) == TT_RPAREN)
+			return (test_node(t, TEST_FALSE, -1, -1));
+		i = test_or(t);
+		if (i != -1 && test_lex(t, ++t->pos) != TT_RPAREN)
+			return (test_error(t, "closing paren expected", NULL));
+		return (i);
+	}
+	if (type == TT_UNARY)
+	{
+		i = test_node(t, TEST_UNARY, -1, -1);
+		test_optype(t->argv[t->pos++], &t->nodes[i].op);
+		t->nodes[i].a = t->argv[t->pos];
+		if (t->nodes[i].op == 't' &&
+		    test_number(t, t->nodes[i].a, &t->nodes[i].x) == -1)
+			return (-1);
+		return (i);
+	}
+	if (test_lex(t, t->pos + 1) == TT_BINARY)
+		return (test_binary(t));
+	i = test_node(t, TEST_STR, -1, -1);
+	t->nodes[i].a = t->argv[t->pos];
+	return (i);
+}
+
+/**
+ * test_not - Compile an expression of test that may start with a '!'
+ * @t: The compiler
+ *
+ * Return: The index of the node, or -1 on error.
+ */
+static int test_not(test_t *t)
+{
+	int i;
+
+	if (test_lex(t, t->pos) != TT_NOT)
+		return (test_primary(t));
+	t->pos++;
+	i = test_not(t);
+	return (i == -1 ? -1 : test_node(t, TEST_NOT, i, -1));
+}
+
+/**
+ * test_and - Compile expressions of test joined by '-a'
+ * @t: The compiler
+ *
+ * Return: The index of the node, or -1 on error.
+ */
+static int test_and(test_t *t)
+{
+	int l = test_not(t), r;
+
+	while (l != -1 && test_lex(t, t->pos + 1) == TT_AND)
+	{
+		t->pos += 2;
+		r = test_not(t);
+		l = r == -1 ? -1 : test_node(t, TEST_AND, l, r);
+	}
+	return (l);
+}
+
+/**
+ * test_or - Compile expressions of test joined by '-o'
+ * @t: The compiler, at the first argument of the expression, and left
+ * at its last one
+ *
+ * Description: '-a' binds tighter than '-o', and both group from the left.
+ *
+ * Return: The index of the node, or -1 on error.
+ */
+int test_or(test_t *t)
+{
+	int l = test_and(t), r;
+
+	while (l != -1 && test_lex(t, t->pos + 1) == TT_OR)
+	{
+		t->pos += 2;
+		r = test_and(t);
+		l = r == -1 ? -1 : test_node(t, TEST_OR, l, r);
+	}
+	return (l);
+}
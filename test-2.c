@@ -0,0 +1,168 @@
+#include "main.h"
+
+/**
+ * test_in_group - Check if the shell is in a group
+ * @gid: The group
+ *
+ * Description: The supplementary groups are read once, since the shell
+ * never changes them.
+ *
+ * Return: 1 if @gid is the effective group or a supplementary group of
+ * the shell, 0 otherwise.
+ */
+static int test_in_group(gid_t gid)
+{
+	static gid_t *groups;
+	static int n = -1;
+	int i;
+
+	if (gid == getegid())
+		return (1);
+	if (n == -1)
+	{
+		n = getgroups(0, NULL);
+		n = n > 0 ? n : 0;
+		groups = malloc((size_t)n * sizeof(*groups) + 1);
+		if (groups == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		n = getgroups(n, groups);
+		n = n > 0 ? n : 0;
+	}
+	for (i = 0; i < n; i++)
+	{
+		if (groups[i] == gid)
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * test_access - Check the permission of a file for '-r', '-w' or '-x'
+ * @st: The status of the file
+ * @op: 'r', 'w' or 'x'
+ *
+ * Description: The permission is read from the mode bits of the class the
+ * shell belongs to, as /bin/sh does, so it comes from the cached status of
+ * the file rather than from another system call. The superuser may read
+ * and write anything, and execute a file with an execute bit.
+ *
+ * Return: 1 if the permission is granted, 0 otherwise.
+ */
+static int test_access(const struct stat *st, int op)
+{
+	mode_t bit = op == 'r' ? S_IROTH : op == 'w' ? S_IWOTH : S_IXOTH;
+	uid_t euid = geteuid();
+
+	if (euid == 0)
+		return (op != 'x' ||
+			(st->st_mode & (S_IXUSR | S_IXGRP | S_IXOTH)) != 0);
+	if (st->st_uid == euid)
+		bit <<= 6;
+	else if (test_in_group(st->st_gid))
+		bit <<= 3;
+	return ((st->st_mode & bit) != 0);
+}
+
+/**
+ * test_mode - Check the type or a mode bit of a file
+ * @st: The status of the file
+ * @op: The letter of the unary operator
+ *
+ * Return: 1 if the check succeeds, 0 otherwise.
+ */
+static int test_mode(const struct stat *st, int op)
+{
+	switch (op)
+	{
+	case 'b':
+		return (S_ISBLK(st->st_mode));
+	case 'c':
+		return (S_ISCHR(st->st_mode));
+	case 'd':
+		return (S_ISDIR(st->st_mode));
+	case 'f':
+		return (S_ISREG(st->st_mode));
+	case 'p':
+		return (S_ISFIFO(st->st_mode));
+	case 'S':
+		return (S_ISSOCK(st->st_mode));
+	case 'h':
+	case 'L':
+		return (S_ISLNK(st->st_mode));
+	case 's':
+		return (st->st_size > 0);
+	case 'g':
+		return ((st->st_mode & S_ISGID) != 0);
+	case 'u':
+		return ((st->st_mode & S_ISUID) != 0);
+	case 'k':
+		return ((st->st_mode & S_ISVTX) != 0);
+	case 'O':
+		return (st->st_uid == geteuid());
+	case 'G':
+		return (st->st_gid == getegid());
+	case 'e':
+		return (1);
+	}
+	return (test_access(st, op));
+}
+
+/**
+ * test_unary - Evaluate a unary expression of test
+ * @node: The node
+ *
+ * Description: Every operator on files costs one call to test_stat, so
+ * the checks of one line on the same file share a single stat.
+ *
+ * Return: 1 if the expression is true, 0 otherwise.
+ */
+static int test_unary(const test_node_t *node)
+{
+	struct stat st;
+
+	if (node->op == 'n')
+		return (node->a[0] != '\0');
+	if (node->op == 'z')
+		return (node->a[0] == '\0');
+	if (node->op == 't')
+		return (node->x >= 0 && node->x <= INT_MAX &&
+			isatty((int)node->x));
+	if (test_stat(node->a, node->op != 'h' && node->op != 'L', &st) == -1)
+		return (0);
+	return (test_mode(&st, node->op));
+}
+
+/**
+ * test_eval - Evaluate a compiled test expression
+ * @t: The compiler that compiled it
+ * @i: Index of the node to evaluate
+ *
+ * Description: '-a' and '-o' stop at the first operand that decides the
+ * result, which is safe since compiling already reported every error.
+ *
+ * Return: 1 if the expression is true, 0 otherwise.
+ */
+int test_eval(const test_t *t, int i)
+{
+	const test_node_t *node = &t->nodes[i];
+
+	switch (node->kind)
+	{
+	case TEST_OR:
+		return (test_eval(t, node->l) || test_eval(t, node->r));
+	case TEST_AND:
+		return (test_eval(t, node->l) && test_eval(t, node->r));
+	case TEST_NOT:
+		return (!test_eval(t, node->l));
+	case TEST_STR:
+		return (node->a[0] != '\0');
+	case TEST_UNARY:
+		return (test_unary(node));
+	case TEST_BINARY:
+		return (test_binop(node));
+	}
+	return (0);
+}
@@ -0,0 +1,120 @@
+#include "main.h"
+
+/* Changes whenever files may have changed, see test_stat */
+unsigned long stat_epoch;
+
+/* The statuses of the files test looked at, by hash of path */
+static test_stat_t test_stats[TEST_STAT_CACHE];
+
+/**
+ * test_stat - Get the status of a file for test
+ * @path: The file
+ * @follow: Non-zero to follow a final symbolic link, like stat, zero to
+ * look at the link itself, like lstat
+ * @st: Set to the status on success
+ *
+ * Description: The result is cached until stat_epoch moves on, so a line
+ * of checks on the same file, like '[ -e f ] && [ -r f ] && [ -s f ]',
+ * makes a single call. The shell moves stat_epoch on whenever files may
+ * change under it: when a command of another line than the last one is
+ * dispatched, when it starts a process, opens the files of redirections,
+ * goes back to the start of a loop or runs a builtin that can block or
+ * write, so a cached status is never older than the last of these.
+ *
+ * Return: 0 on success, -1 with errno set on error.
+ */
+int test_stat(const char *path, int follow, struct stat *st)
+{
+	test_stat_t *e = &test_stats[(hash_string(path) + (unsigned long)follow)
+				     & (TEST_STAT_CACHE - 1)];
+	int stale = e->follow != follow || e->epoch != stat_epoch;
+
+	if (e->path == NULL || _strcmp(e->path, path) != 0)
+	{
+		free(e->path);
+		e->path = _strdup(path);
+		if (e->path == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		stale = 1;
+	}
+	if (stale)
+	{
+		e->follow = follow;
+		e->epoch = stat_epoch;
+		e->err = (follow ? stat(path, &e->st) :
+			  lstat(path, &e->st)) == -1 ? errno : 0;
+	}
+	if (e->err != 0)
+	{
+		errno = e->err;
+		return (-1);
+	}
+	*st = e->st;
+	return (0);
+}
+
+/**
+ * test_cmp - Turn a comparison into the result of a binary operator
+ * @op: The TB_ operator
+ * @cmp: Negative, zero or positive as the first operand is less than,
+ * equal to or greater than the second
+ *
+ * Return: 1 if the expression is true, 0 otherwise.
+ */
+static int test_cmp(int op, int cmp)
+{
+	switch (op)
+	{
+	case TB_EQ:
+	case TB_IEQ:
+		return (cmp == 0);
+	case TB_NE:
+	case TB_INE:
+		return (cmp != 0);
+	case TB_LT:
+	case TB_ILT:
+	case TB_OT:
+		return (cmp < 0);
+	case TB_ILE:
+		return (cmp <= 0);
+	case TB_GT:
+	case TB_IGT:
+	case TB_NT:
+		return (cmp > 0);
+	}
+	return (cmp >= 0);
+}
+
+/**
+ * test_binop - Evaluate a binary expression of test
+ * @node: The node
+ *
+ * Description: '-nt', '-ot' and '-ef' are false unless both files exist,
+ * as in /bin/sh. Strings compare by their bytes.
+ *
+ * Return: 1 if the expression is true, 0 otherwise.
+ */
+int test_binop(const test_node_t *node)
+{
+	struct stat a, b;
+	int cmp;
+
+	if (node->op <= TB_GT)
+		return (test_cmp(node->op, strcmp(node->a, node->b)));
+	if (node->op <= TB_IGE)
+		return (test_cmp(node->op, (node->x > node->y) -
+				 (node->x < node->y)));
+	if (test_stat(node->a, 1, &a) == -1 || test_stat(node->b, 1, &b) == -1)
+		return (0);
+	if (node->op == TB_EF)
+		return (a.st_dev == b.st_dev && a.st_ino == b.st_ino);
+	cmp = (a.st_mtim.tv_sec > b.st_mtim.tv_sec) -
+		(a.st_mtim.tv_sec < b.st_mtim.tv_sec);
+	if (cmp == 0)
+		cmp = (a.st_mtim.tv_nsec > b.st_mtim.tv_nsec) -
+			(a.st_mtim.tv_nsec < b.st_mtim.tv_nsec);
+	return (test_cmp(node->op, cmp));
+}
@@ -0,0 +1,93 @@
+#include "main.h"
+
+/**
+ * test_compile - Compile the arguments of test
+ * @t: The compiler
+ * @neg: Set to 1 if a leading '!' the rules of POSIX took out negates
+ * the result
+ *
+ * Description: POSIX decides how up to four arguments are read from
+ * their number, before any precedence: three arguments around a binary
+ * operator are a comparison, whatever the first one is, and a leading '!'
+ * or surrounding parentheses are taken out. Longer expressions are only
+ * read by the precedence of the operators, as in /bin/sh.
+ *
+ * Return: The index of the root node, or -1 on error.
+ */
+static int test_compile(test_t *t, int *neg)
+{
+	int op, root;
+
+	while (t->argc == 3 || t->argc == 4)
+	{
+		if (t->argc == 3 &&
+		    test_optype(t->argv[1], &op) == TT_BINARY)
+			return (test_binary(t));
+		if (_strcmp(t->argv[0], "(") == 0 &&
+		    _strcmp(t->argv[t->argc - 1], ")") == 0)
+		{
+			t->argv++;
+			t->argc -= 2;
+			break;
+		}
+		if (_strcmp(t->argv[0], "!") != 0)
+			break;
+		*neg = 1;
+		t->argv++;
+		t->argc--;
+	}
+	if (t->argc == 0)
+		return (test_node(t, TEST_FALSE, -1, -1));
+	root = test_or(t);
+	if (root != -1 && t->pos + 1 < t->argc)
+		return (test_error(t, "%s: unexpected operator",
+				   t->argv[t->pos]));
+	return (root);
+}
+
+/**
+ * builtin_test - Evaluate a conditional expression
+ * @tokens: 'test' or '[', then the expression, then ']' for '['
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The expression is compiled into a tree of nodes in the
+ * arena, with its numbers converted, and then evaluated, so a malformed
+ * expression is reported without looking at any file. The checks on
+ * files go through the stat cache of test_stat.
+ *
+ * Return: 0 if the expression is true, 1 if it is false, 2 on error.
+ */
+int builtin_test(char **tokens, int line_number, char *program_name)
+{
+	test_t t;
+	int neg = 0, root;
+
+	t.argc = 0;
+	while (tokens[t.argc + 1] != NULL)
+		t.argc++;
+	if (_strcmp(tokens[0], "[") == 0 &&
+	    (t.argc == 0 || _strcmp(tokens[t.argc], "]") != 0))
+	{
+		fprintf(stderr, "%s: %d: [: missing ]\n", program_name,
+			line_number);
+		return (2);
+	}
+	t.argc -= _strcmp(tokens[0], "[") == 0;
+	t.argv = tokens + 1;
+	t.pos = 0;
+	t.n = 0;
+	t.err = NULL;
+	t.err_arg = NULL;
+	t.nodes = arena_alloc((size_t)(2 * t.argc + 2) * sizeof(*t.nodes));
+	root = test_compile(&t, &neg);
+	if (root == -1)
+	{
+		fprintf(stderr, "%s: %d: %s: ", program_name, line_number,
+			tokens[0]);
+		fprintf(stderr, t.err, t.err_arg);
+		fputc('\n', stderr);
+		return (2);
+	}
+	return (test_eval(&t, root) ? neg : !neg);
+}
@@ -0,0 +1,138 @@
+#include "main.h"
+
+/**
+ * test_optype - Tell which operator of test an argument is
+ * @s: The argument
+ * @op: Set to the letter of a unary operator or the TB_ code of a binary
+ * one
+ *
+ * Return: The TT_ token of the operator, or TT_OPERAND if @s is none.
+ */
+int test_optype(const char *s, int *op)
+{
+	static const char * const binops[] = {"=", "!=", "<", ">", "-eq",
+		"-ne", "-lt", "-le", "-gt", "-ge", "-nt", "-ot", "-ef", NULL};
+	static const char * const others[] = {"-a", "-o", "!", "(", ")",
+		NULL};
+	int i;
+
+	if (s[0] == '-' && s[1] != '\0' && s[2] == '\0' &&
+	    _strchr("bcdefghknprstuwxzGLOS", s[1]) != NULL)
+	{
+		*op = s[1];
+		return (TT_UNARY);
+	}
+	for (i = 0; binops[i] != NULL; i++)
+	{
+		if (_strcmp(s, binops[i]) == 0)
+		{
+			*op = i;
+			return (TT_BINARY);
+		}
+	}
+	for (i = 0; others[i] != NULL; i++)
+	{
+		if (_strcmp(s, others[i]) == 0)
+			return (TT_AND + i);
+	}
+	return (TT_OPERAND);
+}
+
+/**
+ * test_lex - Get the token of an argument of test
+ * @t: The compiler
+ * @i: Index of the argument
+ *
+ * Description: The rules of /bin/sh decide when an operator is taken as
+ * a plain string: a unary operator that is the last argument, or that is
+ * followed by a binary operator and another argument, as in '-n = -n',
+ * and a '(' that is the last argument.
+ *
+ * Return: The TT_ token.
+ */
+int test_lex(test_t *t, int i)
+{
+	int type, next, op;
+
+	if (i >= t->argc)
+		return (TT_EOI);
+	type = test_optype(t->argv[i], &op);
+	if (type == TT_UNARY)
+	{
+		if (i + 1 >= t->argc)
+			return (TT_OPERAND);
+		next = test_optype(t->argv[i + 1], &op);
+		if (i + 2 < t->argc && next == TT_BINARY)
+			return (TT_OPERAND);
+	}
+	if (type == TT_LPAREN && i + 1 >= t->argc)
+		return (TT_OPERAND);
+	return (type);
+}
+
+/**
+ * test_node - Add a node to a compiled test expression
+ * @t: The compiler, whose node array has room for it
+ * @kind: The TEST_ kind of the node
+ * @l: Index of its first operand node, if any
+ * @r: Index of its second operand node, if any
+ *
+ * Return: The index of the node, whose other members are left to the
+ * caller.
+ */
+int test_node(test_t *t, int kind, int l, int r)
+{
+	test_node_t *node = &t->nodes[t->n];
+
+	node->kind = kind;
+	node->op = 0;
+	node->a = NULL;
+	node->b = NULL;
+	node->l = l;
+	node->r = r;
+	return (t->n++);
+}
+
+/**
+ * test_number - Convert an operand of test that must be an integer
+ * @t: The compiler, whose error is set if @s is not one
+ * @s: The operand
+ * @n: Set to its value
+ *
+ * Description: Blanks are allowed around the digits, as in /bin/sh.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int test_number(test_t *t, const char *s, long *n)
+{
+	char *end;
+
+	errno = 0;
+	*n = strtol(s, &end, 10);
+	while (end != s && isspace((unsigned char)*end))
+		end++;
+	if (errno == 0 && end != s && *end == '\0')
+		return (0);
+	return (test_error(t, "Illegal number: %s", s));
+}
+
+/**
+ * test_error - Record an error of a test expression
+ * @t: The compiler
+ * @fmt: The format of the message, taking @arg as its only argument
+ * @arg: The argument the error is about
+ *
+ * Description: Only the first error is kept, and reported by builtin_test
+ * once the compiler has given up.
+ *
+ * Return: Always -1.
+ */
+int test_error(test_t *t, const char *fmt, const char *arg)
+{
+	if (t->err == NULL)
+	{
+		t->err = fmt;
+		t->err_arg = arg;
+	}
+	return (-1);
+}
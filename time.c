@@ -0,0 +1,173 @@
+#include "main.h"
+
+#define TIME_HUMAN 0
+#define TIME_POSIX 1
+#define TIME_JSON 2
+
+/**
+ * tv_ns - Convert a struct timeval to nanoseconds
+ * @tv: The timeval to convert
+ *
+ * Return: The number of nanoseconds.
+ */
+static uint64_t tv_ns(const struct timeval *tv)
+{
+	return ((uint64_t)tv->tv_sec * 1000000000UL +
+		(uint64_t)tv->tv_usec * 1000UL);
+}
+
+/**
+ * time_options - Read the options of 'time'
+ * @tokens: The command, 'time [-p] [-f human|posix|json] cmd...'
+ * @format: Where the report format is stored
+ *
+ * Return: The index of the command to time, or -1 on a usage error.
+ */
+static int time_options(char **tokens, int *format)
+{
+	int i;
+
+	for (i = 1; tokens[i] != NULL && tokens[i][0] == '-'; i++)
+	{
+		if (_strcmp(tokens[i], "--") == 0)
+			return (i + 1);
+		if (_strcmp(tokens[i], "-p") == 0)
+			*format = TIME_POSIX;
+		else if (_strcmp(tokens[i], "-f") != 0 || tokens[i + 1] == NULL)
+			return (-1);
+		else if (_strcmp(tokens[++i], "human") == 0)
+			*format = TIME_HUMAN;
+		else if (_strcmp(tokens[i], "posix") == 0)
+			*format = TIME_POSIX;
+		else if (_strcmp(tokens[i], "json") == 0)
+			*format = TIME_JSON;
+		else
+			return (-1);
+	}
+	return (i);
+}
+
+/**
+ * print_time_human - Print a timing report in the bash or POSIX format
+ * @t: The timing of the command
+ * @real: The elapsed wall-clock time in nanoseconds
+ * @format: TIME_HUMAN or TIME_POSIX
+ *
+ * Description: The first three lines match the output of the bash 'time'
+ * keyword (or 'time -p' for the POSIX format). The human format adds the
+ * peak resident set size, the page faults and the context switches of the
+ * command, followed by the time the shell spent in PATH lookup, in fork and
+ * waiting for the command.
+ *
+ * Return: None.
+ */
+static void print_time_human(const cmd_timing_t *t, uint64_t real,
+			     int format)
+{
+	uint64_t v[3];
+	const char *names[3] = {"real", "user", "sys"};
+	int i;
+
+	v[0] = real;
+	v[1] = tv_ns(&t->usage.ru_utime);
+	v[2] = tv_ns(&t->usage.ru_stime);
+	if (format == TIME_POSIX)
+	{
+		for (i = 0; i < 3; i++)
+			fprintf(stderr, "%s %lu.%02lu\n", names[i],
+				v[i] / 1000000000UL, v[i] / 10000000UL % 100);
+		return;
+	}
+	fprintf(stderr, "\n");
+	for (i = 0; i < 3; i++)
+		fprintf(stderr, "%s\t%lum%lu.%03lus\n", names[i],
+			v[i] / 60000000000UL, v[i] / 1000000000UL % 60,
+			v[i] / 1000000UL % 1000);
+	fprintf(stderr, "maxrss\t%ld KB\nfaults\t%ld major, %ld minor\n",
+		t->usage.ru_maxrss, t->usage.ru_majflt, t->usage.ru_minflt);
+	fprintf(stderr, "ctxsw\t%ld voluntary, %ld involuntary\n",
+		t->usage.ru_nvcsw, t->usage.ru_nivcsw);
+	fprintf(stderr, "lookup\t%lu.%06lus\nspawn\t%lu.%06lus\n",
+		t->phase_ns[PHASE_LOOKUP] / 1000000000UL,
+		t->phase_ns[PHASE_LOOKUP] / 1000UL % 1000000,
+		t->phase_ns[PHASE_SPAWN] / 1000000000UL,
+		t->phase_ns[PHASE_SPAWN] / 1000UL % 1000000);
+	fprintf(stderr, "wait\t%lu.%06lus\n",
+		t->phase_ns[PHASE_WAIT] / 1000000000UL,
+		t->phase_ns[PHASE_WAIT] / 1000UL % 1000000);
+}
+
+/**
+ * print_time_json - Print a timing report as a single JSON object
+ * @t: The timing of the command
+ * @real: The elapsed wall-clock time in nanoseconds
+ * @status: The exit status of the command
+ *
+ * Description: All durations are integers in nanoseconds and the resident
+ * set size is in kilobytes, so the line can be parsed without any loss of
+ * precision.
+ *
+ * Return: None.
+ */
+static void print_time_json(const cmd_timing_t *t, uint64_t real, int status)
+{
+	fprintf(stderr, "{\"status\":%d,\"real_ns\":%lu,\"user_ns\":%lu,",
+		status, real, tv_ns(&t->usage.ru_utime));
+	fprintf(stderr, "\"sys_ns\":%lu,\"maxrss_kb\":%ld,\"majflt\":%ld,",
+		tv_ns(&t->usage.ru_stime), t->usage.ru_maxrss,
+		t->usage.ru_majflt);
+	fprintf(stderr, "\"minflt\":%ld,\"nvcsw\":%ld,\"nivcsw\":%ld,",
+		t->usage.ru_minflt, t->usage.ru_nvcsw, t->usage.ru_nivcsw);
+	fprintf(stderr, "\"children\":%d,\"lookup_ns\":%lu,\"spawn_ns\":%lu,",
+		t->children, t->phase_ns[PHASE_LOOKUP],
+		t->phase_ns[PHASE_SPAWN]);
+	fprintf(stderr, "\"wait_ns\":%lu}\n", t->phase_ns[PHASE_WAIT]);
+}
+
+/**
+ * builtin_time - Run a command and report the resources it used
+ * @tokens: The command, 'time [-p] [-f human|posix|json] cmd...'
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: While the command runs, the probes in execute_command,
+ * spawn_command and wait_command are enabled and feed a cmd_timing_t, and
+ * the resource usage of every child reaped with wait4 is accumulated. The
+ * report is printed on the standard error once the command has finished.
+ * Timing a builtin reports the CPU time the shell itself used.
+ *
+ * Return: The exit status of the command, or 2 on a usage error.
+ */
+int builtin_time(char **tokens, int line_number, char *program_name)
+{
+	cmd_timing_t t, *saved = timing;
+	struct rusage before;
+	int i, format = TIME_HUMAN, status = 0;
+	uint64_t start, elapsed;
+
+	i = time_options(tokens, &format);
+	if (i == -1)
+	{
+		fprintf(stderr, "%s: %d: time: usage: time [-p] %s\n",
+			program_name, line_number,
+			"[-f human|posix|json] [command]");
+		return (2);
+	}
+	memset(&t, 0, sizeof(t));
+	getrusage(RUSAGE_SELF, &before);
+	timing = &t;
+	probes_active++;
+	start = now_ns();
+	if (tokens[i] != NULL)
+		status = dispatch_command(tokens + i, line_number,
+					  program_name);
+	elapsed = now_ns() - start;
+	probes_active--;
+	timing = saved;
+	add_self_usage(&t, &before);
+	if (format == TIME_JSON)
+		print_time_json(&t, elapsed, status);
+	else
+		print_time_human(&t, elapsed, format);
+	return (status);
+}
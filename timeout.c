@@ -0,0 +1,235 @@
+#include "main.h"
+
+#define TIMEOUT_STATUS 124
+#define TIMEOUT_FAILURE 125
+#define TIMEOUT_KILL_AFTER_NS 1000000000UL
+
+/**
+ * struct timeout_opts_s - Parsed arguments of the 'timeout' builtin
+ * @sig: Signal sent when the duration expires
+ * @duration: Time the command may run, in nanoseconds (0 means forever)
+ * @kill_after: Grace period before SIGKILL is sent (0 means never)
+ * @argv: The command to run and its arguments
+ */
+typedef struct timeout_opts_s
+{
+	int sig;
+	uint64_t duration;
+	uint64_t kill_after;
+	char **argv;
+} timeout_opts_t;
+
+/**
+ * parse_timeout_args - Parse 'timeout [-s SIG] [-k DURATION] DURATION cmd'
+ * @tokens: The tokens of the timeout command
+ * @opts: Where to store the parsed options
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: The grace period defaults to one second so that a command
+ * ignoring the first signal is still reaped; '-k 0' disables the SIGKILL
+ * escalation. Errors are reported on the standard error in the same format
+ * as the other shell errors.
+ *
+ * Return: 0 on success, -1 on a usage error.
+ */
+static int parse_timeout_args(char **tokens, timeout_opts_t *opts,
+			      int line_number, char *program_name)
+{
+	int i = 1;
+
+	opts->sig = SIGTERM;
+	opts->kill_after = TIMEOUT_KILL_AFTER_NS;
+	for (; tokens[i] != NULL && tokens[i][0] == '-'; i += 2)
+	{
+		if (_strcmp(tokens[i], "--") == 0)
+		{
+			i++;
+			break;
+		}
+		if (tokens[i + 1] == NULL)
+			break;
+		if (_strcmp(tokens[i], "-s") == 0)
+			opts->sig = signal_from_name(tokens[i + 1]);
+		else if (_strcmp(tokens[i], "-k") != 0 ||
+			 parse_duration(tokens[i + 1], &opts->kill_after) != 0)
+			opts->sig = -1;
+		if (opts->sig < 0)
+		{
+			fprintf(stderr, "%s: %d: timeout: %s: %s %s\n",
+				program_name, line_number, "invalid option",
+				tokens[i], tokens[i + 1]);
+			return (-1);
+		}
+	}
+	if (tokens[i] == NULL || tokens[i + 1] == NULL ||
+	    parse_duration(tokens[i], &opts->duration) != 0)
+	{
+		fprintf(stderr, "%s: %d: timeout: usage: timeout %s\n",
+			program_name, line_number,
+			"[-s SIG] [-k DURATION] DURATION cmd");
+		return (-1);
+	}
+	opts->argv = tokens + i + 1;
+	return (0);
+}
+
+/**
+ * open_pidfd - Get a file descriptor that becomes readable when a child exits
+ * @child_pid: The process to watch
+ *
+ * Return: The pidfd, or -1 if the kernel does not support pidfd_open.
+ */
+static int open_pidfd(pid_t child_pid)
+{
+#ifdef SYS_pidfd_open
+	return ((int)syscall(SYS_pidfd_open, child_pid, 0));
+#else
+	(void)child_pid;
+	return (-1);
+#endif
+}
+
+/**
+ * wait_until - Wait for a child to exit, giving up at a deadline
+ * @child_pid: The process to wait for
+ * @pidfd: A pidfd for the child, or -1 to fall back to polling
+ * @deadline: Monotonic time, in nanoseconds, at which to give up
+ * @status: Where to store the raw wait status once the child is reaped
+ *
+ * Description: With a pidfd the function sleeps in ppoll until either the
+ * child exits or the deadline passes, so no extra process or timer signal
+ * is needed and the deadline is honoured with nanosecond resolution. On
+ * kernels without pidfd_open it falls back to sleeping in steps of at most
+ * one millisecond between non-blocking wait4 calls. The child's resource
+ * usage is passed to account_child once it has been reaped.
+ *
+ * Return: 1 if the child was reaped, 0 if the deadline passed first, or -1
+ * on error.
+ */
+static int wait_until(pid_t child_pid, int pidfd, uint64_t deadline,
+		      int *status)
+{
+	struct pollfd pfd;
+	struct timespec ts;
+	struct rusage usage;
+	uint64_t now;
+	pid_t ret;
+
+	pfd.fd = pidfd;
+	pfd.events = POLLIN;
+	while (1)
+	{
+		ret = wait4(child_pid, status, WNOHANG, &usage);
+		if (ret == child_pid)
+		{
+			account_child(&usage);
+			return (1);
+		}
+		if (ret == -1 && errno != EINTR)
+			return (-1);
+		now = now_ns();
+		if (now >= deadline)
+			return (0);
+		if (pidfd >= 0)
+		{
+			ns_to_timespec(deadline - now, &ts);
+			ppoll(&pfd, 1, &ts, NULL);
+		}
+		else
+		{
+			ns_to_timespec(deadline - now < 1000000 ?
+				       deadline - now : 1000000, &ts);
+			nanosleep(&ts, NULL);
+		}
+	}
+}
+
+/**
+ * stop_child - Signal a child whose time is up and reap it
+ * @child_pid: The process to stop
+ * @pidfd: A pidfd for the child, or -1
+ * @opts: The parsed timeout options
+ *
+ * Description: The configured signal is sent first, followed by SIGCONT in
+ * case the child is stopped. If the child is still running once the grace
+ * period has elapsed it is sent SIGKILL.
+ *
+ * Return: 124, or 137 if the child had to be killed with SIGKILL.
+ */
+static int stop_child(pid_t child_pid, int pidfd, timeout_opts_t *opts)
+{
+	int status;
+
+	kill(child_pid, opts->sig);
+	if (opts->sig != SIGKILL && opts->sig != SIGCONT)
+		kill(child_pid, SIGCONT);
+	if (opts->kill_after == 0)
+	{
+		wait_command(child_pid);
+		return (opts->sig == SIGKILL ? 128 + SIGKILL : TIMEOUT_STATUS);
+	}
+	if (wait_until(child_pid, pidfd, now_ns() + opts->kill_after,
+		       &status) == 1)
+		return (opts->sig == SIGKILL ? 128 + SIGKILL : TIMEOUT_STATUS);
+	kill(child_pid, SIGKILL);
+	wait_command(child_pid);
+	return (128 + SIGKILL);
+}
+
+/**
+ * builtin_timeout - Run a command with a time limit
+ * @tokens: The command, 'timeout [-s SIG] [-k DURATION] DURATION cmd...'
+ * @line_number: Line number of the command in the input
+ * @program_name: Name of the shell program
+ *
+ * Description: This builtin replaces /usr/bin/timeout without the extra
+ * fork and exec it costs. The command is looked up and started through
+ * search_path and spawn_command, exactly like any other external command,
+ * and the shell then waits on a pidfd with a deadline. When the duration
+ * expires the child is sent SIGTERM (or the signal given with -s), then
+ * SIGKILL if it is still alive after the grace period. A duration of 0
+ * disables the time limit.
+ *
+ * Return: The exit status of the command, 124 if it timed out, 125 on a
+ * usage error and 127 if the command was not found.
+ */
+int builtin_timeout(char **tokens, int line_number, char *program_name)
+{
+	timeout_opts_t opts;
+	char *path;
+	pid_t child_pid;
+	int pidfd, status, ret;
+	uint64_t start;
+
+	if (parse_timeout_args(tokens, &opts, line_number, program_name) != 0)
+		return (TIMEOUT_FAILURE);
+	start = probe_start();
+	path = search_path(opts.argv);
+	probe_end(PHASE_LOOKUP, start);
+	if (path == NULL)
+	{
+		fprintf(stderr, "%s: %d: %s: not found\n",
+			program_name, line_number, opts.argv[0]);
+		return (127);
+	}
+	child_pid = spawn_command(path, opts.argv, line_number, program_name);
+	free(path);
+	if (opts.duration == 0)
+		return (wait_command(child_pid));
+
+	pidfd = open_pidfd(child_pid);
+	probe_pid = child_pid;
+	start = probe_start();
+	ret = wait_until(child_pid, pidfd, now_ns() + opts.duration, &status);
+	probe_end(PHASE_WAIT, start);
+	if (ret == 1)
+		status = decode_status(status);
+	else if (ret == 0)
+		status = stop_child(child_pid, pidfd, &opts);
+	else
+		status = 1;
+	if (pidfd >= 0)
+		close(pidfd);
+	return (status);
+}
@@ -0,0 +1,134 @@
+#include "main.h"
+
+#define TRACE_BUFSIZE 65536
+
+/* Non-zero when --trace was given */
+int trace_enabled;
+static int trace_fd = -1;
+static pid_t trace_pid;
+static unsigned long trace_events;
+static size_t trace_len;
+static char trace_buf[TRACE_BUFSIZE];
+
+/**
+ * trace_flush - Write the buffered trace events to the trace file
+ *
+ * Description: Events are formatted into a static buffer and only written
+ * when it is full or the shell exits, so tracing costs one write system
+ * call per few hundred events instead of one per event.
+ *
+ * Return: None.
+ */
+static void trace_flush(void)
+{
+	size_t done = 0;
+	ssize_t ret;
+
+	while (done < trace_len)
+	{
+		ret = write(trace_fd, trace_buf + done, trace_len - done);
+		if (ret == -1 && errno == EINTR)
+			continue;
+		if (ret <= 0)
+			break;
+		done += (size_t)ret;
+	}
+	trace_len = 0;
+}
+
+/**
+ * trace_open - Start writing a trace to a file
+ * @path: The file to write the trace to
+ *
+ * Description: The trace uses the JSON array form of the Chrome trace event
+ * format, which chrome://tracing and Perfetto open directly. The file
+ * descriptor is close-on-exec so that commands do not inherit it, and the
+ * array is closed by trace_close when the shell exits.
+ *
+ * Return: 0 on success, -1 if the file could not be created.
+ */
+int trace_open(const char *path)
+{
+	trace_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (trace_fd == -1)
+		return (-1);
+	trace_pid = getpid();
+	trace_buf[0] = '[';
+	trace_len = 1;
+	trace_enabled = 1;
+	probes_active++;
+	atexit(trace_close);
+	return (0);
+}
+
+/**
+ * trace_span - Append a complete ("X") event to the trace
+ * @name: The name of the span, such as "fork"
+ * @start: Monotonic start time in nanoseconds
+ * @end: Monotonic end time in nanoseconds
+ * @tid: Thread the span is shown on, or 0 for the shell itself
+ *
+ * Description: Times are written in microseconds with nanosecond decimals.
+ * Every span carries the command name and its input line as arguments.
+ *
+ * Return: None.
+ */
+void trace_span(const char *name, uint64_t start, uint64_t end, pid_t tid)
+{
+	char event[512], cmd[256];
+	int len;
+
+	json_escape(cmd, sizeof(cmd), probe_name != NULL ? probe_name : "");
+	len = snprintf(event, sizeof(event),
+		       "%s\n{\"name\":\"%s\",\"cat\":\"hsh\",\"ph\":\"X\","
+		       "\"ts\":%lu.%03lu,\"dur\":%lu.%03lu,"
+		       "\"pid\":%d,\"tid\":%d,"
+		       "\"args\":{\"cmd\":\"%s\",\"line\":%d}}",
+		       trace_events++ ? "," : "", name, start / 1000,
+		       start % 1000, (end - start) / 1000, (end - start) % 1000,
+		       (int)trace_pid, (int)(tid ? tid : trace_pid), cmd,
+		       probe_line);
+	if (len < 0 || len >= (int)sizeof(event))
+		return;
+	if (trace_len + (size_t)len > TRACE_BUFSIZE)
+		trace_flush();
+	_memcpy(trace_buf + trace_len, event, (unsigned int)len);
+	trace_len += (size_t)len;
+}
+
+/**
+ * trace_close - Terminate the trace and close the trace file
+ *
+ * Description: This function is registered with atexit by trace_open.
+ *
+ * Return: None.
+ */
+void trace_close(void)
+{
+	if (trace_fd == -1)
+		return;
+	if (trace_len + 3 > TRACE_BUFSIZE)
+		trace_flush();
+	_memcpy(trace_buf + trace_len, "\n]\n", 3);
+	trace_len += 3;
+	trace_flush();
+	close(trace_fd);
+	trace_fd = -1;
+	trace_enabled = 0;
+}
+
+/**
+ * probe_line_end - Record the span covering a whole command
+ * @start: The value returned by probe_start before the command was run
+ *
+ * Description: The "line" span encloses the dispatch, lookup, fork and
+ * child spans of the command, so each line appears as one block in the
+ * trace viewer, following the parse span of the line or script.
+ *
+ * Return: None.
+ */
+void probe_line_end(uint64_t start)
+{
+	if (trace_enabled && start != 0)
+		trace_span("line", start, now_ns(), 0);
+}
@@ -0,0 +1,124 @@
+#include "main.h"
+
+/**
+ * vars_grow - Double the size of the variable hash table
+ *
+ * Return: 0 on success, -1 if memory could not be allocated.
+ */
+int vars_grow(void)
+{
+	var_table_t *t = &var_table;
+	size_t new_size = t->size ? t->size * 2 : 128, i, j;
+	var_t **slots = calloc(new_size, sizeof(*slots));
+
+	if (slots == NULL)
+		return (-1);
+	for (i = 0; i < t->size; i++)
+	{
+		if (t->slots[i] == NULL)
+			continue;
+		j = hash_bytes(t->slots[i]->str, t->slots[i]->name_len) &
+			(new_size - 1);
+		while (slots[j] != NULL)
+			j = (j + 1) & (new_size - 1);
+		slots[j] = t->slots[i];
+	}
+	free(t->slots);
+	t->slots = slots;
+	t->size = new_size;
+	return (0);
+}
+
+/**
+ * vars_init - Import the environment into the variable table
+ *
+ * Description: Every "NAME=value" entry of environ becomes an exported
+ * variable, and environ is then pointed at the array built by var_environ,
+ * so the environment passed to commands always reflects the variables. The
+ * first entry wins when a name appears twice.
+ *
+ * Return: None.
+ */
+void vars_init(void)
+{
+	char **env = environ;
+	const char *eq;
+	var_t *v;
+
+	for (; env != NULL && *env != NULL; env++)
+	{
+		eq = _strchr(*env, '=');
+		if (eq == NULL || eq == *env)
+			continue;
+		v = var_lookup(*env, (size_t)(eq - *env), 1);
+		if (v->flags & VAR_UNSET)
+			var_assign(v, eq + 1, VAR_EXPORT);
+	}
+	var_table.env_dirty = 1;
+	var_environ();
+}
+
+/**
+ * var_environ - Get the environment of the commands the shell runs
+ *
+ * Description: The array points at the "NAME=value" buffers of the
+ * exported variables, so nothing is copied. It is only rebuilt after a
+ * change marked it dirty, which makes it free to call before every
+ * command. environ is kept pointing at it.
+ *
+ * Return: The NULL-terminated array of exported variables.
+ */
+char **var_environ(void)
+{
+	var_table_t *t = &var_table;
+	size_t i, n = 0;
+	char **env;
+	var_t *v;
+
+	if (!t->env_dirty && t->env != NULL)
+		return (t->env);
+	if (t->env_cap < t->count + 1)
+	{
+		env = realloc(t->env, (t->count + 1) * sizeof(*env));
+		if (env == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		t->env = env;
+		t->env_cap = t->count + 1;
+	}
+	for (i = 0; i < t->size; i++)
+	{
+		v = t->slots[i];
+		if (v != NULL && (v->flags & (VAR_EXPORT | VAR_UNSET)) ==
+		    VAR_EXPORT)
+			t->env[n++] = v->str;
+	}
+	t->env[n] = NULL;
+	t->env_dirty = 0;
+	environ = t->env;
+	return (t->env);
+}
+
+/**
+ * valid_name - Check if a string is a valid variable name
+ * @name: The string
+ * @len: Its length
+ *
+ * Return: 1 if it is a letter or '_' followed by letters, digits and
+ * '_', 0 otherwise.
+ */
+int valid_name(const char *name, size_t len)
+{
+	size_t i;
+
+	if (len == 0 || isdigit((unsigned char)name[0]))
+		return (0);
+	for (i = 0; i < len; i++)
+	{
+		if (name[i] != '_' && !isalnum((unsigned char)name[i]))
+			return (0);
+	}
+	return (1);
+}
@@ -0,0 +1,109 @@
+#include "main.h"
+
+/**
+ * var_assign_index - Carry out the assignment of an element of an array
+ * @word: The assignment, "name[subscript]=value"
+ * @eq: Its '='
+ * @value: The expanded value
+ * @line: The line number, for error messages
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Return: The array variable, or NULL after reporting an error.
+ */
+static var_t *var_assign_index(const char *word, const char *eq,
+			       const char *value, int line,
+			       char *program_name)
+{
+	var_t *v = var_lookup(word, (size_t)(_strchr(word, '[') - word), 1);
+	expand_t ex;
+	long index;
+	int r;
+
+	exp_init(&ex, EXP_STRING, NULL, line, program_name);
+	r = exp_index(&ex, word, eq, v->array, &index);
+	exp_finish(&ex);
+	if (r == -1)
+		return (NULL);
+	array_set(var_array(v), index, value, strlen(value));
+	return (v);
+}
+
+/**
+ * var_assign_words - Carry out the assignments that start a command
+ * @prog: The program
+ * @pc: Index of the OP_CMD instruction
+ * @n: The number of assignments
+ * @saved: NULL to make the assignments for good, or an array of @n
+ * entries where the previous values are saved, for var_restore
+ * @program_name: Name of the shell program, for error messages
+ *
+ * Description: The assignments are made from left to right, so a value
+ * can use a variable assigned before it. The ones that only last for the
+ * command are exported, so an external command finds them in its
+ * environment. Elements of arrays are assigned for good, since arrays
+ * are not exported.
+ *
+ * Return: The number of assignments made, which is less than @n if an
+ * expansion failed.
+ */
+size_t var_assign_words(const program_t *prog, size_t pc, size_t n,
+			var_save_t *saved, char *program_name)
+{
+	const char *word, *eq, *value, *old;
+	size_t i;
+	var_t *v;
+
+	for (i = 0; i < n; i++)
+	{
+		word = prog_word(prog, pc, (int)i);
+		eq = _strchr(word, '=');
+		value = eq + 1;
+		if (word[-1] & (WORD_DOLLAR | WORD_TILDE | WORD_GLOB))
+			value = expand_string(value, EXP_ASSIGN,
+					      (int)prog->code[pc + 1],
+					      program_name);
+		v = value == NULL || eq[-1] != ']' ? NULL :
+			var_assign_index(word, eq, value,
+					 (int)prog->code[pc + 1], program_name);
+		if (value != NULL && eq[-1] != ']')
+			v = var_lookup(word, (size_t)(eq - word), 1);
+		if (v == NULL)
+			break;
+		if (saved != NULL)
+		{
+			saved[i].var = v;
+			saved[i].flags = v->flags;
+			old = v->str + v->name_len + 1;
+			saved[i].value = v->flags & VAR_UNSET ? NULL :
+				arena_strndup(old, strlen(old));
+		}
+		if (eq[-1] != ']')
+			var_assign(v, value, saved != NULL ? VAR_EXPORT : 0);
+	}
+	return (i);
+}
+
+/**
+ * var_restore - Undo the assignments made for the duration of a command
+ * @saved: The values saved by var_assign_words, or NULL
+ * @n: The number of assignments that were made
+ *
+ * Description: The variables get their values and flags back in the
+ * reverse order, so a variable assigned twice ends up as it was before
+ * the first assignment.
+ *
+ * Return: None.
+ */
+void var_restore(var_save_t *saved, size_t n)
+{
+	var_t *v;
+
+	while (saved != NULL && n-- > 0)
+	{
+		v = saved[n].var;
+		if (saved[n].value != NULL)
+			var_assign(v, saved[n].value, 0);
+		v->flags = saved[n].flags;
+		var_table.env_dirty = 1;
+	}
+}
@@ -0,0 +1,102 @@
+#include "main.h"
+
+/* The journal of the innermost subshell run without forking, or NULL */
+var_journal_t *var_journal;
+
+/**
+ * var_journal_begin - Start saving the variables a subshell changes
+ * @j: The journal, which becomes the current one
+ *
+ * Return: None.
+ */
+void var_journal_begin(var_journal_t *j)
+{
+	static unsigned int serial;
+
+	j->saved = NULL;
+	j->n = 0;
+	j->cap = 0;
+	j->serial = ++serial;
+	j->prev = var_journal;
+	var_journal = j;
+}
+
+/**
+ * var_journal_note - Save a variable before a subshell changes it
+ * @v: The variable
+ *
+ * Description: Only the first change in a subshell saves the variable:
+ * the journal serial stored in it tells the next ones that it is already
+ * saved, so a loop assigning a variable in a command substitution does
+ * not grow the journal.
+ *
+ * Return: None.
+ */
+void var_journal_note(var_t *v)
+{
+	var_journal_t *j = var_journal;
+	var_save_t *saved;
+	const char *old = v->str + v->name_len + 1;
+
+	if (j->n == j->cap)
+	{
+		j->cap = j->cap ? j->cap * 2 : 8;
+		saved = realloc(j->saved, j->cap * sizeof(*saved));
+		if (saved == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		j->saved = saved;
+	}
+	saved = &j->saved[j->n++];
+	saved->var = v;
+	saved->flags = v->flags;
+	saved->journal = v->journal;
+	saved->value = NULL;
+	saved->array = v->array != NULL ? array_copy(v->array) : NULL;
+	if (!(v->flags & VAR_UNSET))
+	{
+		saved->value = _strdup(old);
+		if (saved->value == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+	}
+	v->journal = j->serial;
+}
+
+/**
+ * var_journal_end - Undo the changes a subshell made to the variables
+ * @j: The journal, which must be the current one
+ *
+ * Description: The enclosing journal becomes current again only once the
+ * values are put back, since it must not save them: they are the ones it
+ * last saw, not the ones the subshell left. Arrays get back the copies of
+ * their elements.
+ *
+ * Return: None.
+ */
+void var_journal_end(var_journal_t *j)
+{
+	var_t *v;
+
+	var_journal = NULL;
+	while (j->n-- > 0)
+	{
+		v = j->saved[j->n].var;
+		array_free(v->array);
+		v->array = NULL;
+		if (j->saved[j->n].value != NULL)
+			var_assign(v, j->saved[j->n].value, 0);
+		v->flags = j->saved[j->n].flags;
+		v->journal = j->saved[j->n].journal;
+		v->array = j->saved[j->n].array;
+		free(j->saved[j->n].value);
+	}
+	free(j->saved);
+	j->saved = NULL;
+	var_journal = j->prev;
+	var_table.env_dirty = 1;
+}
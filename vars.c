@@ -0,0 +1,163 @@
+#include "main.h"
+
+/* The shell variables, see vars_init */
+var_table_t var_table;
+
+/**
+ * var_lookup - Find a variable by name, optionally creating it
+ * @name: The name; it does not need to be terminated
+ * @len: The length of the name
+ * @create: Non-zero to add the variable, unset, when it does not exist
+ *
+ * Description: Variables live in an open-addressing hash table, so a
+ * lookup costs one hash and usually one comparison however many variables
+ * the environment holds.
+ *
+ * Return: The variable, or NULL if it does not exist and @create is 0.
+ */
+var_t *var_lookup(const char *name, size_t len, int create)
+{
+	var_table_t *t = &var_table;
+	size_t i, mask;
+	var_t *v;
+
+	if (create && (t->count + 1) * 2 > t->size && vars_grow() == -1)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	if (t->size == 0)
+		return (NULL);
+	mask = t->size - 1;
+	for (i = hash_bytes(name, len) & mask; t->slots[i] != NULL;
+	     i = (i + 1) & mask)
+	{
+		v = t->slots[i];
+		if (v->name_len == len && memcmp(v->str, name, len) == 0)
+			return (v);
+	}
+	if (!create)
+		return (NULL);
+	v = malloc(sizeof(*v));
+	if (v != NULL)
+		v->str = malloc(len + 32);
+	if (v == NULL || v->str == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(v->str, name, len);
+	v->str[len] = '=';
+	v->str[len + 1] = '\0';
+	v->name_len = len;
+	v->cap = len + 32;
+	v->flags = VAR_UNSET;
+	v->journal = 0;
+	v->array = NULL;
+	t->slots[i] = v;
+	t->count++;
+	return (v);
+}
+
+/**
+ * var_assign - Change the value of a variable
+ * @v: The variable
+ * @value: The new value
+ * @flags: VAR_EXPORT to export the variable, or 0
+ *
+ * Description: The value is copied into the variable's own "NAME=value"
+ * buffer, which only grows when the value no longer fits, so assigning a
+ * variable over and over, as a for loop does, allocates nothing. The
+ * exported environment is marked for rebuilding only when one of its
+ * strings moved or the set of exported variables changed. Inside a
+ * subshell run without forking, the previous value is saved first. The
+ * value of an array goes to its element 0.
+ *
+ * Return: None.
+ */
+void var_assign(var_t *v, const char *value, int flags)
+{
+	size_t len = strlen(value), need = v->name_len + len + 2;
+	int exported = (v->flags & (VAR_EXPORT | VAR_UNSET)) == VAR_EXPORT;
+	char *str;
+
+	if (var_journal != NULL && v->journal != var_journal->serial)
+		var_journal_note(v);
+	if (v->array != NULL)
+	{
+		array_set(v->array, 0, value, len);
+		return;
+	}
+	if (need > v->cap)
+	{
+		while (v->cap < need)
+			v->cap *= 2;
+		str = realloc(v->str, v->cap);
+		if (str == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		v->str = str;
+		if (exported)
+			var_table.env_dirty = 1;
+	}
+	memmove(v->str + v->name_len + 1, value, len + 1);
+	v->flags = (v->flags | flags) & ~VAR_UNSET;
+	if (!exported && (v->flags & VAR_EXPORT))
+		var_table.env_dirty = 1;
+}
+
+/**
+ * var_set - Set a variable
+ * @name: The name of the variable
+ * @value: Its new value
+ * @flags: VAR_EXPORT to also export it, or 0 to keep its export flag
+ *
+ * Return: 0.
+ */
+int var_set(const char *name, const char *value, int flags)
+{
+	var_assign(var_lookup(name, strlen(name), 1), value, flags);
+	return (0);
+}
+
+/**
+ * var_get - Get the value of a variable
+ * @name: The name of the variable
+ *
+ * Return: The value, or NULL if the variable is not set.
+ */
+char *var_get(const char *name)
+{
+	var_t *v = var_lookup(name, strlen(name), 0);
+
+	if (v == NULL || (v->flags & VAR_UNSET))
+		return (NULL);
+	return (v->str + v->name_len + 1);
+}
+
+/**
+ * var_unset - Unset a variable
+ * @name: The name of the variable
+ *
+ * Description: The variable keeps its slot and buffer, marked VAR_UNSET,
+ * so setting it again later does not allocate.
+ *
+ * Return: 0 on success, -1 if the variable was not set.
+ */
+int var_unset(const char *name)
+{
+	var_t *v = var_lookup(name, strlen(name), 0);
+
+	if (v == NULL || ((v->flags & VAR_UNSET) && v->array == NULL))
+		return (-1);
+	if (var_journal != NULL && v->journal != var_journal->serial)
+		var_journal_note(v);
+	if (v->flags & VAR_EXPORT)
+		var_table.env_dirty = 1;
+	v->flags = VAR_UNSET;
+	array_free(v->array);
+	v->array = NULL;
+	return (0);
+}
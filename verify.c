@@ -0,0 +1,135 @@
+#include "main.h"
+
+/**
+ * verify_words - Check the string operands of an instruction
+ * @prog: The program
+ * @op: The instruction, known to fit in the code array
+ * @len: The length of the instruction
+ *
+ * Return: 0 if every string offset points into the string pool and a case
+ * table is consistent, -1 otherwise.
+ */
+static int verify_words(const program_t *prog, const uint32_t *op,
+			size_t len)
+{
+	size_t i, empty = 0;
+
+	if (op[0] == OP_CMD && len == 4)
+		return (-1);
+	for (i = 1; i < len; i++)
+		if (op_operand(op, i) == OPND_STRING &&
+		    (op[i] == 0 || op[i] >= prog->str_len))
+			return (-1);
+	if (op[0] != OP_CASE_TABLE)
+		return (0);
+	if (op[2] == 0 || (op[2] & (op[2] - 1)) != 0)
+		return (-1);
+	for (i = 3 + 2 * (size_t)op[1]; i < len; i++)
+	{
+		if (op[i] > op[1])
+			return (-1);
+		empty += op[i] == 0;
+	}
+	return (empty == 0 ? -1 : 0);
+}
+
+/**
+ * verify_jumps - Check the addresses an instruction refers to
+ * @prog: The program
+ * @pc: Index of the instruction
+ * @starts: Flags set at the index of every instruction
+ *
+ * Return: 0 if every address is the start of an instruction, and the table
+ * of an OP_CASE is an OP_CASE_TABLE, -1 otherwise.
+ */
+static int verify_jumps(const program_t *prog, size_t pc, const char *starts)
+{
+	const uint32_t *op = prog->code + pc;
+	size_t i, len = op_length(op), n = prog->code_len;
+
+	for (i = 1; i < len; i++)
+		if (op_operand(op, i) == OPND_ADDRESS &&
+		    (op[i] >= n || !starts[op[i]]))
+			return (-1);
+	if (op[0] == OP_CASE && prog->code[op[3]] != OP_CASE_TABLE)
+		return (-1);
+	return (0);
+}
+
+/**
+ * verify_body - Check that the body of a function is self-contained
+ * @prog: The program
+ * @pc: Index of the OP_FUNC instruction
+ *
+ * Description: prog_extract copies the body out of the program and
+ * relocates its addresses, so they must all lie between the start and the
+ * end of the body.
+ *
+ * Return: 0 if the body is self-contained, -1 otherwise.
+ */
+static int verify_body(const program_t *prog, size_t pc)
+{
+	const uint32_t *code = prog->code;
+	size_t start = pc + 3, end = code[pc + 2], i, len;
+
+	if (end < start)
+		return (-1);
+	for (pc = start; pc < end; pc += len)
+	{
+		len = op_length(code + pc);
+		for (i = 1; i < len; i++)
+			if (op_operand(code + pc, i) == OPND_ADDRESS &&
+			    (code[pc + i] < start || code[pc + i] > end))
+				return (-1);
+	}
+	return (pc == end ? 0 : -1);
+}
+
+/**
+ * prog_verify - Check that a program read from a cache file is well formed
+ * @prog: The program
+ *
+ * Description: Every instruction must fit in the code array, every jump
+ * must land on an instruction, every word offset must point into the string
+ * pool, the pool must end with a NUL, function bodies must not jump out of
+ * themselves and the code must end with OP_END, so
+ * a damaged cache file can never make run_program read outside of the
+ * mapping.
+ *
+ * Return: 0 if the program is well formed, -1 otherwise.
+ */
+int prog_verify(const program_t *prog)
+{
+	const uint32_t *code = prog->code;
+	size_t pc, len, n = prog->code_len;
+	char *starts = calloc(n + 1, 1);
+	int ret = 0;
+
+	if (starts == NULL || (prog->str_len != 0 &&
+			       prog->strings[prog->str_len - 1] != '\0'))
+		ret = -1;
+	for (pc = 0; ret == 0 && pc < n && code[pc] != OP_END; pc += len)
+	{
+		starts[pc] = 1;
+		len = n - pc < 4 && (code[pc] == OP_CMD || code[pc] == OP_FOR ||
+				     code[pc] == OP_CASE_TABLE ||
+				     code[pc] == OP_REDIR) ? 0 :
+			op_length(code + pc);
+		if (len == 0 || len > n - pc)
+			ret = -1;
+		else
+			ret = verify_words(prog, code + pc, len);
+	}
+	if (ret == 0 && pc + 1 != n)
+		ret = -1;
+	if (ret == 0)
+		starts[pc] = 1;
+	for (pc = 0; ret == 0 && code[pc] != OP_END; pc += op_length(code + pc))
+	{
+		ret = verify_jumps(prog, pc, starts);
+		if (ret == 0 && code[pc] == OP_FUNC)
+			ret = verify_body(prog, pc);
+	}
+	free(starts);
+	return (ret);
+}
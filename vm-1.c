@@ -0,0 +1,214 @@
+#include "main.h"
+
+/**
+ * vm_for_words - Expand the words of a for loop
+ * @vm: The state of the interpreter
+ * @f: The frame of the loop
+ *
+ * Description: When none of the words needs expanding, the loop assigns
+ * them straight from the string pool. Otherwise they are all expanded
+ * into the arena, above the frame's mark, where they stay until the loop
+ * ends. If an expansion fails the loop runs no iteration and its status
+ * is 2.
+ *
+ * Return: None.
+ */
+static void vm_for_words(vm_t *vm, loop_frame_t *f)
+{
+	const uint32_t *op = f->for_op;
+	const char *word;
+	fields_t words;
+	uint32_t i;
+
+	for (i = 0; i < op[3]; i++)
+	{
+		word = vm->prog->strings + op[4 + i];
+		if (word[-1] & (WORD_DOLLAR | WORD_TILDE | WORD_GLOB))
+			break;
+	}
+	if (i == op[3])
+		return;
+	fields_init(&words);
+	for (i = 0; i < op[3]; i++)
+	{
+		word = vm->prog->strings + op[4 + i];
+		if (!(word[-1] & (WORD_DOLLAR | WORD_TILDE | WORD_GLOB)))
+			fields_add(&words, (char *)word);
+		else if (expand_word(word, &words, probe_line,
+				     vm->program_name) == -1)
+		{
+			words.n = 0;
+			f->status = 2;
+			break;
+		}
+	}
+	f->args = arena_alloc((words.n + 1) * sizeof(*f->args));
+	memcpy(f->args, words.v, words.n * sizeof(*f->args));
+	f->nargs = (uint32_t)words.n;
+	fields_free(&words);
+}
+
+/**
+ * vm_push - Enter a loop
+ * @vm: The state of the interpreter
+ * @break_pc: Address of the loop's OP_POP
+ * @continue_pc: Address the loop continues at
+ * @for_op: The OP_FOR instruction of a for loop, or NULL
+ *
+ * Description: The frames live in the vm_t itself until loops are nested
+ * more than VM_FRAMES deep, when the stack moves to the heap and doubles.
+ * A loop over the positional parameters keeps the ones it started with,
+ * so 'shift' in its body does not change the words it iterates over, and
+ * a for loop expands its words once, when it starts.
+ *
+ * Return: None.
+ */
+void vm_push(vm_t *vm, size_t break_pc, size_t continue_pc,
+	     const uint32_t *for_op)
+{
+	loop_frame_t *frames, *f;
+
+	if (vm->depth == vm->cap)
+	{
+		frames = malloc(vm->cap * 2 * sizeof(*frames));
+		if (frames == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(frames, vm->frames, vm->depth * sizeof(*frames));
+		if (vm->frames != vm->inline_frames)
+			free(vm->frames);
+		vm->frames = frames;
+		vm->cap *= 2;
+	}
+	f = &vm->frames[vm->depth++];
+	f->break_pc = break_pc;
+	f->continue_pc = continue_pc;
+	f->for_op = for_op;
+	f->args = NULL;
+	f->nargs = 0;
+	f->index = 0;
+	f->status = 0;
+	f->mark = arena_mark();
+	if (for_op != NULL && for_op[0] == OP_FOR_ARGS && params != NULL)
+	{
+		f->args = params->argv;
+		f->nargs = (uint32_t)params->argc;
+	}
+	else if (for_op != NULL && for_op[0] == OP_FOR)
+		vm_for_words(vm, f);
+}
+
+/**
+ * vm_for_next - Execute an OP_FOR_NEXT instruction
+ * @vm: The state of the interpreter
+ * @pc: Index of the instruction
+ *
+ * Description: The word is assigned with var_assign, which reuses the
+ * variable's buffer, so iterating allocates nothing once the longest word
+ * has been assigned.
+ *
+ * Return: The index of the next instruction, or the loop's OP_POP when
+ * every word has been assigned.
+ */
+size_t vm_for_next(vm_t *vm, size_t pc)
+{
+	loop_frame_t *f;
+	const uint32_t *op;
+	const char *strings = vm->prog->strings, *word;
+
+	if (vm->depth == 0)
+		return (pc + 1);
+	f = &vm->frames[vm->depth - 1];
+	op = f->for_op;
+	if (op == NULL || f->index >= (op[0] == OP_FOR && f->args == NULL ?
+				       op[3] : f->nargs))
+		return (f->break_pc);
+	if (f->args == NULL)
+		word = strings + op[4 + f->index++];
+	else
+		word = f->args[f->index++];
+	var_set(strings + op[2], word, 0);
+	return (pc + 1);
+}
+
+/**
+ * vm_loop_request - Carry out a 'break' or 'continue'
+ * @vm: The state of the interpreter
+ * @next: Index of the instruction after the command
+ *
+ * Description: The builtins only record the request in loop_request and
+ * loop_levels, since the loops are the interpreter's. The enclosing loops
+ * are left, the last one being continued or left through its OP_POP with
+ * the status of the builtin, and what the loops left expanded in the arena
+ * is released, after undoing the redirections of the compound commands
+ * left inside them. Outside of a loop the request is ignored, as /bin/sh does.
+ * A 'return' is left for run_program, which stops.
+ *
+ * Return: The index of the next instruction to execute.
+ */
+size_t vm_loop_request(vm_t *vm, size_t next)
+{
+	int request = loop_request;
+	size_t levels = loop_levels;
+	loop_frame_t *f;
+
+	if (request == LOOP_RETURN)
+		return (next);
+	loop_request = 0;
+	if (vm->depth == 0)
+		return (next);
+	if (levels > vm->depth)
+		levels = vm->depth;
+	vm->depth -= levels - 1;
+	while (vm->redirs != NULL && vm->redirs->depth >= vm->depth)
+		vm_redir_pop(vm);
+	if (levels > 1)
+		arena_release(vm->frames[vm->depth].mark);
+	f = &vm->frames[vm->depth - 1];
+	f->status = last_status;
+	return (request == LOOP_BREAK ? f->break_pc : f->continue_pc);
+}
+
+/**
+ * vm_step_loop - Execute an instruction of a while, until or for loop
+ * @vm: The state of the interpreter
+ * @pc: Index of the instruction
+ *
+ * Description: An OP_NEXT or OP_POP found outside of any loop, which only
+ * a damaged cache file could hold, does nothing.
+ *
+ * Return: The index of the next instruction to execute.
+ */
+size_t vm_step_loop(vm_t *vm, size_t pc)
+{
+	const uint32_t *op = vm->prog->code + pc;
+	loop_frame_t *top = vm->depth ? &vm->frames[vm->depth - 1] : NULL;
+
+	switch (op[0])
+	{
+	case OP_LOOP:
+		vm_push(vm, op[1], op[2], NULL);
+		break;
+	case OP_FOR:
+	case OP_FOR_ARGS:
+		vm_push(vm, op[1], pc + op_length(op), op);
+		break;
+	case OP_FOR_NEXT:
+		return (vm_for_next(vm, pc));
+	case OP_NEXT:
+		if (top == NULL)
+			break;
+		top->status = last_status;
+		return (top->continue_pc);
+	case OP_POP:
+		if (top == NULL)
+			break;
+		last_status = top->status;
+		arena_release(top->mark);
+		vm->depth--;
+		break;
+	}
+	return (pc + op_length(op));
+}
@@ -0,0 +1,136 @@
+#include "main.h"
+
+/**
+ * case_glob - Match a word against a case pattern that is not literal
+ * @vm: The state of the interpreter
+ * @pattern: The pattern, from the string pool
+ * @word: The word
+ * @line: The line number of the case command
+ *
+ * Description: A pattern containing a parameter is expanded first, with
+ * the quoted parts of its value escaped so they match literally.
+ *
+ * Return: 1 if the word matches, 0 otherwise.
+ */
+static int case_glob(vm_t *vm, const char *pattern, const char *word,
+		     int line)
+{
+	if (pattern[-1] & (WORD_DOLLAR | WORD_TILDE))
+		pattern = expand_string(pattern, EXP_PATTERN, line,
+					vm->program_name);
+	return (pattern != NULL && glob_match(pattern, word));
+}
+
+/**
+ * vm_case - Execute an OP_CASE instruction
+ * @vm: The state of the interpreter
+ * @pc: Index of the instruction
+ *
+ * Description: The word is expanded, then looked up in the hash table of
+ * the literal patterns first. Since the first matching pattern wins, only
+ * the other patterns written before the literal one found, if any, are
+ * then matched with glob_match, in order. What the expansions allocated is
+ * released before the body runs.
+ *
+ * Return: The address of the body of the matching pattern, or the end of
+ * the case command when none matches.
+ */
+size_t vm_case(vm_t *vm, size_t pc)
+{
+	const program_t *prog = vm->prog;
+	const uint32_t *op = prog->code + pc, *table = prog->code + op[3];
+	const uint32_t *items = table + 3, *slots = items + 2 * table[1];
+	const char *word = prog->strings + op[2], *pattern;
+	uint32_t n = table[1], mask = table[2] - 1, i, slot, found = n;
+	arena_mark_t mark = arena_mark();
+	size_t target = op[3] + op_length(table);
+
+	last_status = 0;
+	if (word[-1] & (WORD_DOLLAR | WORD_TILDE))
+		word = expand_string(word, EXP_STRING, (int)op[1],
+				     vm->program_name);
+	if (word == NULL)
+	{
+		last_status = 2;
+		arena_release(mark);
+		return (target);
+	}
+	for (slot = (uint32_t)(hash_string(word) & mask); slots[slot] != 0;
+	     slot = (slot + 1) & mask)
+	{
+		if (_strcmp(prog->strings + items[2 * (slots[slot] - 1)],
+			    word) == 0)
+		{
+			found = slots[slot] - 1;
+			break;
+		}
+	}
+	for (i = 0; i < found; i++)
+	{
+		pattern = prog->strings + items[2 * i];
+		if ((pattern[-1] & (WORD_GLOB | WORD_DOLLAR | WORD_TILDE)) &&
+		    case_glob(vm, pattern, word, (int)op[1]))
+			break;
+	}
+	if (i < n)
+		target = items[2 * i + 1];
+	arena_release(mark);
+	return (target);
+}
+
+/**
+ * vm_redir - Execute an OP_REDIR instruction
+ * @vm: The state of the interpreter
+ * @pc: Index of the instruction
+ *
+ * Description: The redirections are applied in the shell, like those of a
+ * builtin, so every command of the compound command sees them, and they
+ * stay on vm->redirs until its OP_REDIR_END. They are kept in the arena,
+ * above a mark taken first, with the words they expanded.
+ *
+ * Return: The index of the next instruction, or the address after the
+ * OP_REDIR_END with a status of 2 if a redirection failed.
+ */
+size_t vm_redir(vm_t *vm, size_t pc)
+{
+	const uint32_t *op = vm->prog->code + pc;
+	arena_mark_t mark = arena_mark();
+	vm_redir_t *r = arena_alloc(sizeof(*r));
+
+	r->rl.n = 0;
+	if (redir_prepare(vm->prog, pc, &r->rl, vm->program_name) == -1 ||
+	    redir_apply(&r->rl) == -1)
+	{
+		redir_restore(&r->rl);
+		redir_release(&r->rl);
+		arena_release(mark);
+		last_status = 2;
+		return (op[2]);
+	}
+	r->mark = mark;
+	r->depth = vm->depth;
+	r->prev = vm->redirs;
+	vm->redirs = r;
+	return (pc + op_length(op));
+}
+
+/**
+ * vm_redir_pop - Undo the redirections of the innermost compound command
+ * @vm: The state of the interpreter, with at least one entry on
+ * vm->redirs
+ *
+ * Description: This runs at OP_REDIR_END, and for the commands a 'break',
+ * a 'continue' or the end of run_program leaves before their end.
+ *
+ * Return: None.
+ */
+void vm_redir_pop(vm_t *vm)
+{
+	vm_redir_t *r = vm->redirs;
+	arena_mark_t mark = r->mark;
+
+	redir_restore(&r->rl);
+	redir_release(&r->rl);
+	vm->redirs = r->prev;
+	arena_release(mark);
+}
@@ -0,0 +1,217 @@
+#include "main.h"
+
+/* Set by 'break', 'continue' and 'return' for run_program */
+int loop_request;
+unsigned int loop_levels;
+
+/**
+ * run_dispatch - Hand the fields of an OP_CMD instruction to
+ * dispatch_command
+ * @prog: The program
+ * @pc: Index of the instruction
+ * @tokens: The fields
+ * @lit: The number of fields at the start of @tokens that come from
+ * literal words
+ * @rl: The redirections of the command
+ * @program_name: Name of the shell program
+ *
+ * Description: The redirections go through redir_pending, and where the
+ * name comes from through alias_pending, so only a literal name is looked
+ * up as an alias, and in the body of a function, as the alias it stood
+ * for when the function was defined.
+ *
+ * Return: None.
+ */
+static void run_dispatch(const program_t *prog, size_t pc, char **tokens,
+			 int lit, redir_list_t *rl, char *program_name)
+{
+	alias_site_t site;
+	uint64_t start;
+
+	site.prog = prog;
+	site.pc = pc;
+	site.lit = lit;
+	alias_pending = lit > 0 ? &site : NULL;
+	redir_pending = rl->n > 0 ? rl : NULL;
+	start = probe_start();
+	last_status = dispatch_command(tokens, probe_line, program_name);
+	redir_pending = NULL;
+	probe_line_end(start);
+	stats_poll();
+}
+
+/**
+ * run_command - Execute an OP_CMD instruction
+ * @prog: The program
+ * @pc: Index of the instruction
+ * @program_name: Name of the shell program
+ *
+ * Description: The words are expanded by expand_command into fields that
+ * point into the string pool, or into the expansion arena for the words
+ * that needed expanding, which is rewound once the command has run. The
+ * argument vector lives on the stack unless the command has more than
+ * FIELDS_INLINE words, so running a command usually allocates nothing.
+ * A command made only of assignments sets the variables, and its status
+ * is that of its last command substitution, if any. Assignments
+ * before a command last for the command only, except before a special
+ * builtin. The files of the redirections are opened by redir_prepare
+ * and handed to dispatch_command by run_dispatch. A command ending the
+ * value of an alias gets the arguments of the alias from alias_tail. A
+ * failed expansion or redirection gives a status of 2 and runs nothing.
+ *
+ * Return: None.
+ */
+static void run_command(const program_t *prog, size_t pc, char *program_name)
+{
+	arena_mark_t mark = arena_mark();
+	var_save_t *saved = NULL;
+	redir_list_t rl;
+	fields_t args;
+	size_t done = 0;
+	int assigns, lit;
+
+	probe_line = (int)prog->code[pc + 1];
+	fields_init(&args);
+	rl.n = 0;
+	subst_status = 0;
+	assigns = expand_command(prog, pc, &args, program_name);
+	lit = assigns == -1 ? 0 : alias_tail(prog, pc, &args, assigns);
+	if (assigns > 0 && args.n > 0 && !is_special_builtin(args.v[0]))
+		saved = arena_alloc((size_t)assigns * sizeof(*saved));
+	if (assigns > 0)
+		done = var_assign_words(prog, pc, (size_t)assigns, saved,
+					program_name);
+	if (assigns == -1 || done < (size_t)assigns || (prog->code[pc + 3] &&
+	    redir_prepare(prog, pc, &rl, program_name) == -1))
+		last_status = 2;
+	else if (args.n == 0)
+		last_status = subst_status;
+	else
+		run_dispatch(prog, pc, args.v, lit, &rl, program_name);
+	redir_release(&rl);
+	var_restore(saved, done);
+	fields_free(&args);
+	arena_release(mark);
+}
+
+/**
+ * vm_syntax - Execute an OP_SYNTAX instruction
+ * @vm: The state of the interpreter
+ * @op: The instruction
+ *
+ * Description: The error is reported with the line it was found on, and
+ * unless the shell is interactive it then exits, like /bin/sh.
+ *
+ * Return: None.
+ */
+static void vm_syntax(vm_t *vm, const uint32_t *op)
+{
+	fprintf(stderr, "%s: %d: Syntax error: %s\n", vm->program_name,
+		(int)op[1], vm->prog->strings + op[2]);
+	last_status = 2;
+	if (!interactive)
+		exit_requested = 1;
+}
+
+/**
+ * vm_step - Execute one instruction
+ * @vm: The state of the interpreter
+ * @pc: Index of the instruction
+ *
+ * Description: The instructions of loops are left to vm_step_loop.
+ *
+ * Return: The index of the next instruction to execute.
+ */
+static size_t vm_step(vm_t *vm, size_t pc)
+{
+	const uint32_t *op = vm->prog->code + pc;
+
+	switch (op[0])
+	{
+	case OP_CMD:
+		run_command(vm->prog, pc, vm->program_name);
+		if (loop_request)
+			return (vm_loop_request(vm, pc + op_length(op)));
+		break;
+	case OP_JMP:
+		return (op[1]);
+	case OP_JMP_OK:
+		return (last_status == 0 ? op[1] : pc + 2);
+	case OP_JMP_FAIL:
+		return (last_status != 0 ? op[1] : pc + 2);
+	case OP_NOT:
+		last_status = !last_status;
+		break;
+	case OP_TRUE:
+		last_status = 0;
+		break;
+	case OP_CASE:
+		return (vm_case(vm, pc));
+	case OP_REDIR:
+		return (vm_redir(vm, pc));
+	case OP_REDIR_END:
+		if (vm->redirs != NULL && vm->redirs->depth == vm->depth)
+			vm_redir_pop(vm);
+		break;
+	case OP_FUNC:
+		func_define(vm->prog->strings + op[1], vm->prog, pc + 3, op[2]);
+		last_status = 0;
+		return (op[2]);
+	case OP_SYNTAX:
+		vm_syntax(vm, op);
+		break;
+	default:
+		return (vm_step_loop(vm, pc));
+	}
+	return (pc + op_length(op));
+}
+
+/**
+ * run_program - Execute a compiled program
+ * @prog: The program, terminated by OP_END
+ * @program_name: Name of the shell program
+ *
+ * Description: This is the loop of the bytecode interpreter. Execution
+ * stops at OP_END, when the exit builtin has run, or when 'return' has run
+ * in a function. A syntax error sets the status to 2 and, unless the shell
+ * is interactive, makes it exit.
+ * Loops jump back into code that was compiled once, so an iteration costs
+ * no parsing and no allocation. With -n, only syntax errors are reported:
+ * every other instruction is stepped over without being executed.
+ * Going back to the start of a loop moves stat_epoch on, so test sees the
+ * files again on each iteration.
+ *
+ * Return: The status of the last command executed.
+ */
+int run_program(const program_t *prog, char *program_name)
+{
+	const uint32_t *code = prog->code;
+	size_t pc = 0, next;
+	vm_t vm;
+
+	vm.prog = prog;
+	vm.program_name = program_name;
+	vm.frames = vm.inline_frames;
+	vm.depth = 0;
+	vm.cap = VM_FRAMES;
+	vm.redirs = NULL;
+	while (!exit_requested && loop_request != LOOP_RETURN &&
+	       code[pc] != OP_END)
+	{
+		if (noexec && code[pc] != OP_SYNTAX)
+			pc += op_length(code + pc);
+		else
+		{
+			next = vm_step(&vm, pc);
+			stat_epoch += next <= pc;
+			pc = next;
+		}
+	}
+	while (vm.redirs != NULL)
+		vm_redir_pop(&vm);
+	if (vm.depth > 0)
+		arena_release(vm.frames[0].mark);
+	if (vm.frames != vm.inline_frames)
+		free(vm.frames);
+	return (last_status);
+}